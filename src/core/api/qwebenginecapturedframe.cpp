@@ -0,0 +1,192 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qwebenginecapturedframe.h"
+
+#include "frame_sink_capturer.h"
+
+QT_BEGIN_NAMESPACE
+
+class QWebEngineCapturedFramePrivate : public QSharedData
+{
+public:
+    QtWebEngineCore::CapturedFrame frame;
+};
+
+/*!
+    \class QWebEngineCapturedFrame
+    \brief A frame of a page captured by QWebEngineFrameCapturer.
+    \inmodule QtWebEngineCore
+    \since 6.9
+
+    The pixel data is not copied out of the shared memory buffer the compositor rendered
+    the frame into. The buffer is handed back to the compositor for reuse once the last copy
+    of the frame is destroyed, so frames should not be kept for longer than needed to encode
+    or display them. Frames can be passed to and destroyed on other threads.
+
+    \sa QWebEngineFrameCapturer
+*/
+
+/*!
+    \enum QWebEngineCapturedFrame::PixelFormat
+
+    This enum describes the layout of the pixel data:
+
+    \value I420 Planar YUV 4:2:0, with a full resolution Y plane followed by U and V planes
+    of half the width and height.
+    \value BGRA A single plane of 32-bit pixels, stored as blue, green, red and alpha bytes
+    with premultiplied alpha.
+*/
+
+/*!
+    Constructs a null frame without pixel data.
+
+    \sa isNull()
+*/
+QWebEngineCapturedFrame::QWebEngineCapturedFrame()
+    : d_ptr(new QWebEngineCapturedFramePrivate)
+{
+}
+
+QWebEngineCapturedFrame::QWebEngineCapturedFrame(const QtWebEngineCore::CapturedFrame &frame)
+    : d_ptr(new QWebEngineCapturedFramePrivate)
+{
+    d_ptr->frame = frame;
+}
+
+QWebEngineCapturedFrame::QWebEngineCapturedFrame(const QWebEngineCapturedFrame &other) = default;
+QWebEngineCapturedFrame &QWebEngineCapturedFrame::operator=(const QWebEngineCapturedFrame &other) = default;
+QWebEngineCapturedFrame::QWebEngineCapturedFrame(QWebEngineCapturedFrame &&other) = default;
+QWebEngineCapturedFrame &QWebEngineCapturedFrame::operator=(QWebEngineCapturedFrame &&other) = default;
+
+QWebEngineCapturedFrame::~QWebEngineCapturedFrame() { }
+
+/*!
+    Returns \c true if the frame has no pixel data, as a default constructed frame.
+*/
+bool QWebEngineCapturedFrame::isNull() const
+{
+    return d_ptr->frame.planes.isEmpty();
+}
+
+/*!
+    \property QWebEngineCapturedFrame::pixelFormat
+    \brief The layout of the pixel data.
+*/
+QWebEngineCapturedFrame::PixelFormat QWebEngineCapturedFrame::pixelFormat() const
+{
+    return d_ptr->frame.format == QtWebEngineCore::CapturedFrame::I420 ? PixelFormat::I420
+                                                                       : PixelFormat::BGRA;
+}
+
+/*!
+    \property QWebEngineCapturedFrame::size
+    \brief The size of the frame in pixels.
+*/
+QSize QWebEngineCapturedFrame::size() const
+{
+    return d_ptr->frame.size;
+}
+
+/*!
+    \property QWebEngineCapturedFrame::contentRect
+    \brief The area of the frame showing the page.
+
+    If the aspect ratio of the page differs from the one of the frame, the page is
+    letterboxed within the frame.
+*/
+QRect QWebEngineCapturedFrame::contentRect() const
+{
+    return d_ptr->frame.contentRect;
+}
+
+/*!
+    \property QWebEngineCapturedFrame::damageRect
+    \brief The area of the frame that changed since the previous frame.
+
+    Encoders can use this to skip unchanged areas. If it is not known, it is the
+    contentRect().
+*/
+QRect QWebEngineCapturedFrame::damageRect() const
+{
+    return d_ptr->frame.damageRect;
+}
+
+/*!
+    Returns the time the frame was presented, relative to an arbitrary point in time
+    that is the same for all frames of a capture.
+*/
+std::chrono::microseconds QWebEngineCapturedFrame::timestamp() const
+{
+    return std::chrono::microseconds(d_ptr->frame.timestamp);
+}
+
+/*!
+    \property QWebEngineCapturedFrame::planeCount
+    \brief The number of planes of the pixel data.
+
+    This is \c 3 for PixelFormat::I420 and \c 1 for PixelFormat::BGRA.
+*/
+int QWebEngineCapturedFrame::planeCount() const
+{
+    return d_ptr->frame.planes.size();
+}
+
+/*!
+    Returns the pixel data of \a plane. The data stays valid as long as a copy of this
+    frame exists.
+*/
+const uchar *QWebEngineCapturedFrame::constBits(int plane) const
+{
+    if (plane < 0 || plane >= planeCount())
+        return nullptr;
+    return d_ptr->frame.planes[plane].bits;
+}
+
+/*!
+    Returns the number of bytes per line of \a plane.
+*/
+qsizetype QWebEngineCapturedFrame::bytesPerLine(int plane) const
+{
+    if (plane < 0 || plane >= planeCount())
+        return 0;
+    return d_ptr->frame.planes[plane].bytesPerLine;
+}
+
+/*!
+    Returns the number of lines of \a plane.
+*/
+int QWebEngineCapturedFrame::planeHeight(int plane) const
+{
+    if (plane < 0 || plane >= planeCount())
+        return 0;
+    return d_ptr->frame.planes[plane].rows;
+}
+
+/*!
+    Returns an image of the contentRect() of a PixelFormat::BGRA frame.
+
+    The image refers to the pixel data of the frame without copying it, and keeps the
+    frame alive until the image and all its copies are destroyed. For PixelFormat::I420
+    frames a null image is returned.
+*/
+QImage QWebEngineCapturedFrame::toImage() const
+{
+    const QtWebEngineCore::CapturedFrame &frame = d_ptr->frame;
+    if (frame.format != QtWebEngineCore::CapturedFrame::ARGB || frame.planes.isEmpty())
+        return QImage();
+    const QRect rect = frame.contentRect & QRect(QPoint(), frame.size);
+    if (rect.isEmpty())
+        return QImage();
+
+    const auto &plane = frame.planes.first();
+    const uchar *bits = plane.bits + qsizetype(rect.top()) * plane.bytesPerLine + rect.left() * 4;
+    auto *keepAlive = new std::shared_ptr<void>(frame.buffer);
+    return QImage(bits, rect.width(), rect.height(), plane.bytesPerLine,
+                  QImage::Format_ARGB32_Premultiplied,
+                  [](void *info) { delete static_cast<std::shared_ptr<void> *>(info); }, keepAlive);
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qwebenginecapturedframe.cpp"
@@ -0,0 +1,70 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QWEBENGINECAPTUREDFRAME_H
+#define QWEBENGINECAPTUREDFRAME_H
+
+#include <QtWebEngineCore/qtwebenginecoreglobal.h>
+
+#include <QtCore/qobject.h>
+#include <QtCore/qrect.h>
+#include <QtCore/qshareddata.h>
+#include <QtGui/qimage.h>
+
+#include <chrono>
+
+namespace QtWebEngineCore {
+struct CapturedFrame;
+}
+
+QT_BEGIN_NAMESPACE
+
+class QWebEngineCapturedFramePrivate;
+
+class Q_WEBENGINECORE_EXPORT QWebEngineCapturedFrame
+{
+    Q_GADGET
+    Q_PROPERTY(PixelFormat pixelFormat READ pixelFormat CONSTANT FINAL)
+    Q_PROPERTY(QSize size READ size CONSTANT FINAL)
+    Q_PROPERTY(QRect contentRect READ contentRect CONSTANT FINAL)
+    Q_PROPERTY(QRect damageRect READ damageRect CONSTANT FINAL)
+    Q_PROPERTY(int planeCount READ planeCount CONSTANT FINAL)
+
+public:
+    enum class PixelFormat : quint8 {
+        I420,
+        BGRA,
+    };
+    Q_ENUM(PixelFormat)
+
+    QWebEngineCapturedFrame();
+    QWebEngineCapturedFrame(const QWebEngineCapturedFrame &other);
+    QWebEngineCapturedFrame &operator=(const QWebEngineCapturedFrame &other);
+    QWebEngineCapturedFrame(QWebEngineCapturedFrame &&other);
+    QWebEngineCapturedFrame &operator=(QWebEngineCapturedFrame &&other);
+    ~QWebEngineCapturedFrame();
+
+    bool isNull() const;
+
+    PixelFormat pixelFormat() const;
+    QSize size() const;
+    QRect contentRect() const;
+    QRect damageRect() const;
+    std::chrono::microseconds timestamp() const;
+
+    int planeCount() const;
+    const uchar *constBits(int plane) const;
+    qsizetype bytesPerLine(int plane) const;
+    int planeHeight(int plane) const;
+
+    QImage toImage() const;
+
+private:
+    explicit QWebEngineCapturedFrame(const QtWebEngineCore::CapturedFrame &frame);
+    QExplicitlySharedDataPointer<QWebEngineCapturedFramePrivate> d_ptr;
+    friend class QWebEngineFrameCapturer;
+};
+
+QT_END_NAMESPACE
+
+#endif // QWEBENGINECAPTUREDFRAME_H
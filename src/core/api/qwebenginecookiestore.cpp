@@ -6,24 +6,37 @@
 
 #include "net/base/registry_controlled_domains/registry_controlled_domain.h"
 
+#include "net/cookie_access_policy_qt.h"
 #include "net/cookie_monster_delegate_qt.h"
+#include "type_conversion.h"
 
 #include <QByteArray>
 #include <QUrl>
 
-namespace {
-
-inline GURL toGurl(const QUrl &url)
-{
-    return GURL(url.toString().toStdString());
-}
-
-} // namespace
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 
 using namespace QtWebEngineCore;
 
+ASSERT_ENUMS_MATCH(QWebEngineCookieStore::AccessRule::Allow, CookieAccessPolicyQt::Allow)
+ASSERT_ENUMS_MATCH(QWebEngineCookieStore::AccessRule::Block, CookieAccessPolicyQt::Block)
+ASSERT_ENUMS_MATCH(QWebEngineCookieStore::AccessRule::BlockThirdParty, CookieAccessPolicyQt::BlockThirdParty)
+
+// Returns an empty domain for the global rule, and nothing for an invalid host.
+static std::optional<std::string> canonicalDomain(const QString &domain)
+{
+    QString normalized = domain.trimmed();
+    while (normalized.startsWith(u'.'))
+        normalized.remove(0, 1);
+    if (normalized.isEmpty())
+        return std::string();
+    const QByteArray ace = QUrl::toAce(normalized);
+    if (ace.isEmpty())
+        return std::nullopt;
+    return ace.toLower().toStdString();
+}
+
 QWebEngineCookieStorePrivate::QWebEngineCookieStorePrivate(QWebEngineCookieStore *q)
     : q_ptr(q)
     , m_deleteSessionCookiesPending(false)
@@ -52,20 +65,25 @@ void QWebEngineCookieStorePrivate::processPendingUserCookies()
         delegate->deleteSessionCookies();
     }
 
-    if (bool(filterCallback))
+    if (hasAccessFilter())
         delegate->setHasFilter(true);
 
-    if (m_pendingUserCookies.isEmpty())
-        return;
-
     for (const CookieData &cookieData : std::as_const(m_pendingUserCookies)) {
         if (cookieData.wasDelete)
             delegate->deleteCookie(cookieData.cookie, cookieData.origin);
         else
             delegate->setCookie(cookieData.cookie, cookieData.origin);
     }
-
     m_pendingUserCookies.clear();
+
+    // Queries come last so that they already see the imported cookies
+    const QList<CookieImport> imports = std::exchange(m_pendingCookieImports, {});
+    for (const CookieImport &import : imports)
+        setCookies(import.cookies, import.origin, import.callback);
+
+    const QList<CookieQuery> queries = std::exchange(m_pendingCookieQueries, {});
+    for (const CookieQuery &query : queries)
+        getCookies(query.domain, query.pageSize, query.callback);
 }
 
 void QWebEngineCookieStorePrivate::rejectPendingUserCookies()
@@ -74,6 +92,15 @@ void QWebEngineCookieStorePrivate::rejectPendingUserCookies()
     m_deleteAllCookiesPending = false;
     m_deleteSessionCookiesPending = false;
     m_pendingUserCookies.clear();
+
+    const QList<CookieImport> imports = std::exchange(m_pendingCookieImports, {});
+    for (const CookieImport &import : imports) {
+        if (import.callback)
+            import.callback(0);
+    }
+    const QList<CookieQuery> queries = std::exchange(m_pendingCookieQueries, {});
+    for (const CookieQuery &query : queries)
+        query.callback({}, true);
 }
 
 void QWebEngineCookieStorePrivate::setCookie(const QNetworkCookie &cookie, const QUrl &origin)
@@ -127,6 +154,33 @@ void QWebEngineCookieStorePrivate::getAllCookies()
     delegate->getAllCookies();
 }
 
+void QWebEngineCookieStorePrivate::getCookies(const QString &domain, qsizetype pageSize,
+                                              std::function<bool(const QList<QNetworkCookie> &, bool)> callback)
+{
+    if (!delegate || !delegate->hasCookieMonster()) {
+        m_pendingCookieQueries.append(CookieQuery{ domain, pageSize, std::move(callback) });
+        return;
+    }
+
+    const std::optional<std::string> canonical = canonicalDomain(domain);
+    if (!canonical) {
+        qWarning("Cannot get the cookies of invalid domain %ls.", qUtf16Printable(domain));
+        callback({}, true);
+        return;
+    }
+    delegate->getCookies(*canonical, size_t(pageSize), std::move(callback));
+}
+
+void QWebEngineCookieStorePrivate::setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin,
+                                              std::function<void(qsizetype)> callback)
+{
+    if (!delegate || !delegate->hasCookieMonster()) {
+        m_pendingCookieImports.append(CookieImport{ cookies, origin, std::move(callback) });
+        return;
+    }
+
+    delegate->setCookies(cookies, origin, std::move(callback));
+}
 
 void QWebEngineCookieStorePrivate::onCookieChanged(const QNetworkCookie &cookie, bool removed)
 {
@@ -151,6 +205,41 @@ bool QWebEngineCookieStorePrivate::canAccessCookies(const QUrl &firstPartyUrl, c
     return filterCallback(request);
 }
 
+bool QWebEngineCookieStorePrivate::canAccessCookies(const GURL &firstPartyUrl, const GURL &url) const
+{
+    if (auto policy = accessPolicy()) {
+        if (auto allowed = policy->allowedAccess(firstPartyUrl, url))
+            return *allowed;
+    }
+
+    // Only fall back to the comparatively expensive filter if no rule applied.
+    if (!filterCallback)
+        return true;
+    return canAccessCookies(QtWebEngineCore::toQt(firstPartyUrl), QtWebEngineCore::toQt(url));
+}
+
+bool QWebEngineCookieStorePrivate::hasAccessFilter() const
+{
+    return bool(filterCallback) || accessPolicy();
+}
+
+void QWebEngineCookieStorePrivate::setAccessPolicy(
+        std::shared_ptr<const QtWebEngineCore::CookieAccessPolicyQt> policy)
+{
+    const bool hadFilter = hasAccessFilter();
+    if (policy && policy->isEmpty())
+        policy.reset();
+    std::atomic_store(&m_accessPolicy, std::move(policy));
+    if (delegate && hadFilter != hasAccessFilter())
+        delegate->setHasFilter(hasAccessFilter());
+}
+
+std::shared_ptr<const QtWebEngineCore::CookieAccessPolicyQt>
+QWebEngineCookieStorePrivate::accessPolicy() const
+{
+    return std::atomic_load(&m_accessPolicy);
+}
+
 /*!
     \class QWebEngineCookieStore
     \inmodule QtWebEngineCore
@@ -243,6 +332,77 @@ void QWebEngineCookieStore::loadAllCookies()
     d_ptr->getAllCookies();
 }
 
+/*!
+    \since 6.9
+
+    Retrieves all cookies of the cookie store in a single list and passes it to
+    \a resultCallback. If \a domain is not empty, only cookies set for \a domain or
+    one of its subdomains are returned.
+
+    Unlike loadAllCookies(), this function does not emit cookieAdded() for each cookie,
+    which makes it suitable for taking snapshots of large cookie stores.
+
+    \note This operation is asynchronous.
+    \sa setCookies(), loadAllCookies()
+*/
+
+void QWebEngineCookieStore::getCookies(const std::function<void(const QList<QNetworkCookie> &)> &resultCallback,
+                                       const QString &domain)
+{
+    if (!resultCallback)
+        return;
+    d_ptr->getCookies(domain, 0, [resultCallback](const QList<QNetworkCookie> &cookies, bool) {
+        resultCallback(cookies);
+        return true;
+    });
+}
+
+/*!
+    \since 6.9
+    \overload
+
+    Retrieves the cookies of the cookie store in pages of at most \a pageSize cookies,
+    and passes them one by one to \a pageCallback. The second argument of \a pageCallback
+    is \c true for the last page. Returning \c false from \a pageCallback stops the
+    delivery of further pages. The event loop is run between two pages, so that
+    enumerating a large cookie store does not block the application.
+
+    If \a domain is not empty, only cookies set for \a domain or one of its subdomains
+    are returned.
+
+    Paging bounds how many cookies are delivered at a time, not the cost of fetching
+    them: all matching cookies are still read from the cookie store at once before the
+    first page is delivered.
+
+    \note This operation is asynchronous.
+*/
+
+void QWebEngineCookieStore::getCookies(qsizetype pageSize,
+                                       const std::function<bool(const QList<QNetworkCookie> &, bool)> &pageCallback,
+                                       const QString &domain)
+{
+    if (!pageCallback)
+        return;
+    d_ptr->getCookies(domain, qMax(pageSize, qsizetype(1)), pageCallback);
+}
+
+/*!
+    \since 6.9
+
+    Adds all \a cookies to the cookie store in one batch. \a origin is applied to every cookie
+    as in setCookie(). Once all cookies have been stored, \a resultCallback is called with the
+    number of cookies that were successfully imported. Invalid cookies are skipped.
+
+    \note This operation is asynchronous.
+    \sa setCookie(), getCookies()
+*/
+
+void QWebEngineCookieStore::setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin,
+                                       const std::function<void(qsizetype)> &resultCallback)
+{
+    d_ptr->setCookies(cookies, origin, resultCallback);
+}
+
 /*!
     Deletes all the session cookies in the cookie store. Session cookies do not have an
     expiration date assigned to them.
@@ -301,10 +461,10 @@ void QWebEngineCookieStore::deleteAllCookies()
 */
 void QWebEngineCookieStore::setCookieFilter(const std::function<bool(const FilterRequest &)> &filterCallback)
 {
-    bool changed = bool(d_ptr->filterCallback) != bool(filterCallback);
+    bool hadFilter = d_ptr->hasAccessFilter();
     d_ptr->filterCallback = filterCallback;
-    if (changed && d_ptr->delegate)
-        d_ptr->delegate->setHasFilter(bool(d_ptr->filterCallback));
+    if (hadFilter != d_ptr->hasAccessFilter() && d_ptr->delegate)
+        d_ptr->delegate->setHasFilter(d_ptr->hasAccessFilter());
 }
 
 /*!
@@ -313,10 +473,97 @@ void QWebEngineCookieStore::setCookieFilter(const std::function<bool(const Filte
 */
 void QWebEngineCookieStore::setCookieFilter(std::function<bool(const FilterRequest &)> &&filterCallback)
 {
-    bool changed = bool(d_ptr->filterCallback) != bool(filterCallback);
+    bool hadFilter = d_ptr->hasAccessFilter();
     d_ptr->filterCallback = std::move(filterCallback);
-    if (changed && d_ptr->delegate)
-        d_ptr->delegate->setHasFilter(bool(d_ptr->filterCallback));
+    if (hadFilter != d_ptr->hasAccessFilter() && d_ptr->delegate)
+        d_ptr->delegate->setHasFilter(d_ptr->hasAccessFilter());
+}
+
+/*!
+    \enum QWebEngineCookieStore::AccessRule
+    \since 6.9
+
+    This enum describes how cookie access of a site is handled by a rule set with
+    setAccessRule().
+
+    \value Allow All cookie access is allowed.
+    \value Block All cookie access is blocked.
+    \value BlockThirdParty Cookie access is allowed unless it is considered a third-party
+    access, see FilterRequest::thirdParty.
+*/
+
+/*!
+    \since 6.9
+
+    Sets the cookie access \a rule for \a domain and all of its subdomains. The most specific
+    rule matching the host of the URL accessing a cookie is applied. An empty \a domain sets the
+    rule for all sites that have no more specific rule.
+
+    Unlike a cookie filter installed with setCookieFilter(), the rules are evaluated directly on
+    Chromium's side for every cookie access, without converting any data to Qt types or calling
+    into application code. The cookie filter is only called for accesses that are not covered by
+    any rule, so a filter can be kept for the few cases that cannot be expressed declaratively.
+
+    The following code snippet blocks third-party cookies everywhere except for a single
+    trusted service:
+
+    \code
+    profile->cookieStore()->setAccessRule(QString(), QWebEngineCookieStore::AccessRule::BlockThirdParty);
+    profile->cookieStore()->setAccessRule("sso.example.com", QWebEngineCookieStore::AccessRule::Allow);
+    \endcode
+
+    \note Like the cookie filter, the rules also control other features with tracking
+    capabilities similar to those of cookies.
+
+    \sa removeAccessRule(), clearAccessRules(), setCookieFilter()
+*/
+void QWebEngineCookieStore::setAccessRule(const QString &domain, AccessRule rule)
+{
+    const std::optional<std::string> canonical = canonicalDomain(domain);
+    if (!canonical) {
+        qWarning("Cannot set a cookie access rule for invalid domain %ls.", qUtf16Printable(domain));
+        return;
+    }
+    auto policy = d_ptr->accessPolicy();
+    auto updated = policy ? std::make_shared<CookieAccessPolicyQt>(*policy)
+                          : std::make_shared<CookieAccessPolicyQt>();
+    updated->setRule(*canonical, static_cast<CookieAccessPolicyQt::Rule>(rule));
+    d_ptr->setAccessPolicy(std::move(updated));
+}
+
+/*!
+    \since 6.9
+
+    Removes the cookie access rule for exactly \a domain, if one was set.
+
+    \sa setAccessRule(), clearAccessRules()
+*/
+void QWebEngineCookieStore::removeAccessRule(const QString &domain)
+{
+    const std::optional<std::string> canonical = canonicalDomain(domain);
+    if (!canonical) {
+        qWarning("Cannot remove the cookie access rule of invalid domain %ls.", qUtf16Printable(domain));
+        return;
+    }
+    auto policy = d_ptr->accessPolicy();
+    if (!policy)
+        return;
+    auto updated = std::make_shared<CookieAccessPolicyQt>(*policy);
+    if (updated->removeRule(*canonical))
+        d_ptr->setAccessPolicy(std::move(updated));
+}
+
+/*!
+    \since 6.9
+
+    Removes all cookie access rules. Afterwards, all cookie access is decided by the cookie
+    filter, if one is installed.
+
+    \sa setAccessRule(), removeAccessRule()
+*/
+void QWebEngineCookieStore::clearAccessRules()
+{
+    d_ptr->setAccessPolicy(nullptr);
 }
 
 /*!
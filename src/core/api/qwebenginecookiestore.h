@@ -6,6 +6,7 @@
 
 #include <QtWebEngineCore/qtwebenginecoreglobal.h>
 
+#include <QtCore/qlist.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qscopedpointer.h>
 #include <QtCore/qurl.h>
@@ -34,15 +35,33 @@ public:
         bool _reservedFlag;
         ushort _reservedType;
     };
+
+    enum class AccessRule {
+        Allow,
+        Block,
+        BlockThirdParty,
+    };
+    Q_ENUM(AccessRule)
+
     virtual ~QWebEngineCookieStore();
 
     void setCookieFilter(const std::function<bool(const FilterRequest &)> &filterCallback);
     void setCookieFilter(std::function<bool(const FilterRequest &)> &&filterCallback);
+    void setAccessRule(const QString &domain, AccessRule rule);
+    void removeAccessRule(const QString &domain);
+    void clearAccessRules();
     void setCookie(const QNetworkCookie &cookie, const QUrl &origin = QUrl());
     void deleteCookie(const QNetworkCookie &cookie, const QUrl &origin = QUrl());
     void deleteSessionCookies();
     void deleteAllCookies();
     void loadAllCookies();
+    void getCookies(const std::function<void(const QList<QNetworkCookie> &)> &resultCallback,
+                    const QString &domain = QString());
+    void getCookies(qsizetype pageSize,
+                    const std::function<bool(const QList<QNetworkCookie> &, bool)> &pageCallback,
+                    const QString &domain = QString());
+    void setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin = QUrl(),
+                    const std::function<void(qsizetype)> &resultCallback = {});
 
 Q_SIGNALS:
     void cookieAdded(const QNetworkCookie &cookie);
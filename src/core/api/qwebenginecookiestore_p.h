@@ -23,7 +23,12 @@
 #include <QNetworkCookie>
 #include <QUrl>
 
+#include <memory>
+
+class GURL;
+
 namespace QtWebEngineCore {
+class CookieAccessPolicyQt;
 class CookieMonsterDelegateQt;
 }
 
@@ -37,18 +42,34 @@ class Q_WEBENGINECORE_EXPORT QWebEngineCookieStorePrivate
         QNetworkCookie cookie;
         QUrl origin;
     };
+    struct CookieQuery {
+        QString domain;
+        qsizetype pageSize;
+        std::function<bool(const QList<QNetworkCookie> &, bool)> callback;
+    };
+    struct CookieImport {
+        QList<QNetworkCookie> cookies;
+        QUrl origin;
+        std::function<void(qsizetype)> callback;
+    };
     friend class QTypeInfo<CookieData>;
     QWebEngineCookieStore *q_ptr;
 
 public:
     std::function<bool(const QWebEngineCookieStore::FilterRequest &)> filterCallback;
     QList<CookieData> m_pendingUserCookies;
+    QList<CookieImport> m_pendingCookieImports;
+    QList<CookieQuery> m_pendingCookieQueries;
     bool m_deleteSessionCookiesPending;
     bool m_deleteAllCookiesPending;
     bool m_getAllCookiesPending;
 
     QtWebEngineCore::CookieMonsterDelegateQt *delegate;
 
+    // Access checks run on the UI and IO threads, so the rules are replaced as a
+    // whole with an atomic store and never modified in place.
+    std::shared_ptr<const QtWebEngineCore::CookieAccessPolicyQt> m_accessPolicy;
+
     QWebEngineCookieStorePrivate(QWebEngineCookieStore *q);
 
     void processPendingUserCookies();
@@ -58,8 +79,16 @@ public:
     void deleteSessionCookies();
     void deleteAllCookies();
     void getAllCookies();
+    void getCookies(const QString &domain, qsizetype pageSize,
+                    std::function<bool(const QList<QNetworkCookie> &, bool)> callback);
+    void setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin,
+                    std::function<void(qsizetype)> callback);
 
     bool canAccessCookies(const QUrl &firstPartyUrl, const QUrl &url) const;
+    bool canAccessCookies(const GURL &firstPartyUrl, const GURL &url) const;
+    bool hasAccessFilter() const;
+    void setAccessPolicy(std::shared_ptr<const QtWebEngineCore::CookieAccessPolicyQt> policy);
+    std::shared_ptr<const QtWebEngineCore::CookieAccessPolicyQt> accessPolicy() const;
 
     void onCookieChanged(const QNetworkCookie &cookie, bool removed);
 };
@@ -6,6 +6,7 @@
 
 #include "qwebenginepage.h"
 
+#include "download_throttle.h"
 #include "profile_adapter.h"
 #include "web_contents_adapter_client.h"
 
@@ -159,8 +160,15 @@ void QWebEngineDownloadRequestPrivate::update(const ProfileAdapterClient::Downlo
       }
     }
 
-    if (info.done)
+    if (info.bytesPerSecond != bytesPerSecond) {
+        bytesPerSecond = info.bytesPerSecond;
+        Q_EMIT q->bytesPerSecondChanged();
+    }
+
+    if (info.done) {
+        hash = info.hash;
         setFinished();
+    }
 
     if (downloadPaused != info.paused) {
         downloadPaused = info.paused;
@@ -186,6 +194,15 @@ void QWebEngineDownloadRequestPrivate::answer()
         QString path = QDir(downloadDirectory).filePath(downloadFileName);
         bool accepted = downloadState != QWebEngineDownloadRequest::DownloadCancelled
                 && downloadState != QWebEngineDownloadRequest::DownloadRequested;
+        if (accepted && !isSavePageDownload
+            && (hashAlgorithm != QWebEngineDownloadRequest::NoHash || outputDevice)) {
+            std::optional<QCryptographicHash::Algorithm> algorithm;
+            if (hashAlgorithm == QWebEngineDownloadRequest::Sha256Hash)
+                algorithm = QCryptographicHash::Sha256;
+            else if (hashAlgorithm == QWebEngineDownloadRequest::Sha512Hash)
+                algorithm = QCryptographicHash::Sha512;
+            profileAdapter->setDownloadSink(downloadId, algorithm, outputDevice);
+        }
         profileAdapter->acceptDownload(downloadId, accepted, useDownloadTargetCallback, path, savePageFormat);
         answered = true;
     }
@@ -350,6 +367,19 @@ quint32 QWebEngineDownloadRequest::id() const
     \value MimeHtmlSaveFormat The page is saved as a complete web page in the MIME HTML format.
 */
 
+/*!
+    \enum QWebEngineDownloadRequest::HashAlgorithm
+    \since 6.9
+
+    This enum describes the hash that is computed over the downloaded data.
+
+    \value NoHash No hash is computed.
+    \value Sha256Hash A SHA-256 hash is computed.
+    \value Sha512Hash A SHA-512 hash is computed.
+
+    \sa hashAlgorithm, hash
+*/
+
 /*!
     \enum QWebEngineDownloadRequest::DownloadInterruptReason
 
@@ -424,6 +454,168 @@ qint64 QWebEngineDownloadRequest::receivedBytes() const
     return d->receivedBytes;
 }
 
+/*!
+    \property QWebEngineDownloadRequest::bytesPerSecond
+    \brief The current transfer rate of the download in bytes per second.
+    \since 6.9
+
+    While the download is throttled by maximumBytesPerSecond or by the limits of the
+    profile, the rate is averaged over the intervals in which the download is held back.
+
+    \sa maximumBytesPerSecond, QWebEngineProfile::downloadBytesPerSecond()
+*/
+
+qint64 QWebEngineDownloadRequest::bytesPerSecond() const
+{
+    Q_D(const QWebEngineDownloadRequest);
+    return d->bytesPerSecond;
+}
+
+/*!
+    \property QWebEngineDownloadRequest::maximumBytesPerSecond
+    \brief The maximum transfer rate of the download in bytes per second.
+    \since 6.9
+
+    A download over its limit stops reading from the network until the average rate
+    is back within the limit, so the sender is slowed down by flow control. Such a
+    download is not reported as paused. The limit applies in addition to
+    QWebEngineProfile::maximumDownloadBytesPerSecond.
+
+    The default value is \c 0, which means the rate is not limited.
+
+    \sa bytesPerSecond, QWebEngineProfile::setMaximumDownloadBytesPerSecond()
+*/
+
+qint64 QWebEngineDownloadRequest::maximumBytesPerSecond() const
+{
+    Q_D(const QWebEngineDownloadRequest);
+    return d->maximumBytesPerSecond;
+}
+
+void QWebEngineDownloadRequest::setMaximumBytesPerSecond(qint64 bytesPerSecond)
+{
+    Q_D(QWebEngineDownloadRequest);
+    bytesPerSecond = qMax<qint64>(bytesPerSecond, 0);
+    if (d->maximumBytesPerSecond == bytesPerSecond)
+        return;
+    d->maximumBytesPerSecond = bytesPerSecond;
+    if (d->profileAdapter && !d->isSavePageDownload)
+        d->profileAdapter->downloadThrottle()->setMaximumBytesPerSecond(d->downloadId, bytesPerSecond);
+    Q_EMIT maximumBytesPerSecondChanged();
+}
+
+/*!
+    \property QWebEngineDownloadRequest::hashAlgorithm
+    \brief The hash to compute over the downloaded data.
+    \since 6.9
+
+    The data is hashed while it is written, so the hash is available when the download
+    is finished without reading the file again. A SHA-256 hash of a download that is not
+    passed on to an outputDevice is taken from Chromium, which computes it anyway.
+
+    The hash algorithm can only be set in response to the
+    QWebEngineProfile::downloadRequested() signal before the download is accepted. Past
+    that point, setting it has no effect. Web page downloads are not hashed.
+
+    The default value is \l NoHash.
+
+    \sa hash
+*/
+
+QWebEngineDownloadRequest::HashAlgorithm QWebEngineDownloadRequest::hashAlgorithm() const
+{
+    Q_D(const QWebEngineDownloadRequest);
+    return d->hashAlgorithm;
+}
+
+void QWebEngineDownloadRequest::setHashAlgorithm(HashAlgorithm algorithm)
+{
+    Q_D(QWebEngineDownloadRequest);
+    if (d->downloadState != QWebEngineDownloadRequest::DownloadRequested) {
+        qWarning("Setting the hash algorithm is not allowed after the download has been accepted.");
+        return;
+    }
+    if (d->hashAlgorithm == algorithm)
+        return;
+    d->hashAlgorithm = algorithm;
+    Q_EMIT hashAlgorithmChanged();
+}
+
+/*!
+    \property QWebEngineDownloadRequest::hash
+    \brief The hash of the downloaded data.
+    \since 6.9
+
+    The hash is computed with hashAlgorithm. It is available when the download has
+    finished in the \l DownloadCompleted state, and empty otherwise.
+
+    \sa hashAlgorithm, isFinished
+*/
+
+QByteArray QWebEngineDownloadRequest::hash() const
+{
+    Q_D(const QWebEngineDownloadRequest);
+    return d->hash;
+}
+
+/*!
+    \since 6.9
+
+    Returns the device the downloaded data is written to, or \c nullptr if the data is
+    kept in a file.
+
+    \sa setOutputDevice()
+*/
+
+QIODevice *QWebEngineDownloadRequest::outputDevice() const
+{
+    Q_D(const QWebEngineDownloadRequest);
+    return d->outputDevice;
+}
+
+/*!
+    \since 6.9
+
+    Sets \a device as the device to write the downloaded data to, in place of a file in
+    downloadDirectory(). The device must be open for writing and must stay alive until
+    the download is finished.
+
+    Chromium still writes the data to the file chosen with downloadDirectory() and
+    downloadFileName(), which only serves as a buffer. The data is written to \a device
+    as it arrives, and the file is removed once all of it was written. Until then the
+    file grows to the full size of the download, so the download directory needs as
+    much free space as without an output device, and all data is written to and read
+    back from disk once. While \a device has too much data buffered, for example a
+    socket to a slow peer, no more data is written to it, and the download stops
+    receiving data until \a device caught up. The download is not reported as paused in
+    the meantime.
+
+    The download is only reported as finished once all of its data was written to
+    \a device. If writing to \a device fails, or \a device is destroyed, the download is
+    cancelled. A download that is resumed after an interruption and has to start over,
+    because the server does not support range requests, is cancelled as well.
+
+    The output device can only be set in response to the
+    QWebEngineProfile::downloadRequested() signal before the download is accepted. Past
+    that point, this function has no effect. Web page downloads always go to a file.
+
+    \sa outputDevice(), hashAlgorithm
+*/
+
+void QWebEngineDownloadRequest::setOutputDevice(QIODevice *device)
+{
+    Q_D(QWebEngineDownloadRequest);
+    if (d->downloadState != QWebEngineDownloadRequest::DownloadRequested) {
+        qWarning("Setting the output device is not allowed after the download has been accepted.");
+        return;
+    }
+    if (device && !device->isWritable()) {
+        qWarning("The output device of a download must be open for writing.");
+        return;
+    }
+    d->outputDevice = device;
+}
+
 /*!
     Returns the download's origin URL.
 */
@@ -11,6 +11,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QIODevice;
 class QWebEngineDownloadRequestPrivate;
 class QWebEnginePage;
 class QWebEngineProfilePrivate;
@@ -34,6 +35,10 @@ public:
     Q_PROPERTY(QString suggestedFileName READ suggestedFileName CONSTANT FINAL)
     Q_PROPERTY(QString downloadDirectory READ downloadDirectory WRITE setDownloadDirectory NOTIFY downloadDirectoryChanged FINAL)
     Q_PROPERTY(QString downloadFileName READ downloadFileName WRITE setDownloadFileName NOTIFY downloadFileNameChanged FINAL)
+    Q_PROPERTY(qint64 bytesPerSecond READ bytesPerSecond NOTIFY bytesPerSecondChanged REVISION(6, 9) FINAL)
+    Q_PROPERTY(qint64 maximumBytesPerSecond READ maximumBytesPerSecond WRITE setMaximumBytesPerSecond NOTIFY maximumBytesPerSecondChanged REVISION(6, 9) FINAL)
+    Q_PROPERTY(HashAlgorithm hashAlgorithm READ hashAlgorithm WRITE setHashAlgorithm NOTIFY hashAlgorithmChanged REVISION(6, 9) FINAL)
+    Q_PROPERTY(QByteArray hash READ hash NOTIFY isFinishedChanged REVISION(6, 9) FINAL)
 
     ~QWebEngineDownloadRequest() override;
 
@@ -85,6 +90,13 @@ public:
     };
     Q_ENUM(DownloadInterruptReason)
 
+    enum HashAlgorithm {
+        NoHash,
+        Sha256Hash,
+        Sha512Hash
+    };
+    Q_ENUM(HashAlgorithm)
+
     quint32 id() const;
     DownloadState state() const;
     qint64 totalBytes() const;
@@ -103,6 +115,14 @@ public:
     void setDownloadDirectory(const QString &directory);
     QString downloadFileName() const;
     void setDownloadFileName(const QString &fileName);
+    qint64 bytesPerSecond() const;
+    qint64 maximumBytesPerSecond() const;
+    void setMaximumBytesPerSecond(qint64 bytesPerSecond);
+    HashAlgorithm hashAlgorithm() const;
+    void setHashAlgorithm(HashAlgorithm algorithm);
+    QByteArray hash() const;
+    QIODevice *outputDevice() const;
+    void setOutputDevice(QIODevice *device);
 
     QWebEnginePage *page() const;
 
@@ -122,6 +142,9 @@ Q_SIGNALS:
     void isPausedChanged();
     void downloadDirectoryChanged();
     void downloadFileNameChanged();
+    Q_REVISION(6, 9) void bytesPerSecondChanged();
+    Q_REVISION(6, 9) void maximumBytesPerSecondChanged();
+    Q_REVISION(6, 9) void hashAlgorithmChanged();
 
 private:
     Q_DISABLE_COPY(QWebEngineDownloadRequest)
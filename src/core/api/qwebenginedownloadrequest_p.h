@@ -18,6 +18,7 @@
 #include "qtwebenginecoreglobal.h"
 #include "qwebenginedownloadrequest.h"
 #include "profile_adapter_client.h"
+#include <QIODevice>
 #include <QString>
 #include <QPointer>
 
@@ -57,6 +58,11 @@ public:
     bool isCustomFileName = false;
     qint64 totalBytes = -1;
     qint64 receivedBytes = 0;
+    qint64 bytesPerSecond = 0;
+    qint64 maximumBytesPerSecond = 0;
+    QWebEngineDownloadRequest::HashAlgorithm hashAlgorithm = QWebEngineDownloadRequest::NoHash;
+    QByteArray hash;
+    QPointer<QIODevice> outputDevice;
     // The user initiated the download by saving the page
     bool isSavePageDownload = false;
     // Which type of callback should be called when the request is answered
@@ -70,6 +70,7 @@ public:
 private:
     friend class QWebEnginePage;
     friend class QWebEnginePagePrivate;
+    friend class QWebEngineProcessUsage;
     friend class QQuickWebEngineView;
     friend class QQuickWebEngineViewPrivate;
 
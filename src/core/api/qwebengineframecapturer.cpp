@@ -0,0 +1,209 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qwebengineframecapturer.h"
+
+#include "qwebenginepage.h"
+#include "qwebenginepage_p.h"
+
+#include "frame_sink_capturer.h"
+#include "web_contents_adapter.h"
+
+#include <QtCore/qpointer.h>
+
+QT_BEGIN_NAMESPACE
+
+class QWebEngineFrameCapturerPrivate
+{
+public:
+    QWebEngineFrameCapturer *q_ptr;
+    QPointer<QWebEnginePage> page;
+    QWebEngineCapturedFrame::PixelFormat pixelFormat = QWebEngineCapturedFrame::PixelFormat::I420;
+    qreal maximumFrameRate = 30;
+    QSize frameSize;
+    std::unique_ptr<QtWebEngineCore::FrameSinkCapturer> capturer;
+};
+
+/*!
+    \class QWebEngineFrameCapturer
+    \brief Captures the frames of a web engine page as they are composited.
+    \inmodule QtWebEngineCore
+    \since 6.9
+
+    QWebEngineFrameCapturer delivers the composited frames of a page, for example to
+    record the page into a video or to stream it to a remote display. Unlike grabbing
+    the view, the frames are read back by the compositor into shared memory buffers, in a
+    pixel format a video encoder can consume without a conversion, and only when the page
+    changed.
+
+    \code
+    auto *capturer = new QWebEngineFrameCapturer(page);
+    capturer->setMaximumFrameRate(60);
+    connect(capturer, &QWebEngineFrameCapturer::frameCaptured,
+            encoder, &Encoder::encode);
+    capturer->start();
+    \endcode
+
+    The page does not have to be shown, pages that are hidden or have no view keep painting
+    while they are captured.
+
+    \sa QWebEngineCapturedFrame, QWebEnginePage::capture()
+*/
+
+/*!
+    Constructs a capturer for the frames of \a page, with the parent \a parent.
+*/
+QWebEngineFrameCapturer::QWebEngineFrameCapturer(QWebEnginePage *page, QObject *parent)
+    : QObject(parent), d_ptr(new QWebEngineFrameCapturerPrivate)
+{
+    Q_D(QWebEngineFrameCapturer);
+    d->q_ptr = this;
+    d->page = page;
+}
+
+/*!
+    Destroys the capturer, stopping the capture.
+*/
+QWebEngineFrameCapturer::~QWebEngineFrameCapturer() { }
+
+/*!
+    Returns the page whose frames are captured.
+*/
+QWebEnginePage *QWebEngineFrameCapturer::page() const
+{
+    Q_D(const QWebEngineFrameCapturer);
+    return d->page;
+}
+
+/*!
+    \property QWebEngineFrameCapturer::pixelFormat
+    \brief The pixel format of the captured frames.
+
+    Defaults to QWebEngineCapturedFrame::PixelFormat::I420. Changes take effect on the next
+    call to start().
+*/
+QWebEngineCapturedFrame::PixelFormat QWebEngineFrameCapturer::pixelFormat() const
+{
+    Q_D(const QWebEngineFrameCapturer);
+    return d->pixelFormat;
+}
+
+void QWebEngineFrameCapturer::setPixelFormat(QWebEngineCapturedFrame::PixelFormat format)
+{
+    Q_D(QWebEngineFrameCapturer);
+    d->pixelFormat = format;
+}
+
+/*!
+    \property QWebEngineFrameCapturer::maximumFrameRate
+    \brief The maximum number of frames captured per second.
+
+    Frames are only captured when the page changed, so the actual frame rate can be lower.
+    Defaults to 30. Changes take effect on the next call to start().
+*/
+qreal QWebEngineFrameCapturer::maximumFrameRate() const
+{
+    Q_D(const QWebEngineFrameCapturer);
+    return d->maximumFrameRate;
+}
+
+void QWebEngineFrameCapturer::setMaximumFrameRate(qreal frameRate)
+{
+    Q_D(QWebEngineFrameCapturer);
+    d->maximumFrameRate = frameRate;
+}
+
+/*!
+    \property QWebEngineFrameCapturer::frameSize
+    \brief The size of the captured frames in pixels.
+
+    The page is scaled to fit into the frames, keeping its aspect ratio, see
+    QWebEngineCapturedFrame::contentRect(). If the size is empty, which is the default,
+    the size of the view in device pixels at the time start() is called is used.
+    Changes take effect on the next call to start().
+*/
+QSize QWebEngineFrameCapturer::frameSize() const
+{
+    Q_D(const QWebEngineFrameCapturer);
+    return d->frameSize;
+}
+
+void QWebEngineFrameCapturer::setFrameSize(const QSize &size)
+{
+    Q_D(QWebEngineFrameCapturer);
+    d->frameSize = size;
+}
+
+/*!
+    \property QWebEngineFrameCapturer::active
+    \brief Whether frames are being captured.
+
+    The capture stops when stop() is called or the page is closed.
+*/
+bool QWebEngineFrameCapturer::isActive() const
+{
+    Q_D(const QWebEngineFrameCapturer);
+    return d->capturer && d->capturer->isActive();
+}
+
+/*!
+    Starts capturing frames. A running capture is restarted with the current settings.
+
+    \sa stop(), frameCaptured()
+*/
+void QWebEngineFrameCapturer::start()
+{
+    Q_D(QWebEngineFrameCapturer);
+    const bool wasActive = isActive();
+    d->capturer.reset();
+    if (d->page) {
+        QWebEnginePagePrivate *pageD = QWebEnginePagePrivate::get(d->page);
+        pageD->ensureInitialized();
+        const auto &adapter = pageD->adapter;
+        d->capturer = std::make_unique<QtWebEngineCore::FrameSinkCapturer>(
+                adapter->webContents(),
+                [this](const QtWebEngineCore::CapturedFrame &frame) {
+                    Q_EMIT frameCaptured(QWebEngineCapturedFrame(frame));
+                },
+                [this]() { Q_EMIT activeChanged(false); });
+        const auto format = d->pixelFormat == QWebEngineCapturedFrame::PixelFormat::I420
+                ? QtWebEngineCore::CapturedFrame::I420
+                : QtWebEngineCore::CapturedFrame::ARGB;
+        if (!d->capturer->start(format, d->maximumFrameRate, d->frameSize))
+            d->capturer.reset();
+    }
+    if (wasActive != isActive())
+        Q_EMIT activeChanged(isActive());
+}
+
+/*!
+    Stops capturing frames. Frames that were already delivered stay valid.
+*/
+void QWebEngineFrameCapturer::stop()
+{
+    Q_D(QWebEngineFrameCapturer);
+    if (!isActive())
+        return;
+    d->capturer.reset();
+    Q_EMIT activeChanged(false);
+}
+
+/*!
+    \fn void QWebEngineFrameCapturer::frameCaptured(const QWebEngineCapturedFrame &frame)
+
+    This signal is emitted when a new \a frame has been captured.
+
+    The number of buffers the compositor captures into is limited. If frames are kept
+    alive for too long, for example because the encoder falls behind, frames are dropped
+    until buffers are released again.
+*/
+
+/*!
+    \fn void QWebEngineFrameCapturer::activeChanged(bool active)
+
+    This signal is emitted when the capture started or stopped, as indicated by \a active.
+*/
+
+QT_END_NAMESPACE
+
+#include "moc_qwebengineframecapturer.cpp"
@@ -0,0 +1,58 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QWEBENGINEFRAMECAPTURER_H
+#define QWEBENGINEFRAMECAPTURER_H
+
+#include <QtWebEngineCore/qtwebenginecoreglobal.h>
+#include <QtWebEngineCore/qwebenginecapturedframe.h>
+
+#include <QtCore/qobject.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qsize.h>
+
+QT_BEGIN_NAMESPACE
+
+class QWebEngineFrameCapturerPrivate;
+class QWebEnginePage;
+
+class Q_WEBENGINECORE_EXPORT QWebEngineFrameCapturer : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QWebEngineCapturedFrame::PixelFormat pixelFormat READ pixelFormat WRITE setPixelFormat FINAL)
+    Q_PROPERTY(qreal maximumFrameRate READ maximumFrameRate WRITE setMaximumFrameRate FINAL)
+    Q_PROPERTY(QSize frameSize READ frameSize WRITE setFrameSize FINAL)
+    Q_PROPERTY(bool active READ isActive NOTIFY activeChanged FINAL)
+
+public:
+    explicit QWebEngineFrameCapturer(QWebEnginePage *page, QObject *parent = nullptr);
+    ~QWebEngineFrameCapturer() override;
+
+    QWebEnginePage *page() const;
+
+    QWebEngineCapturedFrame::PixelFormat pixelFormat() const;
+    void setPixelFormat(QWebEngineCapturedFrame::PixelFormat format);
+    qreal maximumFrameRate() const;
+    void setMaximumFrameRate(qreal frameRate);
+    QSize frameSize() const;
+    void setFrameSize(const QSize &size);
+
+    bool isActive() const;
+
+public Q_SLOTS:
+    void start();
+    void stop();
+
+Q_SIGNALS:
+    void frameCaptured(const QWebEngineCapturedFrame &frame);
+    void activeChanged(bool active);
+
+private:
+    Q_DISABLE_COPY(QWebEngineFrameCapturer)
+    Q_DECLARE_PRIVATE(QWebEngineFrameCapturer)
+    QScopedPointer<QWebEngineFrameCapturerPrivate> d_ptr;
+};
+
+QT_END_NAMESPACE
+
+#endif // QWEBENGINEFRAMECAPTURER_H
@@ -14,6 +14,10 @@ extern void configureStubHostResolver(QWebEngineGlobalSettings::SecureDnsMode dn
                                       std::string dnsOverHttpsTemplates, bool insecureDnsClientEnabled,
                                       bool additionalInsecureDnsTypesEnabled);
 extern bool isValidTemplates(std::string templates);
+extern void notifyMemoryPressure(QWebEngineGlobalSettings::MemoryPressureLevel level);
+extern void setMemoryPressureMonitoringEnabled(bool enabled);
+extern bool isMemoryPressureMonitoringSupported();
+extern bool isWebEngineContextInitialized();
 
 } // namespace QtWebEngineCore
 
@@ -29,6 +33,14 @@ QT_BEGIN_NAMESPACE
 
     Invoke setDnsMode() to configure DNS-over-HTTPS.
 
+    Invoke notifyMemoryPressure() or setMemoryPressureMonitoringEnabled() to let the
+    web engine release memory when the system runs low on it.
+
+    Invoke setRasterSettings() to tune how web content is rasterized.
+
+    Invoke setParallelDownloadSettings() to let large downloads be fetched over
+    several connections.
+
     \sa QWebEngineGlobalSettings::setDnsMode()
 */
 
@@ -108,6 +120,216 @@ bool QWebEngineGlobalSettings::setDnsMode(DnsMode dnsMode)
     return true;
 }
 
+/*!
+    \enum QWebEngineGlobalSettings::MemoryPressureLevel
+    \since 6.9
+
+    This enum describes how urgently the web engine should release memory:
+
+    \value None There is no memory pressure.
+    \value Moderate The system is running low on memory. Caches that are cheap to
+    rebuild are purged.
+    \value Critical The system is about to run out of memory. As much memory as
+    possible is released, at the cost of a slower resumption of the affected pages.
+*/
+
+/*!
+    \fn void QWebEngineGlobalSettings::notifyMemoryPressure(MemoryPressureLevel level)
+    \since 6.9
+
+    Notifies the web engine about memory pressure of the given \a level.
+
+    The notification is forwarded to the browser process and all renderer processes,
+    which release memory accordingly, for example by purging image and font caches and
+    running garbage collection. Applications can call this function when the platform
+    reports low memory, for example from a mobile or embedded memory manager.
+
+    Calling this function before the web engine is initialized, or with
+    MemoryPressureLevel::None, has no effect.
+
+    \sa setMemoryPressureMonitoringEnabled(), QWebEngineProfile::notifyMemoryPressure()
+*/
+
+void QWebEngineGlobalSettings::notifyMemoryPressure(MemoryPressureLevel level)
+{
+    QtWebEngineCore::notifyMemoryPressure(level);
+}
+
+/*!
+    \fn bool QWebEngineGlobalSettings::setMemoryPressureMonitoringEnabled(bool enabled)
+    \since 6.9
+
+    Sets whether the web engine monitors the memory pressure of the system on its own
+    to \a enabled. Monitoring is disabled by default.
+
+    When enabled, the pressure stall information of the kernel is sampled once per second
+    and memory pressure is reported as if notifyMemoryPressure() had been called.
+
+    This function returns \c false if \a enabled is \c true and monitoring is not supported
+    on the platform. Currently, it is only supported on Linux kernels providing
+    \c{/proc/pressure/memory}.
+
+    \sa notifyMemoryPressure()
+*/
+
+bool QWebEngineGlobalSettings::setMemoryPressureMonitoringEnabled(bool enabled)
+{
+    if (enabled && !QtWebEngineCore::isMemoryPressureMonitoringSupported())
+        return false;
+    QWebEngineGlobalSettingsPrivate::instance()->memoryPressureMonitoringEnabled = enabled;
+    QtWebEngineCore::setMemoryPressureMonitoringEnabled(enabled);
+    return true;
+}
+
+/*!
+    \enum QWebEngineGlobalSettings::RasterMode
+    \since 6.9
+
+    This enum describes how rasterized tiles are handed to the GPU compositor:
+
+    \value Default Chromium chooses the mode for the platform.
+    \value ZeroCopy Tiles are rasterized directly into GPU memory buffers.
+    \value OneCopy Tiles are rasterized into shared memory and copied into GPU
+    textures by the GPU thread.
+
+    With software compositing, for example when running with \c{--disable-gpu},
+    tiles are always rasterized into shared memory and the mode has no effect.
+*/
+
+/*!
+    \class QWebEngineGlobalSettings::RasterSettings
+    \brief The RasterSettings struct configures the rasterization of web content.
+    \since 6.9
+    \inmodule QtWebEngineCore
+
+    Renderer processes split web content into tiles and rasterize them on a pool of
+    worker threads. The defaults suit desktop machines; on machines with many cores,
+    for example servers rendering large dashboards without a GPU, raising the number
+    of raster threads up to its maximum of 4 can increase throughput considerably.
+*/
+
+/*!
+    \variable QWebEngineGlobalSettings::RasterSettings::threadCount
+    \brief The number of raster worker threads of each renderer process.
+
+    The value must be between 1 and 4, which is the most Chromium uses for a
+    renderer process. The default value of 0 lets Chromium choose, based on the
+    number of processor cores.
+*/
+
+/*!
+    \variable QWebEngineGlobalSettings::RasterSettings::tileSize
+    \brief The size of the tiles content is rasterized in, in pixels.
+
+    Larger tiles reduce the per-tile overhead of big pages, smaller tiles spread
+    the work of small updates better across threads. An invalid size, the default,
+    lets Chromium choose.
+*/
+
+/*!
+    \variable QWebEngineGlobalSettings::RasterSettings::mode
+    \brief How rasterized tiles are handed to the GPU compositor.
+
+    \sa QWebEngineGlobalSettings::RasterMode
+*/
+
+/*!
+    \fn bool QWebEngineGlobalSettings::setRasterSettings(const RasterSettings &rasterSettings)
+    \since 6.9
+
+    Sets \a rasterSettings for all renderer processes.
+
+    This function has to be called before the web engine is initialized, that is
+    before the first QWebEngineProfile or QWebEnginePage is created. It returns
+    \c false if the web engine has been initialized already, or if
+    \a rasterSettings contains a thread count or tile size out of range.
+
+    Chromium command-line arguments passed through \c QTWEBENGINE_CHROMIUM_FLAGS
+    take precedence over these settings.
+*/
+
+bool QWebEngineGlobalSettings::setRasterSettings(const RasterSettings &rasterSettings)
+{
+    if (QtWebEngineCore::isWebEngineContextInitialized())
+        return false;
+    // Chromium clamps --num-raster-threads to this.
+    if (rasterSettings.threadCount < 0 || rasterSettings.threadCount > 4)
+        return false;
+    if (rasterSettings.tileSize.isValid() && rasterSettings.tileSize.isEmpty())
+        return false;
+    QWebEngineGlobalSettingsPrivate::instance()->rasterSettings = rasterSettings;
+    return true;
+}
+
+/*!
+    \class QWebEngineGlobalSettings::ParallelDownloadSettings
+    \brief The ParallelDownloadSettings struct configures parallel downloading.
+    \since 6.9
+    \inmodule QtWebEngineCore
+
+    With parallel downloading, a download from a server that supports range requests
+    is split into slices that are fetched over several connections at the same time.
+    This mostly speeds up large downloads over links with a high latency.
+
+    Whether a download is split is decided by Chromium when the download starts. It
+    requires the server to announce range support and a strong validator, and the
+    file to be large enough to fill at least two slices.
+
+    \sa QWebEngineProfile::setMaximumDownloadBytesPerSecond()
+*/
+
+/*!
+    \variable QWebEngineGlobalSettings::ParallelDownloadSettings::enabled
+    \brief Whether downloads may be fetched over several connections.
+
+    Parallel downloading is disabled by default.
+*/
+
+/*!
+    \variable QWebEngineGlobalSettings::ParallelDownloadSettings::requestCount
+    \brief The maximum number of connections used for one download.
+
+    The value must be between 2 and 16. The default value of 0 lets Chromium
+    choose.
+*/
+
+/*!
+    \variable QWebEngineGlobalSettings::ParallelDownloadSettings::minimumSliceSize
+    \brief The minimum size of a slice in bytes.
+
+    A download is only split if every connection gets at least this many bytes.
+    The default value of 0 lets Chromium choose.
+*/
+
+/*!
+    \fn bool QWebEngineGlobalSettings::setParallelDownloadSettings(const ParallelDownloadSettings &parallelDownloadSettings)
+    \since 6.9
+
+    Sets \a parallelDownloadSettings for the downloads of all profiles.
+
+    This function has to be called before the web engine is initialized, that is
+    before the first QWebEngineProfile or QWebEnginePage is created. It returns
+    \c false if the web engine has been initialized already, or if
+    \a parallelDownloadSettings contains a request count or slice size out of range.
+
+    Features enabled or disabled with Chromium command-line arguments passed through
+    \c QTWEBENGINE_CHROMIUM_FLAGS take precedence over these settings.
+*/
+
+bool QWebEngineGlobalSettings::setParallelDownloadSettings(
+        const ParallelDownloadSettings &parallelDownloadSettings)
+{
+    if (QtWebEngineCore::isWebEngineContextInitialized())
+        return false;
+    if (parallelDownloadSettings.requestCount != 0
+        && (parallelDownloadSettings.requestCount < 2 || parallelDownloadSettings.requestCount > 16))
+        return false;
+    if (parallelDownloadSettings.minimumSliceSize < 0)
+        return false;
+    QWebEngineGlobalSettingsPrivate::instance()->parallelDownloadSettings = parallelDownloadSettings;
+    return true;
+}
+
 /*!
     \internal
 */
@@ -11,6 +11,7 @@
 #include <QtWebEngineCore/qtwebenginecoreglobal.h>
 #include <QtCore/QObject>
 #include <QtCore/QScopedPointer>
+#include <QtCore/QSize>
 
 QT_BEGIN_NAMESPACE
 
@@ -23,6 +24,29 @@ struct DnsMode
     QStringList serverTemplates;
 };
 Q_WEBENGINECORE_EXPORT bool setDnsMode(DnsMode dnsMode);
+
+// Mapping base::MemoryPressureListener::MemoryPressureLevel
+enum class MemoryPressureLevel : quint8 { None = 0, Moderate = 1, Critical = 2 };
+Q_WEBENGINECORE_EXPORT void notifyMemoryPressure(MemoryPressureLevel level);
+Q_WEBENGINECORE_EXPORT bool setMemoryPressureMonitoringEnabled(bool enabled);
+
+enum class RasterMode : quint8 { Default = 0, ZeroCopy = 1, OneCopy = 2 };
+struct RasterSettings
+{
+    int threadCount = 0;
+    QSize tileSize;
+    RasterMode mode = RasterMode::Default;
+};
+Q_WEBENGINECORE_EXPORT bool setRasterSettings(const RasterSettings &rasterSettings);
+
+struct ParallelDownloadSettings
+{
+    bool enabled = false;
+    int requestCount = 0;
+    qint64 minimumSliceSize = 0;
+};
+Q_WEBENGINECORE_EXPORT bool
+setParallelDownloadSettings(const ParallelDownloadSettings &parallelDownloadSettings);
 }
 
 QT_END_NAMESPACE
@@ -35,6 +35,9 @@ public:
     std::string dnsOverHttpsTemplates;
     const bool insecureDnsClientEnabled;
     const bool additionalInsecureDnsTypesEnabled;
+    bool memoryPressureMonitoringEnabled = false;
+    QWebEngineGlobalSettings::RasterSettings rasterSettings;
+    QWebEngineGlobalSettings::ParallelDownloadSettings parallelDownloadSettings;
 
     void configureStubHostResolver();
 };
@@ -159,7 +159,7 @@ int QWebEngineBackHistoryModelPrivate::offsetForIndex(int index) const
 
 int QWebEngineForwardHistoryModelPrivate::count() const
 {
-    if (!adapter()->isInitialized())
+    if (!adapter()->isInitialized() && !adapter()->hasDeferredNavigationHistory())
         return 0;
     return adapter()->navigationEntryCount() - adapter()->currentNavigationEntryIndex() - 1;
 }
@@ -344,7 +344,7 @@ int QWebEngineHistory::currentItemIndex() const
 int QWebEngineHistory::count() const
 {
     Q_D(const QWebEngineHistory);
-    if (!d->adapter()->isInitialized())
+    if (!d->adapter()->isInitialized() && !d->adapter()->hasDeferredNavigationHistory())
         return 0;
     return d->adapter()->navigationEntryCount();
 }
@@ -24,7 +24,7 @@ public:
     QWebEngineLoadingInfoPrivate(const QUrl& url, LoadStatus status, bool isErrorPage,
                                  const QString& errorString, int errorCode, ErrorDomain errorDomain,
                                  const QMultiMap<QByteArray,QByteArray>& responseHeaders,
-                                 bool isDownload)
+                                 bool isDownload, bool usedSpareRenderProcess)
         : url(url)
         , status(status)
         , isErrorPage(isErrorPage)
@@ -33,6 +33,7 @@ public:
         , errorDomain(errorDomain)
         , responseHeaders(responseHeaders)
         , isDownload(isDownload)
+        , usedSpareRenderProcess(usedSpareRenderProcess)
     {
     }
 
@@ -44,6 +45,7 @@ public:
     ErrorDomain errorDomain;
     QMultiMap<QByteArray,QByteArray> responseHeaders;
     bool isDownload;
+    bool usedSpareRenderProcess;
 };
 
 /*!
@@ -60,9 +62,9 @@ public:
 QWebEngineLoadingInfo::QWebEngineLoadingInfo(const QUrl& url, LoadStatus status, bool isErrorPage,
                                              const QString& errorString, int errorCode, ErrorDomain errorDomain,
                                              const QMultiMap<QByteArray,QByteArray>& responseHeaders,
-                                             bool isDownload)
+                                             bool isDownload, bool usedSpareRenderProcess)
     : d_ptr(new QWebEngineLoadingInfoPrivate(url, status, isErrorPage, errorString, errorCode, errorDomain,
-                                             responseHeaders, isDownload))
+                                             responseHeaders, isDownload, usedSpareRenderProcess))
 {
 }
 
@@ -193,6 +195,23 @@ bool QWebEngineLoadingInfo::isDownload() const
     return d->isDownload;
 }
 
+/*!
+    \property QWebEngineLoadingInfo::usedSpareRenderProcess
+    \since 6.9
+    \brief Indicates if the page was committed to a spare renderer process that was
+           launched in advance, instead of waiting for a new process to start up.
+
+    This is only ever \c true for loads that finished in a profile with spare render
+    processes enabled.
+
+    \sa QWebEngineProfile::setSpareRenderProcessEnabled()
+*/
+bool QWebEngineLoadingInfo::usedSpareRenderProcess() const
+{
+    Q_D(const QWebEngineLoadingInfo);
+    return d->usedSpareRenderProcess;
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qwebengineloadinginfo.cpp"
@@ -29,6 +29,7 @@ class Q_WEBENGINECORE_EXPORT QWebEngineLoadingInfo
     Q_PROPERTY(int errorCode READ errorCode CONSTANT FINAL)
     Q_PROPERTY(QMultiMap<QByteArray,QByteArray> responseHeaders READ responseHeaders CONSTANT REVISION(6,6) FINAL)
     Q_PROPERTY(bool isDownload READ isDownload CONSTANT REVISION(6,9) FINAL)
+    Q_PROPERTY(bool usedSpareRenderProcess READ usedSpareRenderProcess CONSTANT REVISION(6,9) FINAL)
 
 public:
     enum LoadStatus {
@@ -65,13 +66,14 @@ public:
     int errorCode() const;
     QMultiMap<QByteArray,QByteArray> responseHeaders() const;
     bool isDownload() const;
+    bool usedSpareRenderProcess() const;
 
 private:
     QWebEngineLoadingInfo(const QUrl &url, LoadStatus status, bool isErrorPage = false,
                           const QString &errorString = QString(), int errorCode = 0,
                           ErrorDomain errorDomain = NoErrorDomain,
                           const QMultiMap<QByteArray,QByteArray> &responseHeaders = {},
-                          bool isDownload = false);
+                          bool isDownload = false, bool usedSpareRenderProcess = false);
     class QWebEngineLoadingInfoPrivate;
     Q_DECLARE_PRIVATE(QWebEngineLoadingInfo)
     QExplicitlySharedDataPointer<QWebEngineLoadingInfoPrivate> d_ptr;
@@ -31,6 +31,7 @@
 #include "color_chooser_controller.h"
 #include "find_text_helper.h"
 #include "file_picker_controller.h"
+#include "history_restore_scheduler.h"
 #include "javascript_dialog_controller.h"
 #include "profile_adapter.h"
 #include "render_view_context_menu_qt.h"
@@ -43,8 +44,10 @@
 #include <QAction>
 #include <QGuiApplication>
 #include <QAuthenticator>
+#include <QCborValue>
 #include <QClipboard>
 #include <QKeyEvent>
+#include <QIODevice>
 #include <QIcon>
 
 #include <QLoggingCategory>
@@ -275,6 +278,12 @@ void QWebEnginePagePrivate::loadFinished(QWebEngineLoadingInfo info)
     });
 }
 
+void QWebEnginePagePrivate::pageLoadMetricsReported(const QtWebEngineCore::PageLoadMetrics &metrics)
+{
+    Q_Q(QWebEnginePage);
+    Q_EMIT q->pageLoadMetricsReported(QWebEnginePageLoadMetrics(metrics));
+}
+
 void QWebEnginePagePrivate::printToPdf(const QString &filePath, const QPageLayout &layout,
                                        const QPageRanges &ranges, quint64 frameId)
 {
@@ -512,6 +521,14 @@ void QWebEnginePagePrivate::windowCloseRejected()
 
 void QWebEnginePagePrivate::runJavaScript(const QString &script, quint32 worldId, quint64 frameId,
                                           const std::function<void(const QVariant &)> &callback)
+{
+    runJavaScript(script, worldId, frameId, WebContentsAdapter::JavaScriptResultFormat::Variant,
+                  callback);
+}
+
+void QWebEnginePagePrivate::runJavaScript(const QString &script, quint32 worldId, quint64 frameId,
+                                          WebContentsAdapter::JavaScriptResultFormat format,
+                                          const std::function<void(const QVariant &)> &callback)
 {
     ensureInitialized();
     if (adapter->lifecycleState() == WebContentsAdapter::LifecycleState::Discarded) {
@@ -519,7 +536,7 @@ void QWebEnginePagePrivate::runJavaScript(const QString &script, quint32 worldId
         if (callback)
             callback(QVariant());
     } else
-        adapter->runJavaScript(script, worldId, frameId, callback);
+        adapter->runJavaScript(script, worldId, frameId, format, callback);
 }
 
 void QWebEnginePagePrivate::didFetchDocumentMarkup(quint64 requestId, const QString& result)
@@ -807,6 +824,22 @@ void QWebEnginePagePrivate::_q_webActionTriggered(bool checked)
 
 void QWebEnginePagePrivate::recreateFromSerializedHistory(QDataStream &input)
 {
+    const auto policy = profileAdapter()->historyRestorePolicy();
+    if (policy != ProfileAdapter::HistoryRestorePolicy::Immediate && !adapter->isInitialized()) {
+        // Keep only the parsed history until the page is shown or navigated, see ensureInitialized().
+        QSharedPointer<WebContentsAdapter> newWebContents = WebContentsAdapter::createWithDeferredNavigationHistory(input);
+        if (newWebContents) {
+            adapter = std::move(newWebContents);
+            adapter->setClient(this);
+            urlChanged();
+            titleChanged(adapter->pageTitle());
+            updateNavigationActions();
+            if (policy == ProfileAdapter::HistoryRestorePolicy::Background)
+                profileAdapter()->historyRestoreScheduler()->schedule(adapter);
+        }
+        return;
+    }
+
     QSharedPointer<WebContentsAdapter> newWebContents = WebContentsAdapter::createFromSerializedNavigationHistory(input, this);
     if (newWebContents) {
         adapter = std::move(newWebContents);
@@ -1005,6 +1038,20 @@ QWebEnginePage::QWebEnginePage(QObject* parent)
     \note The signal is also emitted when calling the setAudioMuted() method.
 */
 
+/*!
+    \fn void QWebEnginePage::pageLoadMetricsReported(const QWebEnginePageLoadMetrics &metrics)
+    \since 6.9
+
+    This signal is emitted with the timing and layout stability \a metrics of a page load.
+
+    It is emitted when the load event of the main document starts, and once more with
+    QWebEnginePageLoadMetrics::isFinal set when the page is navigated away from, closed, or
+    the application is moved to the background, as some metrics keep changing after the load
+    finished. Pages activated from prerender() are not reported.
+
+    \sa loadingChanged(), QWebEnginePageLoadMetrics
+*/
+
 /*!
   \fn void QWebEnginePage::renderProcessPidChanged(qint64 pid);
   \since 5.15
@@ -1057,6 +1104,7 @@ QWebEnginePage::~QWebEnginePage()
         emit _q_aboutToDelete();
 
         d_ptr->adapter->clearJavaScriptCallbacks();
+        d_ptr->adapter->clearDocumentChunkCallbacks();
         for (auto strFun : std::as_const(d_ptr->m_stringCallbacks))
             strFun(QString());
         d_ptr->m_stringCallbacks.clear();
@@ -1947,6 +1995,29 @@ void QWebEnginePage::download(const QUrl& url, const QString& filename)
     d->adapter->download(url, filename);
 }
 
+/*!
+    \since 6.9
+    Prerenders the page at \a url in the background, so that a later load() of the
+    same URL shows it without waiting for the network or for the page to render.
+
+    The prerendered page runs hidden and with restricted capabilities, for example it
+    cannot open popups or play audio until it is shown. Only a single page is prerendered
+    at a time; calling this function again replaces it. Only \c http and \c https URLs
+    can be prerendered.
+
+    \a resultCallback is called with \c true once a load activated the prerendered page,
+    or with \c false if another page was loaded first, the prerendered page was replaced,
+    or prerendering was not possible.
+
+    \sa QWebEngineProfile::preconnect(), QWebEngineProfile::prefetch()
+*/
+void QWebEnginePage::prerender(const QUrl &url, const std::function<void(bool used)> &resultCallback)
+{
+    Q_D(QWebEnginePage);
+    d->ensureInitialized();
+    d->adapter->prerender(url, resultCallback);
+}
+
 /*!
     \fn void QWebEnginePage::loadingChanged(const QWebEngineLoadingInfo &loadingInfo)
     \since 6.2
@@ -2001,6 +2072,106 @@ void QWebEnginePage::toPlainText(const std::function<void(const QString &)> &res
     d->m_stringCallbacks.insert(requestId, resultCallback);
 }
 
+static std::function<void(QByteArrayView, bool)>
+deviceWriter(QIODevice *device, const std::function<void(bool)> &resultCallback)
+{
+    return [device = QPointer<QIODevice>(device), resultCallback,
+            ok = true](QByteArrayView chunk, bool finished) mutable {
+        if (ok && !chunk.isEmpty())
+            ok = device && device->write(chunk.data(), chunk.size()) == chunk.size();
+        if (finished && resultCallback)
+            resultCallback(ok && !chunk.isNull());
+    };
+}
+
+/*!
+    \since 6.9
+    \overload
+
+    Asynchronously writes the page's content as UTF-8 encoded HTML to \a device.
+
+    Unlike toHtml() with a QString callback, the markup is passed on in chunks as it was
+    received from the render process, without ever being converted to QString. This keeps
+    the memory overhead low for very large documents.
+
+    \a device must be open for writing and must stay alive until \a resultCallback is
+    called. \a resultCallback is called with \c true once all data has been written, or with
+    \c false if writing to \a device failed or the page was deleted in the meantime.
+
+    \sa toHtmlUtf8(), toPlainText()
+*/
+void QWebEnginePage::toHtml(QIODevice *device, const std::function<void(bool)> &resultCallback) const
+{
+    toHtmlUtf8(deviceWriter(device, resultCallback));
+}
+
+/*!
+    \since 6.9
+    \overload
+
+    Asynchronously writes the page's content converted to plain text to \a device, encoded
+    as UTF-8.
+
+    \a device must be open for writing and must stay alive until \a resultCallback is
+    called. \a resultCallback is called with \c true once all data has been written, or with
+    \c false if writing to \a device failed or the page was deleted in the meantime.
+
+    \sa toPlainTextUtf8(), toHtml()
+*/
+void QWebEnginePage::toPlainText(QIODevice *device, const std::function<void(bool)> &resultCallback) const
+{
+    toPlainTextUtf8(deviceWriter(device, resultCallback));
+}
+
+/*!
+    \since 6.9
+
+    Asynchronous method to retrieve the page's content as UTF-8 encoded HTML.
+
+    \a chunkCallback is called one or more times with consecutive parts of the markup in
+    \a chunk. The data referenced by \a chunk is only valid for the duration of the call.
+    \a finished is \c true for the last chunk.
+
+    \warning We guarantee that the callback is always called with \a finished set, but it
+    might be done during page destruction. In that case \a chunk is a null view and it is
+    not safe to use the corresponding QWebEnginePage or QWebEngineView instance inside it.
+
+    \sa toHtml(), toPlainTextUtf8()
+*/
+void QWebEnginePage::toHtmlUtf8(const std::function<void(QByteArrayView, bool)> &chunkCallback) const
+{
+    Q_D(const QWebEnginePage);
+    if (!chunkCallback)
+        return;
+    d->ensureInitialized();
+    d->adapter->fetchDocumentMarkup(chunkCallback);
+}
+
+/*!
+    \since 6.9
+
+    Asynchronous method to retrieve the page's content converted to plain text, encoded
+    as UTF-8.
+
+    \a chunkCallback is called one or more times with consecutive parts of the text in
+    \a chunk. The data referenced by \a chunk is only valid for the duration of the call.
+    \a finished is \c true for the last chunk.
+
+    \warning We guarantee that the callback is always called with \a finished set, but it
+    might be done during page destruction. In that case \a chunk is a null view and it is
+    not safe to use the corresponding QWebEnginePage or QWebEngineView instance inside it.
+
+    \sa toPlainText(), toHtmlUtf8()
+*/
+void QWebEnginePage::toPlainTextUtf8(const std::function<void(QByteArrayView, bool)> &chunkCallback) const
+{
+    Q_D(const QWebEnginePage);
+    if (!chunkCallback)
+        return;
+    d->ensureInitialized();
+    d->adapter->fetchDocumentInnerText(chunkCallback);
+}
+
 void QWebEnginePage::setHtml(const QString &html, const QUrl &baseUrl)
 {
     setContent(html.toUtf8(), QStringLiteral("text/html;charset=UTF-8"), baseUrl);
@@ -2107,6 +2278,151 @@ void QWebEnginePage::runJavaScript(const QString& scriptSource, quint32 worldId,
     d->runJavaScript(scriptSource, worldId, WebContentsAdapter::kUseMainFrameId, resultCallback);
 }
 
+/*!
+    \since 6.9
+
+    Runs the JavaScript code contained in \a scriptSource in the world specified by
+    \a worldId, like runJavaScript(), and passes the result to \a resultCallback serialized
+    as UTF-8 encoded JSON.
+
+    The result is serialized directly from the internal representation without building a
+    QVariant tree first, which is considerably cheaper for large results. Binary values like
+    \c{ArrayBuffer} are omitted. If the result cannot be serialized, or the page is deleted
+    before the script has finished, \a resultCallback is called with a null QByteArray.
+
+    \sa runJavaScript(), runJavaScriptToCbor(), QJsonDocument::fromJson()
+*/
+void QWebEnginePage::runJavaScriptToJson(const QString &scriptSource, quint32 worldId,
+                                         const std::function<void(const QByteArray &)> &resultCallback)
+{
+    Q_D(QWebEnginePage);
+    std::function<void(const QVariant &)> callback;
+    if (resultCallback)
+        callback = [resultCallback](const QVariant &result) { resultCallback(result.toByteArray()); };
+    d->runJavaScript(scriptSource, worldId, WebContentsAdapter::kUseMainFrameId,
+                     WebContentsAdapter::JavaScriptResultFormat::Json, callback);
+}
+
+/*!
+    \since 6.9
+
+    Runs the JavaScript code contained in \a scriptSource in the world specified by
+    \a worldId, like runJavaScript(), and passes the result to \a resultCallback as a
+    QCborValue.
+
+    The QCborValue is built directly from the script result without an intermediate
+    QVariant tree, which is considerably cheaper for large results. Binary values like
+    \c{ArrayBuffer} and typed arrays are represented as byte strings. Use
+    QCborValue::toJsonValue() to obtain a QJsonValue. If the page is deleted before the
+    script has finished, \a resultCallback is called with an undefined value.
+
+    \sa runJavaScript(), runJavaScriptToJson()
+*/
+void QWebEnginePage::runJavaScriptToCbor(const QString &scriptSource, quint32 worldId,
+                                         const std::function<void(const QCborValue &)> &resultCallback)
+{
+    Q_D(QWebEnginePage);
+    std::function<void(const QVariant &)> callback;
+    if (resultCallback)
+        callback = [resultCallback](const QVariant &result) {
+            resultCallback(result.isValid() ? result.value<QCborValue>()
+                                            : QCborValue(QCborSimpleType::Undefined));
+        };
+    d->runJavaScript(scriptSource, worldId, WebContentsAdapter::kUseMainFrameId,
+                     WebContentsAdapter::JavaScriptResultFormat::Cbor, callback);
+}
+
+/*!
+    \since 6.9
+
+    Runs the JavaScript code contained in \a scriptSource in the world specified by
+    \a worldId, like runJavaScript(), and passes the raw bytes of the result to
+    \a resultCallback.
+
+    If the result is an \c{ArrayBuffer} or a typed array, its contents are passed on. If it
+    is a string, its UTF-8 encoding is passed on. For all other results, or if the page is
+    deleted before the script has finished, \a resultCallback is called with a null
+    QByteArray.
+
+    \sa runJavaScript(), runJavaScriptToJson()
+*/
+void QWebEnginePage::runJavaScriptToBinary(const QString &scriptSource, quint32 worldId,
+                                           const std::function<void(const QByteArray &)> &resultCallback)
+{
+    Q_D(QWebEnginePage);
+    std::function<void(const QVariant &)> callback;
+    if (resultCallback)
+        callback = [resultCallback](const QVariant &result) { resultCallback(result.toByteArray()); };
+    d->runJavaScript(scriptSource, worldId, WebContentsAdapter::kUseMainFrameId,
+                     WebContentsAdapter::JavaScriptResultFormat::Binary, callback);
+}
+
+/*!
+    \since 6.9
+
+    Runs the JavaScript code contained in \a scriptSource in the world specified by
+    \a worldId in all frames of the page for which \a frameFilter returns \c true, or in all
+    frames if \a frameFilter is empty.
+
+    The script is sent to all selected frames at once, so frames hosted by different render
+    processes execute it in parallel. Once every frame has replied, \a resultCallback is
+    called a single time with the result of each frame, in document order. The results are
+    converted like the ones of runJavaScript(). Frames that went away before replying have an
+    invalid QVariant as their result.
+
+    For example, to collect the titles of all same-origin frames:
+    \code
+    page.runJavaScriptInFrames("document.title", QWebEngineScript::MainWorld,
+        [origin = page.url().host()](const QWebEngineFrame &frame) {
+            return frame.url().host() == origin;
+        },
+        [](const QList<std::pair<QWebEngineFrame, QVariant>> &results) {
+            for (const auto &[frame, title] : results)
+                qDebug() << frame.name() << title.toString();
+        });
+    \endcode
+
+    \warning We guarantee that \a resultCallback is always called, but it might be done
+    during page destruction. In that case not all results might be available, and it is not
+    safe to use the corresponding QWebEnginePage or QWebEngineView instance inside it.
+
+    \sa runJavaScript(), QWebEngineFrame::runJavaScript()
+*/
+void QWebEnginePage::runJavaScriptInFrames(
+        const QString &scriptSource, quint32 worldId,
+        const std::function<bool(const QWebEngineFrame &)> &frameFilter,
+        const std::function<void(const QList<std::pair<QWebEngineFrame, QVariant>> &)>
+                &resultCallback)
+{
+    Q_D(QWebEnginePage);
+    d->ensureInitialized();
+    if (d->adapter->lifecycleState() == WebContentsAdapter::LifecycleState::Discarded) {
+        qWarning("runJavaScriptInFrames: disabled in Discarded state");
+        if (resultCallback)
+            resultCallback({});
+        return;
+    }
+
+    QWeakPointer<WebContentsAdapter> adapter = d->adapter;
+    std::function<bool(quint64)> filter;
+    if (frameFilter)
+        filter = [adapter, frameFilter](quint64 frameId) {
+            return frameFilter(QWebEngineFrame(adapter, frameId));
+        };
+    std::function<void(const WebContentsAdapter::FrameJavaScriptResults &)> callback;
+    if (resultCallback)
+        callback = [adapter, resultCallback](const WebContentsAdapter::FrameJavaScriptResults &results) {
+            QList<std::pair<QWebEngineFrame, QVariant>> frameResults;
+            frameResults.reserve(results.size());
+            for (const auto &result : results)
+                frameResults.append({ QWebEngineFrame(adapter, result.first), result.second });
+            resultCallback(frameResults);
+        };
+    d->adapter->runJavaScriptInFrames(scriptSource, worldId, filter,
+                                      WebContentsAdapter::JavaScriptResultFormat::Variant,
+                                      callback);
+}
+
 /*!
     Returns the collection of scripts that are injected into the page.
 
@@ -2405,6 +2721,64 @@ void QWebEnginePage::printToPdf(const std::function<void(const QByteArray&)> &re
 #endif
 }
 
+/*!
+    \since 6.9
+    Captures the area \a rect of the page into an image and passes it to \a resultCallback.
+
+    The rectangle is given in CSS pixels, relative to the top-left corner of the viewport.
+    If \a rect is empty, the whole viewport is captured. The size of the image is the size
+    of \a rect multiplied by \a scale, so thumbnails can be produced without scaling the image
+    afterwards.
+
+    The image is copied directly from the compositor, it neither requires the page to be
+    shown in a QWebEngineView nor a visible window, and it also works with the software
+    compositor in offscreen or headless environments. Hidden pages keep painting until the
+    capture is done. If \a rect extends beyond the viewport, the page is temporarily laid out
+    at a size covering \a rect, which for pages shown in a view can be visible briefly.
+    Pages without a view have an empty viewport, so they are always laid out that way.
+
+    A null image is passed to \a resultCallback if the page could not be captured, for
+    example because it has not been loaded yet or its render process terminated.
+    \a resultCallback is always called asynchronously. Captures of the same page run one
+    after the other, in the order they were requested.
+
+    \sa captureFullPage()
+*/
+void QWebEnginePage::capture(const QRect &rect, qreal scale,
+                             const std::function<void(const QImage &)> &resultCallback)
+{
+    Q_D(QWebEnginePage);
+    d->ensureInitialized();
+    d->adapter->capture(rect, scale, [resultCallback](const QImage &image) {
+        if (resultCallback)
+            resultCallback(image);
+    });
+}
+
+/*!
+    \since 6.9
+    Captures the whole page, including the parts outside the viewport, into an image
+    and passes it to \a resultCallback.
+
+    The page is temporarily laid out at \a width CSS pixels, and high enough to fit all
+    of its contents. The size of the image is the size of the page multiplied by \a scale.
+    Captures are limited to 16384 CSS pixels in either direction.
+
+    Otherwise this function behaves like capture().
+
+    \sa capture(), contentsSize()
+*/
+void QWebEnginePage::captureFullPage(int width, qreal scale,
+                                     const std::function<void(const QImage &)> &resultCallback)
+{
+    Q_D(QWebEnginePage);
+    d->ensureInitialized();
+    d->adapter->captureFullPage(width, scale, [resultCallback](const QImage &image) {
+        if (resultCallback)
+            resultCallback(image);
+    });
+}
+
 /*!
     \internal
 */
@@ -2576,7 +2950,7 @@ std::optional<QWebEngineFrame> QWebEnginePage::findFrameByName(QAnyStringView na
 QDataStream &operator<<(QDataStream &stream, const QWebEngineHistory &history)
 {
     auto adapter = history.d_func()->adapter();
-    if (!adapter->isInitialized())
+    if (!adapter->isInitialized() && !adapter->hasDeferredNavigationHistory())
         adapter->loadDefault();
     adapter->serializeNavigationHistory(stream);
     return stream;
@@ -9,9 +9,11 @@
 #include <QtWebEngineCore/qwebenginedownloadrequest.h>
 #include <QtWebEngineCore/qwebenginequotarequest.h>
 #include <QtWebEngineCore/qwebengineframe.h>
+#include <QtWebEngineCore/qwebenginepageloadmetrics.h>
 #include <QtWebEngineCore/qwebenginepermission.h>
 
 #include <QtCore/qanystringview.h>
+#include <QtCore/qbytearrayview.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qurl.h>
 #include <QtGui/qpagelayout.h>
@@ -25,7 +27,10 @@ QT_BEGIN_NAMESPACE
 
 class QAction;
 class QAuthenticator;
+class QCborValue;
 class QContextMenuBuilder;
+class QImage;
+class QIODevice;
 class QRect;
 class QVariant;
 class QWebChannel;
@@ -266,11 +271,16 @@ public:
     void load(const QUrl &url);
     void load(const QWebEngineHttpRequest &request);
     void download(const QUrl &url, const QString &filename = QString());
+    void prerender(const QUrl &url, const std::function<void(bool used)> &resultCallback = {});
     void setHtml(const QString &html, const QUrl &baseUrl = QUrl());
     void setContent(const QByteArray &data, const QString &mimeType = QString(), const QUrl &baseUrl = QUrl());
 
     void toHtml(const std::function<void(const QString &)> &resultCallback) const;
     void toPlainText(const std::function<void(const QString &)> &resultCallback) const;
+    void toHtml(QIODevice *device, const std::function<void(bool)> &resultCallback = {}) const;
+    void toPlainText(QIODevice *device, const std::function<void(bool)> &resultCallback = {}) const;
+    void toHtmlUtf8(const std::function<void(QByteArrayView chunk, bool finished)> &chunkCallback) const;
+    void toPlainTextUtf8(const std::function<void(QByteArrayView chunk, bool finished)> &chunkCallback) const;
 
     QString title() const;
     void setUrl(const QUrl &url);
@@ -287,6 +297,17 @@ public:
 
     void runJavaScript(const QString &scriptSource, const std::function<void(const QVariant &)> &resultCallback);
     void runJavaScript(const QString &scriptSource, quint32 worldId = 0, const std::function<void(const QVariant &)> &resultCallback = {});
+    void runJavaScriptToJson(const QString &scriptSource, quint32 worldId,
+                             const std::function<void(const QByteArray &)> &resultCallback);
+    void runJavaScriptToCbor(const QString &scriptSource, quint32 worldId,
+                             const std::function<void(const QCborValue &)> &resultCallback);
+    void runJavaScriptToBinary(const QString &scriptSource, quint32 worldId,
+                               const std::function<void(const QByteArray &)> &resultCallback);
+    void runJavaScriptInFrames(
+            const QString &scriptSource, quint32 worldId,
+            const std::function<bool(const QWebEngineFrame &)> &frameFilter,
+            const std::function<void(const QList<std::pair<QWebEngineFrame, QVariant>> &)>
+                    &resultCallback);
     QWebEngineScriptCollection &scripts();
     QWebEngineSettings *settings() const;
 
@@ -310,6 +331,9 @@ public:
                     const QPageLayout &layout = QPageLayout(QPageSize(QPageSize::A4), QPageLayout::Portrait, QMarginsF()),
                     const QPageRanges &ranges = {});
 
+    void capture(const QRect &rect, qreal scale, const std::function<void(const QImage &)> &resultCallback);
+    void captureFullPage(int width, qreal scale, const std::function<void(const QImage &)> &resultCallback);
+
     void setInspectedPage(QWebEnginePage *page);
     QWebEnginePage *inspectedPage() const;
     void setDevToolsPage(QWebEnginePage *page);
@@ -336,6 +360,7 @@ Q_SIGNALS:
     void loadProgress(int progress);
     void loadFinished(bool ok);
     void loadingChanged(const QWebEngineLoadingInfo &loadingInfo);
+    void pageLoadMetricsReported(const QWebEnginePageLoadMetrics &metrics);
 
     void linkHovered(const QString &url);
     void selectionChanged();
@@ -18,6 +18,7 @@
 #include "qwebenginepage.h"
 
 #include "qwebenginescriptcollection.h"
+#include "web_contents_adapter.h"
 #include "web_contents_adapter_client.h"
 
 #include <QtCore/qcompilerdetection.h>
@@ -115,6 +116,7 @@ public:
     void loadStarted(QWebEngineLoadingInfo info) override;
     void loadCommitted() override { }
     void loadFinished(QWebEngineLoadingInfo info) override;
+    void pageLoadMetricsReported(const QtWebEngineCore::PageLoadMetrics &metrics) override;
     void focusContainer() override;
     void unhandledKeyEvent(QKeyEvent *event) override;
     QSharedPointer<QtWebEngineCore::WebContentsAdapter>
@@ -134,6 +136,9 @@ public:
     void showColorDialog(QSharedPointer<QtWebEngineCore::ColorChooserController>) override;
     void runJavaScript(const QString &script, quint32 worldId, quint64 frameId,
                        const std::function<void(const QVariant &)> &callback) override;
+    void runJavaScript(const QString &script, quint32 worldId, quint64 frameId,
+                       QtWebEngineCore::WebContentsAdapter::JavaScriptResultFormat format,
+                       const std::function<void(const QVariant &)> &callback);
     void didFetchDocumentMarkup(quint64 requestId, const QString &result) override;
     void didFetchDocumentInnerText(quint64 requestId, const QString &result) override;
     void printToPdf(const QString &filePath, const QPageLayout &layout, const QPageRanges &ranges,
@@ -198,6 +203,7 @@ public:
     void ensureInitialized() const;
 
     static QString actionText(int action);
+    static QWebEnginePagePrivate *get(QWebEnginePage *page) { return page->d_func(); }
 
     QSharedPointer<QtWebEngineCore::WebContentsAdapter> adapter;
     QWebEngineHistory *history;
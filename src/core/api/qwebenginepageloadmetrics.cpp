@@ -0,0 +1,156 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qwebenginepageloadmetrics.h"
+
+#include "web_contents_adapter_client.h"
+
+QT_BEGIN_NAMESPACE
+
+class QWebEnginePageLoadMetricsPrivate : public QSharedData
+{
+public:
+    QtWebEngineCore::PageLoadMetrics metrics;
+};
+
+/*!
+    \class QWebEnginePageLoadMetrics
+    \brief Timing and layout stability metrics of a page load.
+    \inmodule QtWebEngineCore
+    \since 6.9
+
+    Instances are delivered by QWebEnginePage::pageLoadMetricsReported(). The network
+    timings describe the connection used for the main document, the paint timings and
+    timeToFirstByte() are measured from the start of the navigation.
+
+    Durations that are not available, for instance because the connection was reused or
+    the page has not painted yet, are \c -1 milliseconds.
+
+    \sa QWebEnginePage::pageLoadMetricsReported(), QWebEngineLoadingInfo
+*/
+
+/*!
+    Constructs empty metrics, with an empty url() and all durations unavailable.
+*/
+QWebEnginePageLoadMetrics::QWebEnginePageLoadMetrics()
+    : d_ptr(new QWebEnginePageLoadMetricsPrivate)
+{
+}
+
+QWebEnginePageLoadMetrics::QWebEnginePageLoadMetrics(const QtWebEngineCore::PageLoadMetrics &metrics)
+    : d_ptr(new QWebEnginePageLoadMetricsPrivate)
+{
+    d_ptr->metrics = metrics;
+}
+
+QWebEnginePageLoadMetrics::QWebEnginePageLoadMetrics(const QWebEnginePageLoadMetrics &other) = default;
+QWebEnginePageLoadMetrics &QWebEnginePageLoadMetrics::operator=(const QWebEnginePageLoadMetrics &other) = default;
+QWebEnginePageLoadMetrics::QWebEnginePageLoadMetrics(QWebEnginePageLoadMetrics &&other) = default;
+QWebEnginePageLoadMetrics &QWebEnginePageLoadMetrics::operator=(QWebEnginePageLoadMetrics &&other) = default;
+
+QWebEnginePageLoadMetrics::~QWebEnginePageLoadMetrics() { }
+
+/*!
+    \property QWebEnginePageLoadMetrics::url
+    \brief The URL of the page the metrics were collected for.
+*/
+QUrl QWebEnginePageLoadMetrics::url() const
+{
+    return d_ptr->metrics.url;
+}
+
+/*!
+    \property QWebEnginePageLoadMetrics::isFinal
+    \brief Whether the metrics will not be updated anymore.
+
+    The metrics are first reported when the load event of the page starts. As the
+    largest contentful paint and the layout shift score keep changing after that, they are
+    reported once more when the user navigates away, the page is closed, or the
+    application is moved to the background.
+*/
+bool QWebEnginePageLoadMetrics::isFinal() const
+{
+    return d_ptr->metrics.isFinal;
+}
+
+/*!
+    Returns the time spent resolving the host name of the main document.
+*/
+std::chrono::milliseconds QWebEnginePageLoadMetrics::domainLookupDuration() const
+{
+    return std::chrono::milliseconds(d_ptr->metrics.domainLookup);
+}
+
+/*!
+    Returns the time spent establishing the connection for the main document,
+    including the TLS handshake.
+*/
+std::chrono::milliseconds QWebEnginePageLoadMetrics::connectDuration() const
+{
+    return std::chrono::milliseconds(d_ptr->metrics.connect);
+}
+
+/*!
+    Returns the time spent in the TLS handshake for the main document.
+*/
+std::chrono::milliseconds QWebEnginePageLoadMetrics::tlsHandshakeDuration() const
+{
+    return std::chrono::milliseconds(d_ptr->metrics.tlsHandshake);
+}
+
+/*!
+    Returns the time until the first byte of the main document was received.
+*/
+std::chrono::milliseconds QWebEnginePageLoadMetrics::timeToFirstByte() const
+{
+    return std::chrono::milliseconds(d_ptr->metrics.timeToFirstByte);
+}
+
+/*!
+    Returns the time until text or an image was first painted.
+*/
+std::chrono::milliseconds QWebEnginePageLoadMetrics::firstContentfulPaint() const
+{
+    return std::chrono::milliseconds(d_ptr->metrics.firstContentfulPaint);
+}
+
+/*!
+    Returns the time until the largest text block or image in the viewport was painted.
+*/
+std::chrono::milliseconds QWebEnginePageLoadMetrics::largestContentfulPaint() const
+{
+    return std::chrono::milliseconds(d_ptr->metrics.largestContentfulPaint);
+}
+
+/*!
+    Returns the time until the load event of the main document started.
+*/
+std::chrono::milliseconds QWebEnginePageLoadMetrics::loadEventStart() const
+{
+    return std::chrono::milliseconds(d_ptr->metrics.loadEventStart);
+}
+
+/*!
+    Returns the delay between the first user input and the moment the page could
+    start handling it.
+*/
+std::chrono::milliseconds QWebEnginePageLoadMetrics::firstInputDelay() const
+{
+    return std::chrono::milliseconds(d_ptr->metrics.firstInputDelay);
+}
+
+/*!
+    \property QWebEnginePageLoadMetrics::cumulativeLayoutShift
+    \brief The cumulative layout shift score of the page.
+
+    The score sums up unexpected movements of visible content. Lower values indicate
+    a more stable layout.
+*/
+double QWebEnginePageLoadMetrics::cumulativeLayoutShift() const
+{
+    return d_ptr->metrics.cumulativeLayoutShift;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qwebenginepageloadmetrics.cpp"
@@ -0,0 +1,59 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QWEBENGINEPAGELOADMETRICS_H
+#define QWEBENGINEPAGELOADMETRICS_H
+
+#include <QtWebEngineCore/qtwebenginecoreglobal.h>
+
+#include <QtCore/qobject.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qurl.h>
+
+#include <chrono>
+
+namespace QtWebEngineCore {
+struct PageLoadMetrics;
+}
+
+QT_BEGIN_NAMESPACE
+
+class QWebEnginePageLoadMetricsPrivate;
+
+class Q_WEBENGINECORE_EXPORT QWebEnginePageLoadMetrics
+{
+    Q_GADGET
+    Q_PROPERTY(QUrl url READ url CONSTANT FINAL)
+    Q_PROPERTY(bool isFinal READ isFinal CONSTANT FINAL)
+    Q_PROPERTY(double cumulativeLayoutShift READ cumulativeLayoutShift CONSTANT FINAL)
+
+public:
+    QWebEnginePageLoadMetrics();
+    QWebEnginePageLoadMetrics(const QWebEnginePageLoadMetrics &other);
+    QWebEnginePageLoadMetrics &operator=(const QWebEnginePageLoadMetrics &other);
+    QWebEnginePageLoadMetrics(QWebEnginePageLoadMetrics &&other);
+    QWebEnginePageLoadMetrics &operator=(QWebEnginePageLoadMetrics &&other);
+    ~QWebEnginePageLoadMetrics();
+
+    QUrl url() const;
+    bool isFinal() const;
+
+    std::chrono::milliseconds domainLookupDuration() const;
+    std::chrono::milliseconds connectDuration() const;
+    std::chrono::milliseconds tlsHandshakeDuration() const;
+    std::chrono::milliseconds timeToFirstByte() const;
+    std::chrono::milliseconds firstContentfulPaint() const;
+    std::chrono::milliseconds largestContentfulPaint() const;
+    std::chrono::milliseconds loadEventStart() const;
+    std::chrono::milliseconds firstInputDelay() const;
+    double cumulativeLayoutShift() const;
+
+private:
+    explicit QWebEnginePageLoadMetrics(const QtWebEngineCore::PageLoadMetrics &metrics);
+    QExplicitlySharedDataPointer<QWebEnginePageLoadMetricsPrivate> d_ptr;
+    friend class QWebEnginePagePrivate;
+};
+
+QT_END_NAMESPACE
+
+#endif // QWEBENGINEPAGELOADMETRICS_H
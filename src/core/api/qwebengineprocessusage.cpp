@@ -0,0 +1,132 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qwebengineprocessusage.h"
+
+#include "resource_usage_sampler.h"
+#include "web_contents_adapter.h"
+
+QT_BEGIN_NAMESPACE
+
+class QWebEngineProcessUsagePrivate : public QSharedData
+{
+public:
+    qint64 processId = 0;
+    qint64 privateMemoryFootprint = -1;
+    qint64 cpuTime = -1;
+    qint64 gpuMemory = -1;
+    qint64 networkBytesReceived = -1;
+    qint64 networkBytesSent = -1;
+    QList<QWebEngineFrame> frames;
+};
+
+/*!
+    \class QWebEngineProcessUsage
+    \brief A snapshot of the resources used by a web engine renderer process.
+    \inmodule QtWebEngineCore
+    \since 6.9
+
+    Use QWebEngineProfile::requestResourceUsage() to get a snapshot of all renderer
+    processes hosting the pages of a profile. Together with frames(), which lists the pages
+    and frames a process hosts, this can be used to decide which pages to freeze or discard.
+
+    Values that could not be measured on the current platform are \c -1.
+
+    \sa QWebEngineProfile::requestResourceUsage(), QWebEnginePage::lifecycleState
+*/
+
+QWebEngineProcessUsage::QWebEngineProcessUsage(const QtWebEngineCore::ProcessResourceUsage &usage)
+    : d_ptr(new QWebEngineProcessUsagePrivate)
+{
+    d_ptr->processId = usage.pid;
+    d_ptr->privateMemoryFootprint = usage.privateMemoryFootprint;
+    d_ptr->cpuTime = usage.cpuTime;
+    d_ptr->gpuMemory = usage.gpuMemory;
+    d_ptr->networkBytesReceived = usage.networkBytesReceived;
+    d_ptr->networkBytesSent = usage.networkBytesSent;
+    d_ptr->frames.reserve(usage.frames.size());
+    for (const auto &[adapter, frameId] : usage.frames)
+        d_ptr->frames.append(QWebEngineFrame(adapter, frameId));
+}
+
+QWebEngineProcessUsage::QWebEngineProcessUsage(const QWebEngineProcessUsage &other) = default;
+QWebEngineProcessUsage &QWebEngineProcessUsage::operator=(const QWebEngineProcessUsage &other) = default;
+QWebEngineProcessUsage::QWebEngineProcessUsage(QWebEngineProcessUsage &&other) = default;
+QWebEngineProcessUsage &QWebEngineProcessUsage::operator=(QWebEngineProcessUsage &&other) = default;
+
+QWebEngineProcessUsage::~QWebEngineProcessUsage() { }
+
+/*!
+    \property QWebEngineProcessUsage::processId
+    \brief The process id of the renderer process, or \c 0 if the process has not been
+    started yet.
+
+    \sa QWebEnginePage::renderProcessPid()
+*/
+qint64 QWebEngineProcessUsage::processId() const
+{
+    return d_ptr->processId;
+}
+
+/*!
+    \property QWebEngineProcessUsage::privateMemoryFootprint
+    \brief The private memory footprint of the renderer process in bytes.
+
+    This is the memory that would be released if the process was terminated.
+*/
+qint64 QWebEngineProcessUsage::privateMemoryFootprint() const
+{
+    return d_ptr->privateMemoryFootprint;
+}
+
+/*!
+    Returns the CPU time consumed by the renderer process since it was started,
+    or \c -1 if it is not known.
+*/
+std::chrono::microseconds QWebEngineProcessUsage::cpuTime() const
+{
+    return std::chrono::microseconds(d_ptr->cpuTime);
+}
+
+/*!
+    \property QWebEngineProcessUsage::gpuMemory
+    \brief The GPU memory in bytes allocated on behalf of the renderer process.
+*/
+qint64 QWebEngineProcessUsage::gpuMemory() const
+{
+    return d_ptr->gpuMemory;
+}
+
+/*!
+    \property QWebEngineProcessUsage::networkBytesReceived
+    \brief The number of bytes the renderer process received over the network.
+*/
+qint64 QWebEngineProcessUsage::networkBytesReceived() const
+{
+    return d_ptr->networkBytesReceived;
+}
+
+/*!
+    \property QWebEngineProcessUsage::networkBytesSent
+    \brief The number of bytes the renderer process sent over the network.
+*/
+qint64 QWebEngineProcessUsage::networkBytesSent() const
+{
+    return d_ptr->networkBytesSent;
+}
+
+/*!
+    \property QWebEngineProcessUsage::frames
+    \brief The frames hosted by the renderer process at the time of the snapshot.
+
+    The main frames in the list identify the pages that are hosted by the process.
+    Compare them to QWebEnginePage::mainFrame() to find the respective page.
+*/
+QList<QWebEngineFrame> QWebEngineProcessUsage::frames() const
+{
+    return d_ptr->frames;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qwebengineprocessusage.cpp"
@@ -0,0 +1,57 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QWEBENGINEPROCESSUSAGE_H
+#define QWEBENGINEPROCESSUSAGE_H
+
+#include <QtWebEngineCore/qtwebenginecoreglobal.h>
+#include <QtWebEngineCore/qwebengineframe.h>
+
+#include <QtCore/qlist.h>
+#include <QtCore/qobject.h>
+#include <QtCore/qshareddata.h>
+
+#include <chrono>
+
+namespace QtWebEngineCore {
+struct ProcessResourceUsage;
+}
+
+QT_BEGIN_NAMESPACE
+
+class QWebEngineProcessUsagePrivate;
+
+class Q_WEBENGINECORE_EXPORT QWebEngineProcessUsage
+{
+    Q_GADGET
+    Q_PROPERTY(qint64 processId READ processId CONSTANT FINAL)
+    Q_PROPERTY(qint64 privateMemoryFootprint READ privateMemoryFootprint CONSTANT FINAL)
+    Q_PROPERTY(qint64 gpuMemory READ gpuMemory CONSTANT FINAL)
+    Q_PROPERTY(qint64 networkBytesReceived READ networkBytesReceived CONSTANT FINAL)
+    Q_PROPERTY(qint64 networkBytesSent READ networkBytesSent CONSTANT FINAL)
+    Q_PROPERTY(QList<QWebEngineFrame> frames READ frames CONSTANT FINAL)
+
+public:
+    QWebEngineProcessUsage(const QWebEngineProcessUsage &other);
+    QWebEngineProcessUsage &operator=(const QWebEngineProcessUsage &other);
+    QWebEngineProcessUsage(QWebEngineProcessUsage &&other);
+    QWebEngineProcessUsage &operator=(QWebEngineProcessUsage &&other);
+    ~QWebEngineProcessUsage();
+
+    qint64 processId() const;
+    qint64 privateMemoryFootprint() const;
+    std::chrono::microseconds cpuTime() const;
+    qint64 gpuMemory() const;
+    qint64 networkBytesReceived() const;
+    qint64 networkBytesSent() const;
+    QList<QWebEngineFrame> frames() const;
+
+private:
+    explicit QWebEngineProcessUsage(const QtWebEngineCore::ProcessResourceUsage &usage);
+    QExplicitlySharedDataPointer<QWebEngineProcessUsagePrivate> d_ptr;
+    friend class QWebEngineProfile;
+};
+
+QT_END_NAMESPACE
+
+#endif // QWEBENGINEPROCESSUSAGE_H
@@ -8,13 +8,22 @@
 #include "qwebenginedownloadrequest.h"
 #include "qwebenginedownloadrequest_p.h"
 #include "qwebenginenotification.h"
+#include "qwebengineprocessusage.h"
 #include "qwebenginesettings.h"
 #include "qwebenginescriptcollection.h"
 #include "qwebenginescriptcollection_p.h"
 #include "qwebenginepermission_p.h"
 #include "qtwebenginecoreglobal.h"
+#include "download_throttle.h"
+#include "memory_pressure_monitor_qt.h"
+#include "page_lifecycle_manager.h"
+#include "preloading_hints.h"
 #include "profile_adapter.h"
+#include "resource_usage_sampler.h"
+#include "type_conversion.h"
 #include "visited_links_manager_qt.h"
+#include "web_contents_adapter.h"
+#include "web_contents_adapter_client.h"
 #include "web_engine_settings.h"
 
 #include <QFileInfo>
@@ -128,6 +137,32 @@ using QtWebEngineCore::ProfileAdapter;
             and restored from disk. This is the default setting.
 */
 
+/*!
+    \enum QWebEngineProfile::HistoryRestorePolicy
+
+    \since 6.9
+
+    This enum describes when a page whose navigation history is read from a stream with
+    \c{operator>>(QDataStream &, QWebEngineHistory &)} is restored:
+
+    \value  Immediate
+            The page is restored and starts loading its current history entry right away.
+            This is the default setting.
+    \value  OnDemand
+            Only the navigation history is read. The history, the title, and the URL of the
+            page can be queried, but the page itself is restored when it is shown, loaded, or
+            navigated within its history for the first time.
+    \value  Background
+            Works the same way as \c OnDemand, but in addition the pages are restored in the
+            background in the order their histories were read. Only a few of them are loading
+            at any time.
+
+    Pages that were already loaded or shown before their history was read are always restored
+    immediately.
+
+    \sa setHistoryRestorePolicy(), QWebEngineHistory
+*/
+
 void QWebEngineProfilePrivate::showNotification(QSharedPointer<QtWebEngineCore::UserNotificationController> &controller)
 {
     if (m_notificationPresenter) {
@@ -152,6 +187,31 @@ void QWebEngineProfilePrivate::showNotification(QSharedPointer<QtWebEngineCore::
   \sa QWebEngineDownloadRequest, QWebEnginePage::download()
 */
 
+/*!
+  \fn QWebEngineProfile::pageLifecycleStatisticsChanged(int frozenPages, int discardedPages, qint64 reclaimedMemory)
+
+  \since 6.9
+
+  This signal is emitted after automatic lifecycle management changed the state of pages.
+  \a frozenPages and \a discardedPages hold the number of pages of this profile that are
+  currently frozen and discarded. \a reclaimedMemory is the estimated amount of memory in
+  bytes that has been released by discarding pages since lifecycle management was enabled.
+
+  \sa setPageLifecycleManagementEnabled()
+*/
+
+/*!
+  \fn QWebEngineProfile::ready()
+
+  \since 6.9
+
+  This signal is emitted when the persistent preferences and permissions of the profile
+  have been loaded from disk, after the profile has been created or its storage location
+  has changed. Navigations requested before that are started right after this signal.
+
+  \sa isReady()
+*/
+
 /*!
   \fn QWebEngineProfile::clearHttpCacheCompleted()
 
@@ -280,6 +340,19 @@ void QWebEngineProfilePrivate::clearHttpCacheCompleted()
     Q_EMIT q->clearHttpCacheCompleted();
 }
 
+void QWebEngineProfilePrivate::pageLifecycleStatisticsChanged(int frozenPages, int discardedPages,
+                                                              qint64 reclaimedMemory)
+{
+    Q_Q(QWebEngineProfile);
+    Q_EMIT q->pageLifecycleStatisticsChanged(frozenPages, discardedPages, reclaimedMemory);
+}
+
+void QWebEngineProfilePrivate::profileReady()
+{
+    Q_Q(QWebEngineProfile);
+    Q_EMIT q->ready();
+}
+
 void QWebEngineProfilePrivate::addWebContentsAdapterClient(QtWebEngineCore::WebContentsAdapterClient *adapter)
 {
     Q_ASSERT(m_profileAdapter);
@@ -369,6 +442,26 @@ bool QWebEngineProfile::isOffTheRecord() const
     return d->profileAdapter()->isOffTheRecord();
 }
 
+/*!
+    \since 6.9
+
+    Returns \c true if the persistent preferences and permissions of the profile
+    have been loaded.
+
+    The stores are read from disk without blocking the application, so a profile
+    that uses persistent storage is not ready right after it has been created, or
+    after its persistentStoragePath() or storageName() has changed. Pages can be
+    created and loaded in the meantime; navigations are started once the
+    profile becomes ready. Off-the-record profiles are always ready.
+
+    \sa ready()
+*/
+bool QWebEngineProfile::isReady() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->isReady();
+}
+
 /*!
     Returns the path used to store persistent data for the browser and web content.
 
@@ -462,6 +555,443 @@ void QWebEngineProfile::setPushServiceEnabled(bool enable)
     d->profileAdapter()->setPushServiceEnabled(enable);
 }
 
+/*!
+    \since 6.9
+
+    Requests a snapshot of the resource usage of all renderer processes that host pages
+    of this profile. \a resultCallback is called once with the usage of every process
+    after all measurements have been taken. The measurements are sampled concurrently
+    in the background, so this function is cheap enough to be called periodically.
+
+    \note This operation is asynchronous.
+    \sa QWebEngineProcessUsage, setPageLifecycleManagementEnabled()
+*/
+void QWebEngineProfile::requestResourceUsage(
+        const std::function<void(const QList<QWebEngineProcessUsage> &)> &resultCallback) const
+{
+    const Q_D(QWebEngineProfile);
+    if (!resultCallback)
+        return;
+
+    QList<QSharedPointer<QtWebEngineCore::WebContentsAdapter>> pages;
+    for (auto *client : d->profileAdapter()->webContentsAdapterClients()) {
+        if (auto *adapter = client->webContentsAdapter())
+            pages.append(adapter->sharedFromThis());
+    }
+    QtWebEngineCore::ResourceUsageSampler::sample(
+            pages, [resultCallback](const QList<QtWebEngineCore::ProcessResourceUsage> &usages) {
+                QList<QWebEngineProcessUsage> result;
+                result.reserve(usages.size());
+                for (const auto &usage : usages)
+                    result.append(QWebEngineProcessUsage(usage));
+                resultCallback(result);
+            });
+}
+
+/*!
+    \since 6.9
+
+    Notifies the renderer processes hosting pages of this profile about memory pressure
+    of the given \a level.
+
+    Unlike QWebEngineGlobalSettings::notifyMemoryPressure(), this leaves the pages of
+    other profiles and the caches shared by all profiles untouched. This can be used to
+    let pages of a rarely used profile release their memory first.
+
+    \sa QWebEngineGlobalSettings::notifyMemoryPressure()
+*/
+void QWebEngineProfile::notifyMemoryPressure(QWebEngineGlobalSettings::MemoryPressureLevel level)
+{
+    Q_D(QWebEngineProfile);
+    QtWebEngineCore::notifyMemoryPressure(
+            static_cast<base::MemoryPressureListener::MemoryPressureLevel>(level), d->profileAdapter());
+}
+
+/*!
+    \since 6.9
+
+    Resolves the host name of \a url in advance, so that a later load from the same host
+    does not wait for the DNS lookup.
+
+    \a resultCallback is called with \c true once a page of this profile loaded a resource
+    from the host, or with \c false if the lookup failed or no such load happened within a
+    minute. Only \c http and \c https URLs are supported.
+
+    \sa preconnect(), prefetch(), QWebEnginePage::prerender()
+*/
+void QWebEngineProfile::preresolve(const QUrl &url, const std::function<void(bool used)> &resultCallback)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->preloadingHints()->preresolve(QtWebEngineCore::toGurl(url), resultCallback);
+}
+
+/*!
+    \since 6.9
+
+    Opens a connection to the origin of \a url in advance, including the DNS lookup and,
+    for \c https URLs, the TLS handshake.
+
+    \a resultCallback is called once a page of this profile loaded a resource from the
+    origin over the network, with \c true if the load used an already established
+    connection. It is called with \c false if no such load happened within a minute, in
+    which case the connection has likely been closed again. Only \c http and \c https URLs
+    are supported.
+
+    \sa preresolve(), prefetch()
+*/
+void QWebEngineProfile::preconnect(const QUrl &url, const std::function<void(bool used)> &resultCallback)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->preloadingHints()->preconnect(QtWebEngineCore::toGurl(url), resultCallback);
+}
+
+/*!
+    \since 6.9
+
+    Loads the resource at \a url into the HTTP cache in advance, so that a later load of
+    the same resource is served from the cache.
+
+    As the cache is partitioned by site, the resource is only found by pages of the same
+    site as \a url. Responses that are not cacheable, or larger than 10 MB, do not help
+    later loads.
+
+    \a resultCallback is called once a page of this profile loaded the resource, with
+    \c true if it was served from the cache. It is called with \c false if the resource
+    could not be fetched or was not loaded within five minutes. Only \c http and \c https
+    URLs are supported.
+
+    \sa preconnect(), QWebEnginePage::prerender()
+*/
+void QWebEngineProfile::prefetch(const QUrl &url, const std::function<void(bool used)> &resultCallback)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->preloadingHints()->prefetch(QtWebEngineCore::toGurl(url), resultCallback);
+}
+
+/*!
+    \since 6.9
+
+    Returns \c true if a spare renderer process is kept ready for the pages of this profile.
+
+    \sa setSpareRenderProcessEnabled()
+*/
+bool QWebEngineProfile::isSpareRenderProcessEnabled() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->isSpareRenderProcessEnabled();
+}
+
+/*!
+    \since 6.9
+
+    Keeps a spare renderer process launched and initialized for the pages of this profile
+    if \a enabled is \c true.
+
+    Starting a renderer process takes a noticeable amount of time before the first paint
+    of a new page or of a navigation to another site. With a spare process, such a
+    navigation can commit to the waiting process right away. Once the spare process is
+    used, a new one is started in the background.
+
+    Only a single spare process exists at a time, so enabling this for several profiles
+    makes them replace each other's spare process. Whether a load used the spare process
+    is reported by QWebEngineLoadingInfo::usedSpareRenderProcess.
+
+    This is disabled by default.
+*/
+void QWebEngineProfile::setSpareRenderProcessEnabled(bool enabled)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->setSpareRenderProcessEnabled(enabled);
+}
+
+/*!
+    \since 6.9
+
+    Returns \c true if the lifecycle states of the pages of this profile are managed
+    automatically.
+
+    \sa setPageLifecycleManagementEnabled()
+*/
+bool QWebEngineProfile::isPageLifecycleManagementEnabled() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->pageLifecycleManager()->policy().enabled;
+}
+
+/*!
+    \since 6.9
+
+    Enables automatic lifecycle management of the pages of this profile if \a enabled is
+    \c true.
+
+    When enabled, hidden pages are frozen or discarded automatically in least-recently-used
+    order, so that the limits set with setMaximumActivePages(), setPageMemoryBudget(),
+    setPageFreezeTimeout(), and setPageDiscardTimeout() are kept. A page is only moved to a
+    state that its QWebEnginePage::recommendedState allows, so pages that are visible, playing
+    audio, being inspected, or holding unsaved form input are never discarded. Pages return to
+    the active state when they are shown again.
+
+    The pageLifecycleStatisticsChanged() signal is emitted whenever pages were frozen or
+    discarded.
+
+    Lifecycle management is disabled by default.
+
+    \sa QWebEnginePage::lifecycleState
+*/
+void QWebEngineProfile::setPageLifecycleManagementEnabled(bool enabled)
+{
+    Q_D(QWebEngineProfile);
+    auto *manager = d->profileAdapter()->pageLifecycleManager();
+    auto policy = manager->policy();
+    policy.enabled = enabled;
+    manager->setPolicy(policy);
+}
+
+/*!
+    \since 6.9
+
+    Returns the memory budget for the renderer processes of this profile in bytes.
+
+    \sa setPageMemoryBudget()
+*/
+qint64 QWebEngineProfile::pageMemoryBudget() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->pageLifecycleManager()->policy().memoryBudget;
+}
+
+/*!
+    \since 6.9
+
+    Sets the memory budget for the renderer processes of this profile to \a bytes.
+
+    If the private memory footprint of the processes hosting the pages of this profile
+    exceeds the budget, the least recently used hidden pages are discarded until the
+    footprint is within the budget again. The memory of a process that hosts several
+    pages is attributed to them in equal parts.
+
+    A value of \c 0, the default, sets no limit.
+
+    \sa setPageLifecycleManagementEnabled()
+*/
+void QWebEngineProfile::setPageMemoryBudget(qint64 bytes)
+{
+    Q_D(QWebEngineProfile);
+    auto *manager = d->profileAdapter()->pageLifecycleManager();
+    auto policy = manager->policy();
+    policy.memoryBudget = qMax(bytes, qint64(0));
+    manager->setPolicy(policy);
+}
+
+/*!
+    \since 6.9
+
+    Returns the maximum number of pages of this profile that are kept in the active state.
+
+    \sa setMaximumActivePages()
+*/
+int QWebEngineProfile::maximumActivePages() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->pageLifecycleManager()->policy().maximumActivePages;
+}
+
+/*!
+    \since 6.9
+
+    Sets the maximum number of pages of this profile in the active state to \a count.
+    If more pages are active, the least recently used hidden pages are frozen.
+    Visible pages are always active, and count against the limit.
+
+    A value of \c 0, the default, sets no limit.
+
+    \sa setPageLifecycleManagementEnabled()
+*/
+void QWebEngineProfile::setMaximumActivePages(int count)
+{
+    Q_D(QWebEngineProfile);
+    auto *manager = d->profileAdapter()->pageLifecycleManager();
+    auto policy = manager->policy();
+    policy.maximumActivePages = qMax(count, 0);
+    manager->setPolicy(policy);
+}
+
+/*!
+    \since 6.9
+
+    Returns the time after which hidden pages are frozen.
+
+    \sa setPageFreezeTimeout()
+*/
+std::chrono::milliseconds QWebEngineProfile::pageFreezeTimeout() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->pageLifecycleManager()->policy().freezeTimeout;
+}
+
+/*!
+    \since 6.9
+
+    Sets the time after which hidden pages are frozen to \a timeout.
+
+    A value of \c 0, the default, disables freezing idle pages.
+
+    \sa setPageDiscardTimeout(), setPageLifecycleManagementEnabled()
+*/
+void QWebEngineProfile::setPageFreezeTimeout(std::chrono::milliseconds timeout)
+{
+    Q_D(QWebEngineProfile);
+    auto *manager = d->profileAdapter()->pageLifecycleManager();
+    auto policy = manager->policy();
+    policy.freezeTimeout = std::max(timeout, std::chrono::milliseconds(0));
+    manager->setPolicy(policy);
+}
+
+/*!
+    \since 6.9
+
+    Returns the time after which hidden pages are discarded.
+
+    \sa setPageDiscardTimeout()
+*/
+std::chrono::milliseconds QWebEngineProfile::pageDiscardTimeout() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->pageLifecycleManager()->policy().discardTimeout;
+}
+
+/*!
+    \since 6.9
+
+    Sets the time after which hidden pages are discarded to \a timeout. Pages that cannot be
+    discarded safely are frozen instead.
+
+    A value of \c 0, the default, disables discarding idle pages.
+
+    \sa setPageFreezeTimeout(), setPageLifecycleManagementEnabled()
+*/
+void QWebEngineProfile::setPageDiscardTimeout(std::chrono::milliseconds timeout)
+{
+    Q_D(QWebEngineProfile);
+    auto *manager = d->profileAdapter()->pageLifecycleManager();
+    auto policy = manager->policy();
+    policy.discardTimeout = std::max(timeout, std::chrono::milliseconds(0));
+    manager->setPolicy(policy);
+}
+
+/*!
+    \since 6.9
+
+    Returns the policy for restoring the navigation history of pages.
+
+    \sa setHistoryRestorePolicy()
+*/
+QWebEngineProfile::HistoryRestorePolicy QWebEngineProfile::historyRestorePolicy() const
+{
+    const Q_D(QWebEngineProfile);
+    return QWebEngineProfile::HistoryRestorePolicy(d->profileAdapter()->historyRestorePolicy());
+}
+
+/*!
+    \since 6.9
+
+    Sets the policy for restoring the navigation history of pages to \a policy.
+
+    When restoring a session with many pages, \c OnDemand and \c Background avoid
+    creating and loading all of them at startup.
+
+    \sa QWebEngineProfile::HistoryRestorePolicy, historyRestorePolicy()
+*/
+void QWebEngineProfile::setHistoryRestorePolicy(HistoryRestorePolicy policy)
+{
+    Q_D(QWebEngineProfile);
+    d->profileAdapter()->setHistoryRestorePolicy(ProfileAdapter::HistoryRestorePolicy(policy));
+}
+
+/*!
+    \since 6.9
+
+    Returns the maximum combined transfer rate of the downloads of this profile in bytes
+    per second.
+
+    \sa setMaximumDownloadBytesPerSecond(), downloadBytesPerSecond()
+*/
+qint64 QWebEngineProfile::maximumDownloadBytesPerSecond() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->downloadThrottle()->policy().maximumBytesPerSecond;
+}
+
+/*!
+    \since 6.9
+
+    Limits the combined transfer rate of the downloads of this profile to \a bytesPerSecond.
+
+    Downloads over the limit stop reading from the network until the average rate is back
+    within the limit, which leaves bandwidth to the pages of the application. Such
+    downloads are not reported as paused.
+
+    A value of \c 0, the default, does not limit the rate.
+
+    \sa QWebEngineDownloadRequest::maximumBytesPerSecond, setMaximumActiveDownloads()
+*/
+void QWebEngineProfile::setMaximumDownloadBytesPerSecond(qint64 bytesPerSecond)
+{
+    Q_D(QWebEngineProfile);
+    auto *throttle = d->profileAdapter()->downloadThrottle();
+    auto policy = throttle->policy();
+    policy.maximumBytesPerSecond = std::max<qint64>(bytesPerSecond, 0);
+    throttle->setPolicy(policy);
+}
+
+/*!
+    \since 6.9
+
+    Returns the maximum number of downloads of this profile that transfer data at the
+    same time.
+
+    \sa setMaximumActiveDownloads()
+*/
+int QWebEngineProfile::maximumActiveDownloads() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->downloadThrottle()->policy().maximumActiveDownloads;
+}
+
+/*!
+    \since 6.9
+
+    Sets the maximum number of downloads of this profile that transfer data at the same
+    time to \a count. Further downloads wait, in the order they were started, until an
+    earlier download finishes or is paused.
+
+    A value of \c 0, the default, does not limit the number of downloads.
+
+    \sa setMaximumDownloadBytesPerSecond()
+*/
+void QWebEngineProfile::setMaximumActiveDownloads(int count)
+{
+    Q_D(QWebEngineProfile);
+    auto *throttle = d->profileAdapter()->downloadThrottle();
+    auto policy = throttle->policy();
+    policy.maximumActiveDownloads = std::max(count, 0);
+    throttle->setPolicy(policy);
+}
+
+/*!
+    \since 6.9
+
+    Returns the current combined transfer rate of the downloads of this profile in bytes
+    per second.
+
+    \sa QWebEngineDownloadRequest::bytesPerSecond, setMaximumDownloadBytesPerSecond()
+*/
+qint64 QWebEngineProfile::downloadBytesPerSecond() const
+{
+    const Q_D(QWebEngineProfile);
+    return d->profileAdapter()->downloadThrottle()->bytesPerSecond();
+}
+
 /*!
     Returns the path used for caches.
 
@@ -977,6 +1507,31 @@ void QWebEngineProfile::requestIconForIconURL(const QUrl &url, int desiredSizeIn
                                                iconAvailableCallback);
 }
 
+/*!
+ * Requests the icons of all pages in \a urls from the database with a single query, which
+ * is considerably cheaper than calling requestIconForPageURL() for each of them, for example
+ * when populating a history view.
+ *
+ * The stored icons are decoded off the main thread. \a desiredSizeInPixel is applied as in
+ * requestIconForPageURL().
+ *
+ * Once the query has finished, \a iconAvailableCallback is called for every URL in the order
+ * of \a urls, with the same parameters as the callback of requestIconForPageURL().
+ *
+ * \note Icons can't be requested with an off-the-record profile.
+ *
+ * \since 6.9
+ * \sa requestIconForPageURL()
+ */
+void QWebEngineProfile::requestIconsForPageURLs(const QList<QUrl> &urls, int desiredSizeInPixel,
+                                                std::function<void(const QIcon &, const QUrl &, const QUrl &)> iconAvailableCallback) const
+{
+    Q_D(const QWebEngineProfile);
+    d->profileAdapter()->requestIconsForPageURLs(urls, desiredSizeInPixel,
+                                                 settings()->testAttribute(QWebEngineSettings::TouchIconsEnabled),
+                                                 iconAvailableCallback);
+}
+
 /*!
  * Returns a QWebEnginePermission object corresponding to a single permission for the provided \a securityOrigin and
  * \a permissionType. The object may be used to query for the current state of the permission, or to change it. It is not required
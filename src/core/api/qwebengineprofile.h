@@ -5,12 +5,14 @@
 #define QWEBENGINEPROFILE_H
 
 #include <QtWebEngineCore/qtwebenginecoreglobal.h>
+#include <QtWebEngineCore/qwebengineglobalsettings.h>
 #include <QtWebEngineCore/qwebenginepermission.h>
 
 #include <QtCore/qobject.h>
 #include <QtCore/qscopedpointer.h>
 #include <QtCore/qstring.h>
 
+#include <chrono>
 #include <functional>
 #include <memory>
 
@@ -22,6 +24,7 @@ class QWebEngineClientHints;
 class QWebEngineCookieStore;
 class QWebEngineDownloadRequest;
 class QWebEngineNotification;
+class QWebEngineProcessUsage;
 class QWebEngineProfilePrivate;
 class QWebEngineSettings;
 class QWebEngineScriptCollection;
@@ -57,8 +60,16 @@ public:
     };
     Q_ENUM(PersistentPermissionsPolicy)
 
+    enum class HistoryRestorePolicy : quint8 {
+        Immediate = 0,
+        OnDemand,
+        Background,
+    };
+    Q_ENUM(HistoryRestorePolicy)
+
     QString storageName() const;
     bool isOffTheRecord() const;
+    bool isReady() const;
 
     QString persistentStoragePath() const;
     void setPersistentStoragePath(const QString &path);
@@ -114,12 +125,43 @@ public:
     bool isPushServiceEnabled() const;
     void setPushServiceEnabled(bool enabled);
 
+    void requestResourceUsage(const std::function<void(const QList<QWebEngineProcessUsage> &)> &resultCallback) const;
+    void notifyMemoryPressure(QWebEngineGlobalSettings::MemoryPressureLevel level);
+
+    void preresolve(const QUrl &url, const std::function<void(bool used)> &resultCallback = {});
+    void preconnect(const QUrl &url, const std::function<void(bool used)> &resultCallback = {});
+    void prefetch(const QUrl &url, const std::function<void(bool used)> &resultCallback = {});
+
+    bool isSpareRenderProcessEnabled() const;
+    void setSpareRenderProcessEnabled(bool enabled);
+
+    bool isPageLifecycleManagementEnabled() const;
+    void setPageLifecycleManagementEnabled(bool enabled);
+    qint64 pageMemoryBudget() const;
+    void setPageMemoryBudget(qint64 bytes);
+    int maximumActivePages() const;
+    void setMaximumActivePages(int count);
+    std::chrono::milliseconds pageFreezeTimeout() const;
+    void setPageFreezeTimeout(std::chrono::milliseconds timeout);
+    std::chrono::milliseconds pageDiscardTimeout() const;
+    void setPageDiscardTimeout(std::chrono::milliseconds timeout);
+
+    HistoryRestorePolicy historyRestorePolicy() const;
+    void setHistoryRestorePolicy(HistoryRestorePolicy policy);
+
+    qint64 maximumDownloadBytesPerSecond() const;
+    void setMaximumDownloadBytesPerSecond(qint64 bytesPerSecond);
+    int maximumActiveDownloads() const;
+    void setMaximumActiveDownloads(int count);
+    qint64 downloadBytesPerSecond() const;
+
     void setNotificationPresenter(std::function<void(std::unique_ptr<QWebEngineNotification>)> notificationPresenter);
 
     QWebEngineClientCertificateStore *clientCertificateStore();
 
     void requestIconForPageURL(const QUrl &url, int desiredSizeInPixel, std::function<void(const QIcon &, const QUrl &, const QUrl &)> iconAvailableCallback) const;
     void requestIconForIconURL(const QUrl &url, int desiredSizeInPixel, std::function<void(const QIcon &, const QUrl &)> iconAvailableCallback) const;
+    void requestIconsForPageURLs(const QList<QUrl> &urls, int desiredSizeInPixel, std::function<void(const QIcon &, const QUrl &, const QUrl &)> iconAvailableCallback) const;
 
     QWebEnginePermission queryPermission(const QUrl &securityOrigin, QWebEnginePermission::PermissionType permissionType) const;
     QList<QWebEnginePermission> listAllPermissions() const;
@@ -131,6 +173,8 @@ public:
 Q_SIGNALS:
     void downloadRequested(QWebEngineDownloadRequest *download);
     void clearHttpCacheCompleted();
+    void pageLifecycleStatisticsChanged(int frozenPages, int discardedPages, qint64 reclaimedMemory);
+    void ready();
 
 private:
     Q_DISABLE_COPY(QWebEngineProfile)
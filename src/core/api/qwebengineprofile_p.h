@@ -56,6 +56,8 @@ public:
 
     void showNotification(QSharedPointer<QtWebEngineCore::UserNotificationController> &) override;
     void clearHttpCacheCompleted() override;
+    void pageLifecycleStatisticsChanged(int frozenPages, int discardedPages, qint64 reclaimedMemory) override;
+    void profileReady() override;
 
     void addWebContentsAdapterClient(QtWebEngineCore::WebContentsAdapterClient *adapter) override;
     void removeWebContentsAdapterClient(QtWebEngineCore::WebContentsAdapterClient *adapter) override;
@@ -0,0 +1,144 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qwebenginetracing.h"
+
+#include "tracing_session.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \namespace QWebEngineTracing
+    \brief The QWebEngineTracing namespace records Chromium traces at run time.
+    \since 6.9
+    \inmodule QtWebEngineCore
+
+    Traces show what the browser, renderer and GPU processes of the web engine are doing
+    and are the main tool for diagnosing slow loads and jank. Instead of restarting the
+    application with tracing switches, call start() before the operation in question and
+    stop() afterwards:
+
+    \code
+    QWebEngineTracing::start({ { "blink", "cc", "gpu", "v8" }, 16 * 1024 * 1024 });
+    // ...
+    QWebEngineTracing::stop(QStringLiteral("trace.json"), [](bool success) {
+        qDebug() << "Trace written:" << success;
+    });
+    \endcode
+
+    The trace is written in the JSON trace event format, which can be opened in
+    \l{https://ui.perfetto.dev}{Perfetto} or \c{chrome://tracing}.
+
+    Only one tracing session can be active at a time. All functions must be called from the
+    thread the web engine runs on, after the web engine has been initialized.
+*/
+
+/*!
+    \enum QWebEngineTracing::RecordMode
+
+    This enum describes what happens when the trace buffer is full:
+
+    \value RecordContinuously The buffer is used as a ring buffer, the oldest events are
+    overwritten. The trace contains the events recorded right before stop() was called.
+    \value RecordUntilFull Recording stops when the buffer is full. The trace contains the
+    events recorded right after start() was called.
+*/
+
+/*!
+    \class QWebEngineTracing::Config
+    \brief The Config struct describes a tracing session.
+    \inmodule QtWebEngineCore
+    \since 6.9
+
+    \sa QWebEngineTracing::start()
+*/
+
+/*!
+    \variable QWebEngineTracing::Config::categories
+    \brief The trace categories to record.
+
+    Categories can contain wildcards, and are excluded by prefixing them with \c{-}.
+    Categories disabled by default have to be named with their \c{disabled-by-default-}
+    prefix. If the list is empty, the default categories are recorded.
+*/
+
+/*!
+    \variable QWebEngineTracing::Config::bufferSize
+    \brief The size of the trace buffer in bytes.
+
+    If \c 0, Chromium's default buffer size is used.
+*/
+
+/*!
+    \variable QWebEngineTracing::Config::recordMode
+    \brief Whether the buffer is used as a ring buffer.
+
+    The default is RecordMode::RecordContinuously.
+*/
+
+/*!
+    \fn bool QWebEngineTracing::start(const Config &config)
+
+    Starts a tracing session as described by \a config.
+
+    Returns \c false if the web engine has not been initialized or another tracing session,
+    including one started by the \c{--trace-startup} command line switch, is active.
+
+    \sa stop(), isActive()
+*/
+bool QWebEngineTracing::start(const Config &config)
+{
+    const size_t bufferSizeInKb = config.bufferSize > 0 ? size_t(config.bufferSize) / 1024 : 0;
+    return QtWebEngineCore::TracingSession::start(config.categories.join(u',').toStdString(),
+                                                  bufferSizeInKb,
+                                                  config.recordMode == RecordMode::RecordContinuously);
+}
+
+/*!
+    \fn bool QWebEngineTracing::isActive()
+
+    Returns whether a tracing session is active.
+*/
+bool QWebEngineTracing::isActive()
+{
+    return QtWebEngineCore::TracingSession::isActive();
+}
+
+/*!
+    \fn bool QWebEngineTracing::stop(const QString &filePath, const std::function<void(bool)> &resultCallback)
+
+    Stops the active tracing session and writes the trace to the file \a filePath.
+
+    Collecting the trace from all processes and writing the file happens asynchronously,
+    off the application's thread. When it has finished, \a resultCallback is invoked with
+    whether the file was written successfully.
+
+    Returns \c false if no tracing session is active, in which case \a resultCallback is
+    not invoked.
+*/
+bool QWebEngineTracing::stop(const QString &filePath, const std::function<void(bool)> &resultCallback)
+{
+    return QtWebEngineCore::TracingSession::stop(filePath, resultCallback);
+}
+
+/*!
+    \fn bool QWebEngineTracing::stop(QIODevice *device, const std::function<void(bool)> &resultCallback)
+    \overload
+
+    Stops the active tracing session and writes the trace to \a device, which has to be
+    open for writing.
+
+    The trace is written to the device in chunks while it is collected from the
+    processes, from the thread the web engine runs on. When it has finished,
+    \a resultCallback is invoked with whether all data was written successfully. If the
+    device is destroyed before, the remaining data is dropped and the result is \c false.
+
+    Returns \c false if no tracing session is active or \a device is not writable, in which
+    case \a resultCallback is not invoked.
+*/
+bool QWebEngineTracing::stop(QIODevice *device, const std::function<void(bool)> &resultCallback)
+{
+    return QtWebEngineCore::TracingSession::stop(device, resultCallback);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,38 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QWEBENGINETRACING_H
+#define QWEBENGINETRACING_H
+
+#if 0
+#pragma qt_class(QWebEngineTracing)
+#endif
+
+#include <QtWebEngineCore/qtwebenginecoreglobal.h>
+#include <QtCore/qstringlist.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+namespace QWebEngineTracing {
+enum class RecordMode : quint8 { RecordContinuously = 0, RecordUntilFull = 1 };
+struct Config
+{
+    QStringList categories;
+    qsizetype bufferSize = 0;
+    RecordMode recordMode = RecordMode::RecordContinuously;
+};
+Q_WEBENGINECORE_EXPORT bool start(const Config &config = Config());
+Q_WEBENGINECORE_EXPORT bool isActive();
+Q_WEBENGINECORE_EXPORT bool stop(const QString &filePath,
+                                 const std::function<void(bool)> &resultCallback = {});
+Q_WEBENGINECORE_EXPORT bool stop(QIODevice *device,
+                                 const std::function<void(bool)> &resultCallback = {});
+}
+
+QT_END_NAMESPACE
+
+#endif // QWEBENGINETRACING_H
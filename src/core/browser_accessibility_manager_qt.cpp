@@ -89,6 +89,21 @@ void BrowserAccessibilityManagerQt::FireBlinkEvent(ax::mojom::Event event_type,
                                                    BrowserAccessibility *node,
                                                    int action_request_id)
 {
+    if (event_type == ax::mojom::Event::kFocus)
+        setFocusedNode(node);
+    else if (event_type == ax::mojom::Event::kBlur)
+        setFocusedNode(nullptr);
+
+    if (event_type == ax::mojom::Event::kLayoutComplete) {
+        scheduleReleaseOffscreenInterfaces();
+        return;
+    }
+
+    // Interfaces are created on demand, nothing on the Qt side can be interested
+    // in a node it has never asked for, unless it just received the focus.
+    if (event_type != ax::mojom::Event::kFocus && !hasQAccessibleInterface(node))
+        return;
+
     auto *iface = toQAccessibleInterface(node);
 
     switch (event_type) {
@@ -120,8 +135,6 @@ void BrowserAccessibilityManagerQt::FireBlinkEvent(ax::mojom::Event event_type,
     }
     case ax::mojom::Event::kChildrenChanged:
         break;
-    case ax::mojom::Event::kLayoutComplete:
-        break;
     case ax::mojom::Event::kLoadComplete:
         break;
     case ax::mojom::Event::kTextChanged: {
@@ -163,11 +176,16 @@ void BrowserAccessibilityManagerQt::FireGeneratedEvent(ui::AXEventGenerator::Eve
 
     BrowserAccessibility *wrapper = GetFromAXNode(node);
     DCHECK(wrapper);
-    auto *iface = toQAccessibleInterface(wrapper);
 
     switch (event_type) {
+    case ui::AXEventGenerator::Event::SCROLL_HORIZONTAL_POSITION_CHANGED:
+    case ui::AXEventGenerator::Event::SCROLL_VERTICAL_POSITION_CHANGED:
+        scheduleReleaseOffscreenInterfaces();
+        break;
     case ui::AXEventGenerator::Event::VALUE_IN_TEXT_FIELD_CHANGED:
-        if (iface->role() == QAccessible::EditableText) {
+        if (!hasQAccessibleInterface(wrapper))
+            break;
+        if (auto *iface = toQAccessibleInterface(wrapper); iface->role() == QAccessible::EditableText) {
             QAccessibleTextUpdateEvent event(iface, -1, QString(), QString());
             if (event.object())
                 event.setChild(-1);
@@ -179,6 +197,45 @@ void BrowserAccessibilityManagerQt::FireGeneratedEvent(ui::AXEventGenerator::Eve
     }
 }
 
+BrowserAccessibilityManagerQt *BrowserAccessibilityManagerQt::rootManager() const
+{
+    if (BrowserAccessibilityManager *manager = GetManagerForRootFrame())
+        return static_cast<BrowserAccessibilityManagerQt *>(manager);
+    return const_cast<BrowserAccessibilityManagerQt *>(this);
+}
+
+void BrowserAccessibilityManagerQt::setFocusedNode(BrowserAccessibility *node)
+{
+    // Focus is shared by all frames of the page, keep it with the root frame.
+    BrowserAccessibilityManagerQt *root = rootManager();
+    root->m_focusedTreeId = node ? node->manager()->GetTreeID() : ui::AXTreeIDUnknown();
+    root->m_focusedNodeId = node ? node->GetId() : ui::kInvalidAXNodeID;
+}
+
+BrowserAccessibility *BrowserAccessibilityManagerQt::focusedNode() const
+{
+    const BrowserAccessibilityManagerQt *root = rootManager();
+    if (BrowserAccessibilityManager *manager = FromID(root->m_focusedTreeId)) {
+        if (BrowserAccessibility *node = manager->GetFromID(root->m_focusedNodeId))
+            return node;
+    }
+    // No focus event seen yet, or the focused node has since been removed.
+    return GetFocus();
+}
+
+void BrowserAccessibilityManagerQt::scheduleReleaseOffscreenInterfaces()
+{
+    // Restarting the timer coalesces a burst of scroll or layout events into a single walk.
+    m_releaseTimer.Start(FROM_HERE, base::Milliseconds(500), this,
+                         &BrowserAccessibilityManagerQt::releaseOffscreenInterfaces);
+}
+
+void BrowserAccessibilityManagerQt::releaseOffscreenInterfaces()
+{
+    if (BrowserAccessibility *root = GetBrowserAccessibilityRoot())
+        releaseOffscreenQAccessibleInterfaces(root);
+}
+
 #endif // QT_CONFIG(accessibility)
 
 }
@@ -4,6 +4,7 @@
 #ifndef BROWSER_ACCESSIBILITY_MANAGER_QT_H
 #define BROWSER_ACCESSIBILITY_MANAGER_QT_H
 
+#include "base/timer/timer.h"
 #include "content/browser/accessibility/browser_accessibility_manager.h"
 
 #include <QtCore/qtclasshelpermacros.h>
@@ -33,10 +34,22 @@ public:
     QAccessibleInterface *rootParentAccessible();
     bool isValid() const { return m_valid; }
 
+    // The node that received the last focus event in this page, without searching the tree.
+    BrowserAccessibility *focusedNode() const;
+
 private:
+    BrowserAccessibilityManagerQt *rootManager() const;
+    void setFocusedNode(BrowserAccessibility *node);
+    void scheduleReleaseOffscreenInterfaces();
+    void releaseOffscreenInterfaces();
+
     Q_DISABLE_COPY(BrowserAccessibilityManagerQt)
     QtWebEngineCore::WebContentsAccessibilityQt *m_webContentsAccessibility;
     bool m_valid = false;
+    ui::AXTreeID m_focusedTreeId = ui::AXTreeIDUnknown();
+    ui::AXNodeID m_focusedNodeId = ui::kInvalidAXNodeID;
+    // Walks the tree once layout and scrolling have settled, not on every change.
+    base::OneShotTimer m_releaseTimer;
 };
 
 }
@@ -13,6 +13,7 @@
 #if QT_CONFIG(accessibility)
 #include "content/browser/accessibility/browser_accessibility.h"
 #include "ui/accessibility/ax_enums.mojom.h"
+#include "ui/gfx/geometry/point_conversions.h"
 
 #include <QtGui/qaccessible.h>
 
@@ -28,7 +29,16 @@ public:
 
     bool isReady() const;
 
-    QtWebEngineCore::BrowserAccessibilityInterface *interface = nullptr;
+    // The Qt interface is only created and registered once the Qt side asks
+    // for it, large documents would otherwise register every node up front.
+    BrowserAccessibilityInterface *accessibleInterface() const;
+    bool hasAccessibleInterface() const { return m_interface; }
+    void releaseAccessibleInterface();
+    void releaseOffscreenAccessibleInterfaces();
+
+private:
+    friend class BrowserAccessibilityInterface;
+    mutable BrowserAccessibilityInterface *m_interface = nullptr;
 };
 
 class BrowserAccessibilityInterface
@@ -137,14 +147,55 @@ private:
 BrowserAccessibilityQt::BrowserAccessibilityQt(content::BrowserAccessibilityManager *manager,
                                                ui::AXNode *node)
     : content::BrowserAccessibility(manager, node)
-    , interface(new BrowserAccessibilityInterface(this))
 {
 }
 
 BrowserAccessibilityQt::~BrowserAccessibilityQt()
 {
-    if (interface)
-        interface->destroy();
+    if (m_interface)
+        m_interface->destroy();
+}
+
+BrowserAccessibilityInterface *BrowserAccessibilityQt::accessibleInterface() const
+{
+    if (!m_interface)
+        m_interface = new BrowserAccessibilityInterface(const_cast<BrowserAccessibilityQt *>(this));
+    return m_interface;
+}
+
+void BrowserAccessibilityQt::releaseAccessibleInterface()
+{
+    if (!m_interface)
+        return;
+
+    // Interfaces below this one use its object as their parent, release them first.
+    for (size_t i = 0; i < PlatformChildCount(); ++i)
+        static_cast<BrowserAccessibilityQt *>(PlatformGetChild(i))->releaseAccessibleInterface();
+
+    // Assistive technologies may still hold on to the interface, tell them it is gone.
+    QAccessibleEvent event(m_interface, QAccessible::ObjectDestroyed);
+    QAccessible::updateAccessibility(&event);
+
+    QObject *object = m_interface->object();
+    m_interface->destroy();
+    delete object;
+}
+
+void BrowserAccessibilityQt::releaseOffscreenAccessibleInterfaces()
+{
+    content::BrowserAccessibility *focus =
+            static_cast<content::BrowserAccessibilityManagerQt *>(manager())->focusedNode();
+    for (size_t i = 0; i < PlatformChildCount(); ++i) {
+        auto *child = static_cast<BrowserAccessibilityQt *>(PlatformGetChild(i));
+        if (!child->m_interface)
+            continue;
+        // Keep the subtree holding the focus, assistive technologies will return to it.
+        const bool hasFocus = focus && (focus == child || focus->IsDescendantOf(child));
+        if (!hasFocus && child->IsOffscreen())
+            child->releaseAccessibleInterface();
+        else
+            child->releaseOffscreenAccessibleInterfaces();
+    }
 }
 
 bool BrowserAccessibilityQt::isReady() const
@@ -169,7 +220,7 @@ BrowserAccessibilityInterface::BrowserAccessibilityInterface(BrowserAccessibilit
 
 BrowserAccessibilityInterface::~BrowserAccessibilityInterface()
 {
-    q->interface = nullptr;
+    q->m_interface = nullptr;
 }
 
 void BrowserAccessibilityInterface::destroy()
@@ -193,6 +244,23 @@ QObject *BrowserAccessibilityInterface::object() const
 
 QAccessibleInterface *BrowserAccessibilityInterface::childAt(int x, int y) const
 {
+    if (!q->manager() || !q->isReady() || !rect().contains(x, y))
+        return nullptr;
+
+    // Let Chromium find the deepest node from its cached bounds, then walk up to our child.
+    const gfx::Point physicalPoint =
+            gfx::ScaleToRoundedPoint(gfx::Point(x, y), q->manager()->device_scale_factor());
+    content::BrowserAccessibility *hit = q->manager()->CachingAsyncHitTest(physicalPoint);
+    while (hit && hit != q) {
+        content::BrowserAccessibility *hitParent = hit->PlatformGetParent();
+        if (hitParent == q)
+            return toQAccessibleInterface(hit);
+        hit = hitParent;
+    }
+    if (hit == q)
+        return nullptr;
+
+    // The hit landed outside of this subtree, e.g. below an overlapping sibling.
     for (int i = 0; i < childCount(); ++i) {
         QAccessibleInterface *childIface = child(i);
         Q_ASSERT(childIface);
@@ -260,15 +328,11 @@ QAccessibleInterface *BrowserAccessibilityInterface::child(int index) const
 
 QAccessibleInterface *BrowserAccessibilityInterface::focusChild() const
 {
-    if (state().focused)
-        return const_cast<BrowserAccessibilityInterface *>(this);
-
-    for (int i = 0; i < childCount(); ++i) {
-        if (QAccessibleInterface *iface = child(i)->focusChild())
-            return iface;
-    }
-
-    return nullptr;
+    auto *manager = static_cast<content::BrowserAccessibilityManagerQt *>(q->manager());
+    content::BrowserAccessibility *focus = manager ? manager->focusedNode() : nullptr;
+    if (!focus || (focus != q && !focus->IsDescendantOf(q)))
+        return nullptr;
+    return toQAccessibleInterface(focus);
 }
 
 int BrowserAccessibilityInterface::childCount() const
@@ -755,7 +819,7 @@ QAccessible::State BrowserAccessibilityInterface::state() const
 
     if (q->IsOffscreen())
         state.offscreen = true;
-    if (q->manager()->GetFocus() == q)
+    if (static_cast<content::BrowserAccessibilityManagerQt *>(q->manager())->focusedNode() == q)
         state.focused = true;
     if (q->GetBoolAttribute(ax::mojom::BoolAttribute::kBusy))
         state.busy = true;
@@ -1172,12 +1236,22 @@ std::unique_ptr<BrowserAccessibility> BrowserAccessibility::Create(BrowserAccess
 #if QT_CONFIG(accessibility)
 QAccessibleInterface *toQAccessibleInterface(BrowserAccessibility *obj)
 {
-    return static_cast<QtWebEngineCore::BrowserAccessibilityQt *>(obj)->interface;
+    return static_cast<QtWebEngineCore::BrowserAccessibilityQt *>(obj)->accessibleInterface();
 }
 
 const QAccessibleInterface *toQAccessibleInterface(const BrowserAccessibility *obj)
 {
-    return static_cast<const QtWebEngineCore::BrowserAccessibilityQt *>(obj)->interface;
+    return static_cast<const QtWebEngineCore::BrowserAccessibilityQt *>(obj)->accessibleInterface();
+}
+
+bool hasQAccessibleInterface(const BrowserAccessibility *obj)
+{
+    return static_cast<const QtWebEngineCore::BrowserAccessibilityQt *>(obj)->hasAccessibleInterface();
+}
+
+void releaseOffscreenQAccessibleInterfaces(BrowserAccessibility *root)
+{
+    static_cast<QtWebEngineCore::BrowserAccessibilityQt *>(root)->releaseOffscreenAccessibleInterfaces();
 }
 #endif // #if QT_CONFIG(accessibility)
 
@@ -14,6 +14,8 @@ class BrowserAccessibility;
 
 QAccessibleInterface *toQAccessibleInterface(BrowserAccessibility *obj);
 const QAccessibleInterface *toQAccessibleInterface(const BrowserAccessibility *obj);
+bool hasQAccessibleInterface(const BrowserAccessibility *obj);
+void releaseOffscreenQAccessibleInterfaces(BrowserAccessibility *root);
 
 } // namespace content
 #endif // QT_CONFIG(accessibility)
@@ -40,7 +40,7 @@ void BrowserMessageFilterQt::OnAllowStorageAccess(int /*render_frame_id*/,
                                                   int /*storage_type*/,
                                                   bool *allowed)
 {
-    *allowed = m_profileData->canGetCookies(toQt(top_origin_url), toQt(origin_url));
+    *allowed = m_profileData->canGetCookies(top_origin_url, origin_url);
 }
 
 void BrowserMessageFilterQt::OnRequestStorageAccessSync(int render_frame_id,
@@ -97,7 +97,7 @@ void BrowserMessageFilterQt::OnRequestStorageAccess(int /*render_frame_id*/,
                                                     base::OnceCallback<void(bool)> callback)
 {
     DCHECK_CURRENTLY_ON(content::BrowserThread::IO);
-    bool allowed = m_profileData->canGetCookies(toQt(top_origin_url), toQt(origin_url));
+    bool allowed = m_profileData->canGetCookies(top_origin_url, origin_url);
 
     std::move(callback).Run(allowed);
 }
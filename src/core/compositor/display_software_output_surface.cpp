@@ -14,6 +14,9 @@
 #include <QPainter>
 #include <QQuickWindow>
 
+#include <deque>
+#include <vector>
+
 namespace QtWebEngineCore {
 
 class DisplaySoftwareOutputSurface::Device final : public viz::SoftwareOutputDevice,
@@ -25,6 +28,8 @@ public:
 
     // Overridden from viz::SoftwareOutputDevice.
     void Resize(const gfx::Size &sizeInPixels, float devicePixelRatio) override;
+    SkCanvas *BeginPaint(const gfx::Rect &damageRect) override;
+    void EndPaint() override;
     void OnSwapBuffers(SwapBuffersCallback swap_ack_callback, gfx::FrameData data) override;
 
     // Overridden from Compositor.
@@ -36,11 +41,40 @@ public:
     bool requiresAlphaChannel() override;
 
 private:
+    // Chromium paints directly into the pixels of these images, which are then
+    // handed to Qt by reference. A buffer can be painted again once neither the
+    // scene graph nor a pending swap holds a copy of its image any more.
+    struct Buffer
+    {
+        QImage image;
+        sk_sp<SkSurface> surface;
+        quint64 frame = 0; // Number of the last frame painted into it, 0 if none.
+    };
+
+    Buffer *acquireBuffer();
+    void repairBuffer(Buffer *buffer);
+
+    // Damage of the most recent frames, to bring a reused buffer up to date.
+    static constexpr size_t kDamageHistorySize = 4;
+
     mutable QMutex m_mutex;
     float m_devicePixelRatio = 1.0;
     bool m_requiresAlpha;
     scoped_refptr<base::SingleThreadTaskRunner> m_taskRunner;
     SwapBuffersCallback m_swapCompletionCallback;
+
+    // Used on the viz thread only.
+    std::vector<std::unique_ptr<Buffer>> m_buffers;
+    Buffer *m_backBuffer = nullptr;
+    Buffer *m_lastBuffer = nullptr;
+    quint64 m_frameCount = 0;
+    std::deque<gfx::Rect> m_damageHistory;
+
+    // Guarded by m_mutex.
+    QImage m_pendingImage;
+    float m_pendingDevicePixelRatio = 1.0;
+
+    // Used on the Qt side only.
     QImage m_image;
     float m_imageDevicePixelRatio = 1.0;
 };
@@ -62,19 +96,13 @@ void DisplaySoftwareOutputSurface::Device::Resize(const gfx::Size &sizeInPixels,
         return;
     m_devicePixelRatio = devicePixelRatio;
     viewport_pixel_size_ = sizeInPixels;
-    surface_ = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(sizeInPixels.width(), sizeInPixels.height()));
-}
 
-void DisplaySoftwareOutputSurface::Device::OnSwapBuffers(SwapBuffersCallback swap_ack_callback, gfx::FrameData data)
-{
-    { // MEMO don't hold a lock together with an 'observer', as the call from Qt's scene graph may come at the same time
-        QMutexLocker locker(&m_mutex);
-        m_taskRunner = base::SingleThreadTaskRunner::GetCurrentDefault();
-        m_swapCompletionCallback = std::move(swap_ack_callback);
-    }
-
-    if (auto obs = observer())
-        obs->readyToSwap();
+    // Images still shown by Qt stay alive through their own references.
+    m_buffers.clear();
+    m_backBuffer = nullptr;
+    m_lastBuffer = nullptr;
+    m_damageHistory.clear();
+    surface_.reset();
 }
 
 inline QImage::Format imageFormat(SkColorType colorType)
@@ -90,6 +118,91 @@ inline QImage::Format imageFormat(SkColorType colorType)
     }
 }
 
+DisplaySoftwareOutputSurface::Device::Buffer *DisplaySoftwareOutputSurface::Device::acquireBuffer()
+{
+    for (const auto &buffer : m_buffers) {
+        if (buffer.get() != m_lastBuffer && buffer->image.isDetached())
+            return buffer.get();
+    }
+
+    auto buffer = std::make_unique<Buffer>();
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(viewport_pixel_size_.width(),
+                                                        viewport_pixel_size_.height());
+    buffer->image = QImage(toQt(viewport_pixel_size_), imageFormat(info.colorType()));
+    if (buffer->image.isNull())
+        return nullptr;
+    buffer->surface = SkSurfaces::WrapPixels(info, buffer->image.bits(),
+                                             buffer->image.bytesPerLine());
+    if (!buffer->surface)
+        return nullptr;
+    m_buffers.push_back(std::move(buffer));
+    return m_buffers.back().get();
+}
+
+// Chromium only repaints the damaged area, so copy what changed since the
+// buffer was last painted from the most recent frame.
+void DisplaySoftwareOutputSurface::Device::repairBuffer(Buffer *buffer)
+{
+    if (!m_lastBuffer || buffer->frame == m_frameCount)
+        return;
+
+    gfx::Rect staleRect;
+    const quint64 age = m_frameCount - buffer->frame;
+    if (buffer->frame == 0 || age > m_damageHistory.size()) {
+        staleRect = gfx::Rect(viewport_pixel_size_);
+    } else {
+        for (size_t i = m_damageHistory.size() - age; i < m_damageHistory.size(); ++i)
+            staleRect.Union(m_damageHistory[i]);
+    }
+    // The area about to be painted does not need to be copied.
+    if (damage_rect_.Contains(staleRect))
+        return;
+
+    const QRect rect = toQt(staleRect);
+    QPainter painter(&buffer->image);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(rect, m_lastBuffer->image, rect);
+}
+
+SkCanvas *DisplaySoftwareOutputSurface::Device::BeginPaint(const gfx::Rect &damageRect)
+{
+    damage_rect_ = damageRect;
+    m_backBuffer = acquireBuffer();
+    if (!m_backBuffer)
+        return nullptr;
+    repairBuffer(m_backBuffer);
+    surface_ = m_backBuffer->surface;
+    return surface_->getCanvas();
+}
+
+void DisplaySoftwareOutputSurface::Device::EndPaint()
+{
+    if (!m_backBuffer)
+        return;
+    m_backBuffer->frame = ++m_frameCount;
+    m_damageHistory.push_back(damage_rect_);
+    if (m_damageHistory.size() > kDamageHistorySize)
+        m_damageHistory.pop_front();
+    m_lastBuffer = m_backBuffer;
+    m_backBuffer = nullptr;
+}
+
+void DisplaySoftwareOutputSurface::Device::OnSwapBuffers(SwapBuffersCallback swap_ack_callback, gfx::FrameData data)
+{
+    { // MEMO don't hold a lock together with an 'observer', as the call from Qt's scene graph may come at the same time
+        QMutexLocker locker(&m_mutex);
+        m_taskRunner = base::SingleThreadTaskRunner::GetCurrentDefault();
+        m_swapCompletionCallback = std::move(swap_ack_callback);
+        // Shares the pixels, the buffer stays out of rotation until Qt lets go of them.
+        if (m_lastBuffer)
+            m_pendingImage = m_lastBuffer->image;
+        m_pendingDevicePixelRatio = m_devicePixelRatio;
+    }
+
+    if (auto obs = observer())
+        obs->readyToSwap();
+}
+
 void DisplaySoftwareOutputSurface::Device::swapFrame()
 {
     QMutexLocker locker(&m_mutex);
@@ -97,21 +210,10 @@ void DisplaySoftwareOutputSurface::Device::swapFrame()
     if (!m_swapCompletionCallback)
         return;
 
-    SkPixmap skPixmap;
-    surface_->peekPixels(&skPixmap);
-    QImage image(reinterpret_cast<const uchar *>(skPixmap.addr()), viewport_pixel_size_.width(),
-                 viewport_pixel_size_.height(), skPixmap.rowBytes(),
-                 imageFormat(skPixmap.colorType()));
-    if (m_image.size() == image.size()) {
-        QRect damageRect = toQt(damage_rect_);
-        QPainter painter(&m_image);
-        painter.setCompositionMode(QPainter::CompositionMode_Source);
-        painter.drawImage(damageRect, image, damageRect);
-    } else {
-        m_image = image;
-        m_image.detach();
-    }
-    m_imageDevicePixelRatio = m_devicePixelRatio;
+    if (!m_pendingImage.isNull())
+        m_image = std::move(m_pendingImage);
+    m_pendingImage = QImage();
+    m_imageDevicePixelRatio = m_pendingDevicePixelRatio;
     m_taskRunner->PostTask(
             FROM_HERE, base::BindOnce(std::move(m_swapCompletionCallback), toGfx(m_image.size())));
     m_taskRunner.reset();
@@ -4,6 +4,7 @@
 #include "native_skia_output_device.h"
 
 #include "type_conversion.h"
+#include "web_engine_logging.h"
 
 #include "components/viz/common/resources/shared_image_format.h"
 #include "components/viz/common/resources/shared_image_format_utils.h"
@@ -23,8 +24,13 @@
 #include "ui/ozone/public/ozone_platform.h"
 #endif
 
+#include <algorithm>
+
 namespace QtWebEngineCore {
 
+// Debug messages trace every frame, info messages summarize the statistics periodically.
+Q_WEBENGINE_LOGGING_CATEGORY(lcFramePacing, "qt.webengine.compositor.framepacing", QtWarningMsg)
+
 namespace {
 
 // Helper function for moving a GpuFence from a fence handle to a unique_ptr.
@@ -33,6 +39,13 @@ std::unique_ptr<gfx::GpuFence> TakeGpuFence(gfx::GpuFenceHandle fence)
     return fence.is_null() ? nullptr : std::make_unique<gfx::GpuFence>(std::move(fence));
 }
 
+inline bool framePacingEnabled()
+{
+    return lcFramePacing().isDebugEnabled() || lcFramePacing().isInfoEnabled();
+}
+
+constexpr base::TimeDelta kFramePacingReportInterval = base::Seconds(5);
+
 } // namespace
 
 NativeSkiaOutputDevice::NativeSkiaOutputDevice(
@@ -65,6 +78,8 @@ NativeSkiaOutputDevice::NativeSkiaOutputDevice(
 
 NativeSkiaOutputDevice::~NativeSkiaOutputDevice()
 {
+    if (m_framePacing.submitted)
+        m_framePacing.report("final");
     unbind();
 }
 
@@ -95,6 +110,8 @@ void NativeSkiaOutputDevice::Present(const std::optional<gfx::Rect> &update_rect
     {
         QMutexLocker locker(&m_mutex);
         m_backBuffer->createFence();
+        if (framePacingEnabled())
+            m_framePacing.frameSubmitted(m_readyToUpdate);
         m_gpuTaskRunner = base::SingleThreadTaskRunner::GetCurrentDefault();
         std::swap(m_middleBuffer, m_backBuffer);
         m_readyToUpdate = true;
@@ -135,6 +152,8 @@ void NativeSkiaOutputDevice::EndPaint()
 void NativeSkiaOutputDevice::swapFrame()
 {
     QMutexLocker locker(&m_mutex);
+    if (framePacingEnabled() && m_frontBuffer)
+        m_framePacing.frameSwapped(m_readyToUpdate);
     if (m_readyToUpdate) {
         std::swap(m_frontBuffer, m_middleBuffer);
         m_gpuTaskRunner->PostTask(FROM_HERE,
@@ -153,8 +172,14 @@ void NativeSkiaOutputDevice::swapFrame()
 
 void NativeSkiaOutputDevice::waitForTexture()
 {
-    if (m_readyWithTexture)
-        m_frontBuffer->consumeFence();
+    if (!m_readyWithTexture)
+        return;
+
+    m_frontBuffer->consumeFence();
+    if (framePacingEnabled()) {
+        QMutexLocker locker(&m_mutex);
+        m_framePacing.framePresented();
+    }
 }
 
 void NativeSkiaOutputDevice::releaseTexture()
@@ -203,6 +228,66 @@ void NativeSkiaOutputDevice::SwapBuffersFinished()
                       std::move(m_frame));
 }
 
+void NativeSkiaOutputDevice::FramePacing::frameSubmitted(bool replacesPendingFrame)
+{
+    // A pending frame Qt never swapped in is overwritten and will not be shown.
+    if (replacesPendingFrame)
+        ++dropped;
+    ++submitted;
+    pendingSubmitTime = base::TimeTicks::Now();
+}
+
+void NativeSkiaOutputDevice::FramePacing::frameSwapped(bool hasNewFrame)
+{
+    if (!hasNewFrame) {
+        // Qt renders again while Chromium has not delivered anything new.
+        ++repeated;
+        return;
+    }
+    frontSubmitTime = pendingSubmitTime;
+    frontSwapTime = base::TimeTicks::Now();
+    frontPresented = false;
+}
+
+void NativeSkiaOutputDevice::FramePacing::framePresented()
+{
+    if (frontPresented)
+        return;
+    frontPresented = true;
+    ++presented;
+
+    const base::TimeTicks now = base::TimeTicks::Now();
+    const base::TimeDelta latency = now - frontSubmitTime;
+    const auto limit = std::upper_bound(latencyBucketLimits.begin(), latencyBucketLimits.end(),
+                                        latency.InMilliseconds());
+    ++latencyHistogram[limit - latencyBucketLimits.begin()];
+
+    qCDebug(lcFramePacing, "frame %llu: submitted %.3f ms, swapped +%.3f ms, presented +%.3f ms",
+            presented, (frontSubmitTime - base::TimeTicks()).InMillisecondsF(),
+            (frontSwapTime - frontSubmitTime).InMillisecondsF(),
+            (now - frontSwapTime).InMillisecondsF());
+
+    if (lastReportTime.is_null())
+        lastReportTime = now;
+    else if (now - lastReportTime >= kFramePacingReportInterval)
+        report("periodic");
+}
+
+void NativeSkiaOutputDevice::FramePacing::report(const char *reason)
+{
+    QString histogram;
+    for (size_t i = 0; i < latencyHistogram.size(); ++i) {
+        const QString bucket = i < latencyBucketLimits.size()
+                ? QStringLiteral("<%1ms").arg(latencyBucketLimits[i])
+                : QStringLiteral(">=%1ms").arg(latencyBucketLimits.back());
+        histogram += QStringLiteral(" %1:%2").arg(bucket).arg(latencyHistogram[i]);
+    }
+    qCInfo(lcFramePacing, "%s: %llu submitted, %llu presented, %llu dropped, %llu repeated,"
+                          " submit to present latency%s",
+           reason, submitted, presented, dropped, repeated, qPrintable(histogram));
+    lastReportTime = base::TimeTicks::Now();
+}
+
 NativeSkiaOutputDevice::Buffer::Buffer(NativeSkiaOutputDevice *parent)
     : m_parent(parent), m_shape(m_parent->m_shape)
 {
@@ -7,6 +7,7 @@
 #include "compositor.h"
 
 #include "base/task/single_thread_task_runner.h"
+#include "base/time/time.h"
 #include "components/viz/service/display_embedder/skia_output_device.h"
 #include "gpu/command_buffer/service/shared_context_state.h"
 #include "gpu/command_buffer/service/shared_image/shared_image_representation.h"
@@ -14,6 +15,8 @@
 
 #include <QMutex>
 
+#include <array>
+
 #if defined(Q_OS_WIN)
 #include "ui/gl/dc_layer_overlay_image.h"
 #endif
@@ -162,6 +165,31 @@ protected:
 private:
     friend class NativeSkiaOutputDevice::Buffer;
 
+    // Frame pacing statistics, reported through the qt.webengine.compositor.framepacing
+    // logging category. Guarded by m_mutex.
+    struct FramePacing
+    {
+        // Upper bounds in milliseconds of the submit to present latency buckets.
+        static constexpr std::array<int, 6> latencyBucketLimits = { 4, 8, 16, 33, 50, 100 };
+
+        void frameSubmitted(bool replacesPendingFrame);
+        void frameSwapped(bool hasNewFrame);
+        void framePresented();
+        void report(const char *reason);
+
+        base::TimeTicks pendingSubmitTime;
+        base::TimeTicks frontSubmitTime;
+        base::TimeTicks frontSwapTime;
+        bool frontPresented = true;
+        base::TimeTicks lastReportTime;
+
+        quint64 submitted = 0;
+        quint64 presented = 0;
+        quint64 dropped = 0;
+        quint64 repeated = 0;
+        std::array<quint64, latencyBucketLimits.size() + 1> latencyHistogram = {};
+    };
+
     void SwapBuffersFinished();
 
     bool m_requiresAlpha;
@@ -175,6 +203,7 @@ private:
     viz::OutputSurfaceFrame m_frame;
     bool m_readyToUpdate = false;
     scoped_refptr<base::SingleThreadTaskRunner> m_gpuTaskRunner;
+    FramePacing m_framePacing;
 };
 
 } // namespace QtWebEngineCore
@@ -12,6 +12,8 @@
 #include "components/error_page/common/localized_error.h"
 #include "components/navigation_interception/intercept_navigation_throttle.h"
 #include "components/network_hints/browser/simple_network_hints_handler_impl.h"
+#include "components/page_load_metrics/browser/metrics_web_contents_observer.h"
+#include "components/page_load_metrics/common/page_load_metrics.mojom.h"
 #include "components/performance_manager/embedder/performance_manager_lifetime.h"
 #include "components/performance_manager/embedder/performance_manager_registry.h"
 #include "components/performance_manager/public/performance_manager.h"
@@ -514,6 +516,13 @@ void ContentBrowserClientQt::RegisterAssociatedInterfaceBindersForRenderFrameHos
                                                                            std::move(receiver));
             },
             &rfh));
+    associated_registry.AddInterface<page_load_metrics::mojom::PageLoadMetrics>(base::BindRepeating(
+            [](content::RenderFrameHost *render_frame_host,
+               mojo::PendingAssociatedReceiver<page_load_metrics::mojom::PageLoadMetrics> receiver) {
+                page_load_metrics::MetricsWebContentsObserver::BindPageLoadMetrics(std::move(receiver),
+                                                                                   render_frame_host);
+            },
+            &rfh));
 #if BUILDFLAG(ENABLE_PDF) && BUILDFLAG(ENABLE_EXTENSIONS)
     associated_registry.AddInterface<pdf::mojom::PdfHost>(
             base::BindRepeating(
@@ -633,7 +642,7 @@ ContentBrowserClientQt::AllowServiceWorker(const GURL &scope,
         return content::AllowServiceWorkerResult::No();
     // FIXME: Chrome also checks if javascript is enabled here to check if has been disabled since the service worker
     // was started.
-    return static_cast<ProfileQt *>(context)->profileAdapter()->cookieStore()->d_func()->canAccessCookies(toQt(site_for_cookies.first_party_url()), toQt(scope))
+    return static_cast<ProfileQt *>(context)->profileAdapter()->cookieStore()->d_func()->canAccessCookies(site_for_cookies.first_party_url(), scope)
          ? content::AllowServiceWorkerResult::Yes()
          : content::AllowServiceWorkerResult::No();
 }
@@ -648,7 +657,7 @@ void ContentBrowserClientQt::AllowWorkerFileSystem(const GURL &url,
     if (!context || context->ShutdownStarted())
         return std::move(callback).Run(false);
     std::move(callback).Run(
-            static_cast<ProfileQt *>(context)->profileAdapter()->cookieStore()->d_func()->canAccessCookies(toQt(url), toQt(url)));
+            static_cast<ProfileQt *>(context)->profileAdapter()->cookieStore()->d_func()->canAccessCookies(url, url));
 }
 
 
@@ -659,7 +668,7 @@ bool ContentBrowserClientQt::AllowWorkerIndexedDB(const GURL &url,
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
     if (!context || context->ShutdownStarted())
         return false;
-    return static_cast<ProfileQt *>(context)->profileAdapter()->cookieStore()->d_func()->canAccessCookies(toQt(url), toQt(url));
+    return static_cast<ProfileQt *>(context)->profileAdapter()->cookieStore()->d_func()->canAccessCookies(url, url);
 }
 
 static void LaunchURL(const GURL& url,
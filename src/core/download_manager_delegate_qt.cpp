@@ -15,6 +15,8 @@
 #include <QMimeDatabase>
 #include <QStandardPaths>
 
+#include "download_sink.h"
+#include "download_throttle.h"
 #include "profile_adapter_client.h"
 #include "profile_adapter.h"
 #include "profile_qt.h"
@@ -69,20 +71,30 @@ bool DownloadManagerDelegateQt::cancelDownload(quint32 downloadId)
 
 void DownloadManagerDelegateQt::pauseDownload(quint32 downloadId)
 {
-    if (download::DownloadItem *download = findDownloadById(downloadId))
+    download::DownloadItem *download = findDownloadById(downloadId);
+    if (!download)
+        return;
+    // A download held back by the throttle is paused already, only its reported state changes.
+    if (m_profileAdapter->downloadThrottle()->setPausedByUser(downloadId, true))
+        OnDownloadUpdated(download);
+    else
         download->Pause();
 }
 
 void DownloadManagerDelegateQt::resumeDownload(quint32 downloadId)
 {
-    if (download::DownloadItem *download = findDownloadById(downloadId))
+    if (download::DownloadItem *download = findDownloadById(downloadId)) {
+        m_profileAdapter->downloadThrottle()->setPausedByUser(downloadId, false);
         download->Resume(/* user_resume */ true);
+    }
 }
 
 void DownloadManagerDelegateQt::removeDownload(quint32 downloadId)
 {
     if (download::DownloadItem *download = findDownloadById(downloadId))
         download->Remove();
+    m_profileAdapter->downloadThrottle()->downloadRemoved(downloadId);
+    m_sinks.erase(downloadId);
     m_pendingDownloads.erase(downloadId);
     m_pendingSaves.erase(downloadId);
 }
@@ -175,6 +187,7 @@ bool DownloadManagerDelegateQt::DetermineDownloadTarget(download::DownloadItem *
         info.state = item->GetState();
         info.totalBytes = item->GetTotalBytes();
         info.receivedBytes = item->GetReceivedBytes();
+        info.bytesPerSecond = 0;
         info.mimeType = mimeTypeString;
         info.path = suggestedFilePath;
         info.savePageFormat = ProfileAdapterClient::UnknownSavePageFormat;
@@ -290,6 +303,7 @@ void DownloadManagerDelegateQt::ChooseSavePath(content::WebContents *web_content
     info.state = download::DownloadItem::IN_PROGRESS;
     info.totalBytes = -1;
     info.receivedBytes = 0;
+    info.bytesPerSecond = 0;
     info.mimeType = QStringLiteral("application/x-mimearchive");
     info.path = suggestedFilePath;
     info.savePageFormat = suggestedSaveFormat;
@@ -334,8 +348,50 @@ void DownloadManagerDelegateQt::savePackageDownloadCreated(download::DownloadIte
     item->AddObserver(this);
 }
 
+void DownloadManagerDelegateQt::setDownloadSink(quint32 downloadId,
+                                                std::optional<QCryptographicHash::Algorithm> hashAlgorithm,
+                                                QIODevice *device)
+{
+    if (!hashAlgorithm && !device) {
+        m_sinks.erase(downloadId);
+        return;
+    }
+    auto changed = [weakThis = m_weakPtrFactory.GetWeakPtr(), downloadId]() {
+        if (weakThis)
+            weakThis->consumeDownload(downloadId);
+    };
+    m_sinks[downloadId] = std::make_unique<DownloadSink>(hashAlgorithm, device, changed);
+}
+
+void DownloadManagerDelegateQt::consumeDownload(quint32 downloadId)
+{
+    download::DownloadItem *download = findDownloadById(downloadId);
+    const auto it = m_sinks.find(downloadId);
+    if (!download || it == m_sinks.end())
+        return;
+    consumeDownload(download, it->second.get());
+    // The download is only reported as done once all of its data was consumed.
+    if (it->second->isDone())
+        OnDownloadUpdated(download);
+}
+
+void DownloadManagerDelegateQt::consumeDownload(download::DownloadItem *download, DownloadSink *sink)
+{
+    sink->consume(download);
+    m_profileAdapter->downloadThrottle()->setBlocked(download->GetId(), sink->isLagging());
+}
+
 void DownloadManagerDelegateQt::OnDownloadUpdated(download::DownloadItem *download)
 {
+    DownloadThrottle *throttle = m_profileAdapter->downloadThrottle();
+    throttle->downloadUpdated(download);
+
+    const auto sinkIt = m_sinks.find(download->GetId());
+    DownloadSink *sink = sinkIt != m_sinks.end() ? sinkIt->second.get() : nullptr;
+    if (sink)
+        consumeDownload(download, sink);
+    const bool consumed = !sink || sink->isDone();
+
     QList<ProfileAdapterClient*> clients = m_profileAdapter->clients();
     if (!clients.isEmpty()) {
         WebContentsAdapterClient *adapterClient = nullptr;
@@ -347,21 +403,25 @@ void DownloadManagerDelegateQt::OnDownloadUpdated(download::DownloadItem *downlo
         // Chromium doesn't increase download ID when saving page.
         info.id = download->GetId();
         info.url = toQt(download->GetURL());
-        info.state = download->GetState();
+        info.state = download->GetState() == download::DownloadItem::COMPLETE && !consumed
+                ? download::DownloadItem::IN_PROGRESS
+                : download->GetState();
         info.totalBytes = download->GetTotalBytes();
         info.receivedBytes = download->GetReceivedBytes();
+        info.bytesPerSecond = throttle->bytesPerSecond(download);
         info.mimeType = toQt(download->GetMimeType());
         info.path = QString();
         info.savePageFormat = ProfileAdapterClient::UnknownSavePageFormat;
         info.accepted = true;
-        info.paused = download->IsPaused();
-        info.done = download->IsDone();
+        info.paused = download->IsPaused() && !throttle->isHeldBack(download->GetId());
+        info.done = download->IsDone() && consumed;
         info.isSavePageDownload = false; // unused
         info.useDownloadTargetCallback = false; // unused
         info.downloadInterruptReason = download->GetLastReason();
         info.page = adapterClient;
         info.suggestedFileName = toQt(download->GetSuggestedFilename());
         info.startTime = download->GetStartTime().ToTimeT();
+        info.hash = sink ? sink->hash() : QByteArray();
 
         for (ProfileAdapterClient *client : std::as_const(clients)) {
             client->downloadUpdated(info);
@@ -372,6 +432,8 @@ void DownloadManagerDelegateQt::OnDownloadUpdated(download::DownloadItem *downlo
 void DownloadManagerDelegateQt::OnDownloadDestroyed(download::DownloadItem *download)
 {
     download->RemoveObserver(this);
+    m_profileAdapter->downloadThrottle()->downloadRemoved(download->GetId());
+    m_sinks.erase(download->GetId());
     download->Cancel(/* user_cancel */ false);
 }
 
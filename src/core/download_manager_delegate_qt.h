@@ -7,9 +7,12 @@
 #include "content/public/browser/download_manager_delegate.h"
 #include <base/memory/weak_ptr.h>
 
+#include <QCryptographicHash>
 #include <QString>
 #include <QtGlobal>
 #include <map>
+#include <memory>
+#include <optional>
 
 #include "profile_adapter_client.h"
 
@@ -26,7 +29,10 @@ namespace download {
 class DownloadItem;
 }
 
+QT_FORWARD_DECLARE_CLASS(QIODevice)
+
 namespace QtWebEngineCore {
+class DownloadSink;
 class ProfileAdapter;
 
 class DownloadManagerDelegateQt
@@ -57,6 +63,9 @@ public:
 
     void downloadTargetDetermined(quint32 downloadId, bool accepted, const QString &path);
     void savePathDetermined(quint32 downloadId, bool accepted, const QString &path, int format);
+    void setDownloadSink(quint32 downloadId,
+                         std::optional<QCryptographicHash::Algorithm> hashAlgorithm,
+                         QIODevice *device);
 
     // Inherited from content::DownloadItem::Observer
     void OnDownloadUpdated(download::DownloadItem *download) override;
@@ -66,11 +75,14 @@ private:
     void cancelDownload(download::DownloadTargetCallback callback);
     download::DownloadItem *findDownloadById(quint32 downloadId);
     void savePackageDownloadCreated(download::DownloadItem *download);
+    void consumeDownload(quint32 downloadId);
+    void consumeDownload(download::DownloadItem *download, DownloadSink *sink);
     ProfileAdapter *m_profileAdapter;
 
     uint32_t m_currentId;
     std::map<quint32, download::DownloadTargetCallback> m_pendingDownloads;
     std::map<quint32, content::SavePackagePathPickedCallback> m_pendingSaves;
+    std::map<quint32, std::unique_ptr<DownloadSink>> m_sinks;
     base::WeakPtrFactory<DownloadManagerDelegateQt> m_weakPtrFactory;
 };
 
@@ -0,0 +1,223 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "download_sink.h"
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/task/thread_pool.h"
+#include "components/download/public/common/download_item.h"
+
+#include <algorithm>
+
+namespace QtWebEngineCore {
+
+// Data read in one task on the background sequence.
+static constexpr qint64 kMaximumReadBytes = 4 * 1024 * 1024;
+static constexpr qint64 kChunkSize = 256 * 1024;
+// Data the device may buffer before nothing more is passed on to it.
+static constexpr qint64 kMaximumDeviceBufferedBytes = 4 * 1024 * 1024;
+// Data written but not consumed at which the download is held back, and resumed again.
+static constexpr qint64 kMaximumLag = 32 * 1024 * 1024;
+static constexpr qint64 kResumeLag = 8 * 1024 * 1024;
+
+struct DownloadSink::ReadResult
+{
+    qint64 bytes = 0;
+    // Only filled in when there is a device to pass the data on to.
+    QByteArray data;
+    bool failed = false;
+};
+
+// Reads and hashes the file on the background sequence, where it lives.
+class DownloadSink::Reader
+{
+public:
+    Reader(std::optional<QCryptographicHash::Algorithm> hashAlgorithm, bool keepData)
+        : m_keepData(keepData)
+    {
+        if (hashAlgorithm)
+            m_hashState.emplace(*hashAlgorithm);
+    }
+
+    ReadResult read(const base::FilePath &path, qint64 offset, qint64 length, bool complete)
+    {
+        ReadResult result;
+        // The file is renamed when the download completes.
+        if (path != m_path || !m_file.IsValid()) {
+            m_path = path;
+            m_file.Initialize(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+        }
+        QByteArray buffer;
+        if (m_file.IsValid()) {
+            buffer.resize(length);
+            while (result.bytes < length) {
+                const int read = m_file.Read(offset + result.bytes, buffer.data() + result.bytes,
+                                             int(std::min(kChunkSize, length - result.bytes)));
+                if (read <= 0)
+                    break;
+                result.bytes += read;
+            }
+            buffer.truncate(result.bytes);
+        }
+        // Until the download is complete the next update finds the data, for example
+        // after the file was renamed.
+        result.failed = complete && result.bytes < length;
+        if (m_hashState)
+            m_hashState->addData(buffer);
+        if (m_keepData)
+            result.data = std::move(buffer);
+        return result;
+    }
+
+    QByteArray finish(const base::FilePath &path, bool removeFile)
+    {
+        m_file.Close();
+        // Everything was passed on to the device, the file only served as a buffer.
+        if (removeFile)
+            base::DeleteFile(path);
+        return m_hashState ? m_hashState->result() : QByteArray();
+    }
+
+private:
+    const bool m_keepData;
+    std::optional<QCryptographicHash> m_hashState;
+    base::FilePath m_path;
+    base::File m_file;
+};
+
+DownloadSink::DownloadSink(std::optional<QCryptographicHash::Algorithm> hashAlgorithm,
+                           QIODevice *device, std::function<void()> changed)
+    : m_hasDevice(device)
+    , m_device(device)
+    , m_changed(std::move(changed))
+    , m_taskRunner(base::ThreadPool::CreateSequencedTaskRunner(
+              { base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+                base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN }))
+    , m_reader(new Reader(hashAlgorithm, device != nullptr), base::OnTaskRunnerDeleter(m_taskRunner))
+    , m_useDownloadHash(!device && hashAlgorithm == QCryptographicHash::Sha256)
+{
+    if (device) {
+        auto changedCallback = m_changed;
+        m_bytesWrittenConnection =
+                QObject::connect(device, &QIODevice::bytesWritten, [changedCallback]() { changedCallback(); });
+        m_destroyedConnection =
+                QObject::connect(device, &QObject::destroyed, [changedCallback]() { changedCallback(); });
+    }
+}
+
+DownloadSink::~DownloadSink()
+{
+    QObject::disconnect(m_bytesWrittenConnection);
+    QObject::disconnect(m_destroyedConnection);
+}
+
+void DownloadSink::consume(download::DownloadItem *item)
+{
+    if (m_done)
+        return;
+    if (m_failed) {
+        fail(item);
+        return;
+    }
+    const download::DownloadItem::DownloadState state = item->GetState();
+    if (state != download::DownloadItem::COMPLETE && item->IsDone()) {
+        m_done = true;
+        m_lagging = false;
+        return;
+    }
+    // A download resumed without range support starts over, which the device cannot follow.
+    if ((m_hasDevice && !m_device) || item->GetReceivedBytes() < m_offset) {
+        fail(item);
+        return;
+    }
+
+    const bool complete = state == download::DownloadItem::COMPLETE;
+    if (m_useDownloadHash) {
+        if (!complete)
+            return;
+        const std::string &hash = item->GetHash();
+        if (!hash.empty()) {
+            m_hash = QByteArray::fromStdString(hash);
+            m_done = true;
+            return;
+        }
+        // No hash is computed for downloads split into parallel requests.
+        m_useDownloadHash = false;
+    }
+
+    const qint64 lag = item->GetReceivedBytes() - m_offset;
+    m_lagging = lag > (m_lagging ? kResumeLag : kMaximumLag);
+    if (m_reading)
+        return;
+
+    if (complete && m_offset >= item->GetReceivedBytes()) {
+        m_reading = true;
+        m_taskRunner->PostTaskAndReplyWithResult(
+                FROM_HERE,
+                base::BindOnce(&Reader::finish, base::Unretained(m_reader.get()), item->GetFullPath(),
+                               m_hasDevice),
+                base::BindOnce(&DownloadSink::finishDone, m_weakPtrFactory.GetWeakPtr()));
+        return;
+    }
+
+    // Parallel requests fill several slices of the file, only the first one is contiguous.
+    qint64 available = item->GetReceivedBytes();
+    const std::vector<download::DownloadItem::ReceivedSlice> &slices = item->GetReceivedSlices();
+    if (!complete && !slices.empty())
+        available = slices.front().offset == 0 ? slices.front().received_bytes : 0;
+    if (m_offset >= available)
+        return;
+    // Continued once the device has written some of its data.
+    if (m_device && m_device->bytesToWrite() >= kMaximumDeviceBufferedBytes)
+        return;
+
+    m_reading = true;
+    m_taskRunner->PostTaskAndReplyWithResult(
+            FROM_HERE,
+            base::BindOnce(&Reader::read, base::Unretained(m_reader.get()), item->GetFullPath(),
+                           m_offset, std::min(available - m_offset, kMaximumReadBytes), complete),
+            base::BindOnce(&DownloadSink::readDone, m_weakPtrFactory.GetWeakPtr()));
+}
+
+void DownloadSink::readDone(ReadResult result)
+{
+    m_reading = false;
+    if (m_done)
+        return;
+    if (result.failed
+        || (m_device && m_device->write(result.data) != result.data.size())) {
+        m_failed = true;
+        m_changed();
+        return;
+    }
+    m_offset += result.bytes;
+    // If nothing was found, the next update of the download tries again.
+    if (result.bytes > 0 || (m_hasDevice && !m_device))
+        m_changed();
+}
+
+void DownloadSink::finishDone(QByteArray hash)
+{
+    m_reading = false;
+    m_hash = std::move(hash);
+    m_done = true;
+    m_lagging = false;
+    QObject::disconnect(m_bytesWrittenConnection);
+    QObject::disconnect(m_destroyedConnection);
+    m_changed();
+}
+
+void DownloadSink::fail(download::DownloadItem *item)
+{
+    m_done = true;
+    m_lagging = false;
+    m_hash.clear();
+    QObject::disconnect(m_bytesWrittenConnection);
+    QObject::disconnect(m_destroyedConnection);
+    item->Cancel(/* user_cancel */ true);
+}
+
+} // namespace QtWebEngineCore
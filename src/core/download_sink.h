@@ -0,0 +1,96 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef DOWNLOAD_SINK_H
+#define DOWNLOAD_SINK_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/task/sequenced_task_runner.h"
+
+#include <QCryptographicHash>
+#include <QIODevice>
+#include <QPointer>
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace download {
+class DownloadItem;
+}
+
+namespace QtWebEngineCore {
+
+// Consumes the data of a download while Chromium writes it to disk, to hash it and to
+// pass it on to an application provided device. Reading right behind the writer finds
+// the data in the page cache. The file is read and hashed on a background sequence,
+// only the data for the device comes back to the UI thread.
+//
+// With a device the file still grows to the full size of the download, as Chromium
+// can only write downloads to a file. It only serves as a buffer and is removed once
+// the device has received all of it.
+//
+// Chromium computes the SHA-256 hash of a download by itself, which is used when no
+// device is involved and the download was not split into parallel requests.
+class DownloadSink
+{
+public:
+    // The changed callback is run on the UI thread when more data can be consumed,
+    // or when the sink failed or is done.
+    DownloadSink(std::optional<QCryptographicHash::Algorithm> hashAlgorithm, QIODevice *device,
+                 std::function<void()> changed);
+    ~DownloadSink();
+
+    // Starts consuming what has been written since the last call, a bounded amount at a
+    // time, unless data is being read already or the device has too much buffered.
+    void consume(download::DownloadItem *item);
+
+    // All data of the download was consumed, or the download ended without completing.
+    bool isDone() const { return m_done; }
+    // The data written but not yet consumed is too much, so the download should be held back.
+    bool isLagging() const { return m_lagging; }
+    // The hash of the complete download, once it is done.
+    const QByteArray &hash() const { return m_hash; }
+
+private:
+    class Reader;
+    struct ReadResult;
+
+    void readDone(ReadResult result);
+    void finishDone(QByteArray hash);
+    void fail(download::DownloadItem *item);
+
+    const bool m_hasDevice;
+    QPointer<QIODevice> m_device;
+    std::function<void()> m_changed;
+    QMetaObject::Connection m_bytesWrittenConnection;
+    QMetaObject::Connection m_destroyedConnection;
+    scoped_refptr<base::SequencedTaskRunner> m_taskRunner;
+    std::unique_ptr<Reader, base::OnTaskRunnerDeleter> m_reader;
+    bool m_useDownloadHash;
+    qint64 m_offset = 0;
+    bool m_reading = false;
+    bool m_failed = false;
+    bool m_done = false;
+    bool m_lagging = false;
+    QByteArray m_hash;
+    base::WeakPtrFactory<DownloadSink> m_weakPtrFactory { this };
+};
+
+} // namespace QtWebEngineCore
+
+#endif // DOWNLOAD_SINK_H
@@ -0,0 +1,246 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "download_throttle.h"
+
+#include "components/download/public/common/download_item.h"
+#include "content/public/browser/download_manager.h"
+
+#include "profile_adapter.h"
+#include "profile_qt.h"
+
+#include <algorithm>
+
+namespace QtWebEngineCore {
+
+using namespace std::chrono_literals;
+
+static constexpr auto kUpdateInterval = 200ms;
+// Seconds of traffic a download may save up while it receives less than its limit.
+static constexpr double kMaximumBurst = 0.5;
+// Weight of the latest interval in the reported rate.
+static constexpr double kRateSmoothing = 0.3;
+
+DownloadThrottle::DownloadThrottle(ProfileAdapter *profileAdapter)
+    : m_profileAdapter(profileAdapter)
+{
+    m_updateTimer.setInterval(kUpdateInterval);
+    QObject::connect(&m_updateTimer, &QTimer::timeout, [this]() { update(); });
+}
+
+DownloadThrottle::~DownloadThrottle() = default;
+
+void DownloadThrottle::setPolicy(const Policy &policy)
+{
+    m_policy = policy;
+    m_credit = 0;
+    if (hasLimits())
+        startTimer();
+    else
+        update();
+}
+
+qint64 DownloadThrottle::maximumBytesPerSecond(quint32 downloadId) const
+{
+    const auto it = m_downloads.find(downloadId);
+    return it != m_downloads.end() ? it->second.maximumBytesPerSecond : 0;
+}
+
+void DownloadThrottle::setMaximumBytesPerSecond(quint32 downloadId, qint64 bytesPerSecond)
+{
+    Download &download = m_downloads[downloadId];
+    download.maximumBytesPerSecond = std::max<qint64>(bytesPerSecond, 0);
+    download.credit = 0;
+    if (hasLimits())
+        startTimer();
+    else
+        update();
+}
+
+qint64 DownloadThrottle::bytesPerSecond(download::DownloadItem *item) const
+{
+    const auto it = m_downloads.find(item->GetId());
+    // Chromium's own estimate drops to zero whenever a throttled download is paused.
+    if (m_updateTimer.isActive() && it != m_downloads.end())
+        return qRound64(it->second.bytesPerSecond);
+    return item->CurrentSpeed();
+}
+
+qint64 DownloadThrottle::bytesPerSecond() const
+{
+    qint64 total = 0;
+    for (const auto &[id, download] : m_downloads) {
+        if (download::DownloadItem *item = findDownload(id))
+            total += bytesPerSecond(item);
+    }
+    return total;
+}
+
+bool DownloadThrottle::isHeldBack(quint32 downloadId) const
+{
+    const auto it = m_downloads.find(downloadId);
+    return it != m_downloads.end() && it->second.heldBack;
+}
+
+void DownloadThrottle::setBlocked(quint32 downloadId, bool blocked)
+{
+    const auto it = m_downloads.find(downloadId);
+    if (it == m_downloads.end() || it->second.blocked == blocked)
+        return;
+    it->second.blocked = blocked;
+    scheduleUpdate();
+}
+
+void DownloadThrottle::downloadUpdated(download::DownloadItem *item)
+{
+    switch (item->GetState()) {
+    case download::DownloadItem::COMPLETE:
+    case download::DownloadItem::CANCELLED:
+        downloadRemoved(item->GetId());
+        return;
+    case download::DownloadItem::INTERRUPTED:
+        // Keep the limit of the download, it still applies once the download is resumed.
+        if (const auto it = m_downloads.find(item->GetId()); it != m_downloads.end()) {
+            it->second.receivedBytes = -1;
+            it->second.bytesPerSecond = 0;
+            it->second.heldBack = false;
+        }
+        return;
+    default:
+        break;
+    }
+    const auto [it, inserted] = m_downloads.try_emplace(item->GetId());
+    const bool started = it->second.receivedBytes < 0;
+    if (started)
+        it->second.receivedBytes = item->GetReceivedBytes();
+    // Hold a new or resumed download back right away if it is over the limits, rather
+    // than letting it run unthrottled until the next update.
+    if (started && hasLimits())
+        scheduleUpdate();
+}
+
+void DownloadThrottle::downloadRemoved(quint32 downloadId)
+{
+    m_downloads.erase(downloadId);
+    if (m_downloads.empty())
+        m_updateTimer.stop();
+}
+
+bool DownloadThrottle::setPausedByUser(quint32 downloadId, bool paused)
+{
+    const auto it = m_downloads.find(downloadId);
+    if (it == m_downloads.end())
+        return false;
+    Download &download = it->second;
+    download.pausedByUser = paused;
+    if (paused && download.heldBack) {
+        download.heldBack = false;
+        return true;
+    }
+    return false;
+}
+
+bool DownloadThrottle::hasLimits() const
+{
+    if (m_policy.maximumBytesPerSecond > 0 || m_policy.maximumActiveDownloads > 0)
+        return true;
+    return std::any_of(m_downloads.begin(), m_downloads.end(), [](const auto &entry) {
+        return entry.second.maximumBytesPerSecond > 0 || entry.second.blocked;
+    });
+}
+
+void DownloadThrottle::startTimer()
+{
+    if (m_updateTimer.isActive() || m_downloads.empty())
+        return;
+    m_clock.start();
+    m_updateTimer.start();
+}
+
+void DownloadThrottle::scheduleUpdate()
+{
+    // Pausing or resuming reports the download again, so this must not happen from within a report.
+    QTimer::singleShot(0, &m_updateTimer, [this]() {
+        if (hasLimits())
+            startTimer();
+        update();
+    });
+}
+
+void DownloadThrottle::update()
+{
+    const double elapsed = m_clock.isValid()
+            ? std::clamp(m_clock.restart() / 1000.0, 0.001, 1.0)
+            : kUpdateInterval.count() / 1000.0;
+    const bool limited = hasLimits();
+
+    qint64 totalReceived = 0;
+    int inProgress = 0;
+    for (auto it = m_downloads.begin(); it != m_downloads.end();) {
+        download::DownloadItem *item = findDownload(it->first);
+        if (!item || item->GetState() == download::DownloadItem::COMPLETE
+            || item->GetState() == download::DownloadItem::CANCELLED) {
+            it = m_downloads.erase(it);
+            continue;
+        }
+        if (item->GetState() != download::DownloadItem::IN_PROGRESS) {
+            ++it;
+            continue;
+        }
+        ++inProgress;
+        Download &download = it->second;
+        const qint64 receivedBytes = item->GetReceivedBytes();
+        const qint64 received = download.receivedBytes < 0
+                ? 0
+                : std::max<qint64>(receivedBytes - download.receivedBytes, 0);
+        download.receivedBytes = receivedBytes;
+        totalReceived += received;
+        download.bytesPerSecond += kRateSmoothing * (received / elapsed - download.bytesPerSecond);
+        if (download.maximumBytesPerSecond > 0) {
+            const double limit = download.maximumBytesPerSecond;
+            download.credit = std::min(download.credit + limit * elapsed - received,
+                                       limit * kMaximumBurst);
+        }
+        ++it;
+    }
+    if (m_policy.maximumBytesPerSecond > 0) {
+        const double limit = m_policy.maximumBytesPerSecond;
+        m_credit = std::min(m_credit + limit * elapsed - totalReceived, limit * kMaximumBurst);
+    }
+
+    // Pausing or resuming reports the download again, which may add entries but never removes them.
+    int activeDownloads = 0;
+    for (auto &[id, download] : m_downloads) {
+        if (download.pausedByUser)
+            continue;
+        download::DownloadItem *item = findDownload(id);
+        if (item->GetState() != download::DownloadItem::IN_PROGRESS)
+            continue;
+        // Downloads keep their slot while waiting for the rate limits, oldest downloads first.
+        const bool hasSlot = !limited || m_policy.maximumActiveDownloads <= 0
+                || activeDownloads < m_policy.maximumActiveDownloads;
+        if (hasSlot)
+            ++activeDownloads;
+        const bool allowed = !limited
+                || (hasSlot && !download.blocked
+                    && (download.maximumBytesPerSecond <= 0 || download.credit > 0)
+                    && (m_policy.maximumBytesPerSecond <= 0 || m_credit > 0));
+        if (allowed && download.heldBack) {
+            download.heldBack = false;
+            item->Resume(/* user_resume */ true);
+        } else if (!allowed && !download.heldBack && !item->IsPaused()) {
+            download.heldBack = true;
+            item->Pause();
+        }
+    }
+
+    if (!limited || !inProgress)
+        m_updateTimer.stop();
+}
+
+download::DownloadItem *DownloadThrottle::findDownload(quint32 downloadId) const
+{
+    return m_profileAdapter->profile()->GetDownloadManager()->GetDownload(downloadId);
+}
+
+} // namespace QtWebEngineCore
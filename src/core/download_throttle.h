@@ -0,0 +1,100 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef DOWNLOAD_THROTTLE_H
+#define DOWNLOAD_THROTTLE_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include <QElapsedTimer>
+#include <QTimer>
+
+#include <map>
+
+namespace download {
+class DownloadItem;
+}
+
+namespace QtWebEngineCore {
+
+class ProfileAdapter;
+
+// Keeps the downloads of a profile within a rate limit for the whole profile, a rate
+// limit per download, and a maximum number of downloads transferring at the same time.
+// Chromium cannot throttle a download, so a download over its budget is paused, which
+// stops reading from the network and lets flow control slow down the sender, and is
+// resumed once the budget allows more data. Such a download is "held back", which is
+// not reported to the application as being paused.
+class Q_WEBENGINECORE_EXPORT DownloadThrottle
+{
+public:
+    struct Policy {
+        // Limit for the combined rate of all downloads of the profile in bytes per second, 0 for none
+        qint64 maximumBytesPerSecond = 0;
+        // Maximum number of downloads transferring data at the same time, 0 for no limit
+        int maximumActiveDownloads = 0;
+    };
+
+    explicit DownloadThrottle(ProfileAdapter *profileAdapter);
+    ~DownloadThrottle();
+
+    const Policy &policy() const { return m_policy; }
+    void setPolicy(const Policy &policy);
+
+    qint64 maximumBytesPerSecond(quint32 downloadId) const;
+    void setMaximumBytesPerSecond(quint32 downloadId, qint64 bytesPerSecond);
+
+    // Current rate of a download, averaged over the pauses of throttling.
+    qint64 bytesPerSecond(download::DownloadItem *item) const;
+    // Combined current rate of all downloads of the profile.
+    qint64 bytesPerSecond() const;
+
+    bool isHeldBack(quint32 downloadId) const;
+    // Holds a download back regardless of the limits, for example while its data is not consumed.
+    void setBlocked(quint32 downloadId, bool blocked);
+
+    void downloadUpdated(download::DownloadItem *item);
+    void downloadRemoved(quint32 downloadId);
+    // Returns true if the download was held back already, so only its reported state changes.
+    bool setPausedByUser(quint32 downloadId, bool paused);
+
+private:
+    struct Download {
+        qint64 maximumBytesPerSecond = 0;
+        qint64 receivedBytes = -1;
+        double bytesPerSecond = 0;
+        // Bytes the download may still receive, negative while it is over its limit
+        double credit = 0;
+        bool heldBack = false;
+        bool pausedByUser = false;
+        bool blocked = false;
+    };
+
+    bool hasLimits() const;
+    void startTimer();
+    void scheduleUpdate();
+    void update();
+    download::DownloadItem *findDownload(quint32 downloadId) const;
+
+    ProfileAdapter *m_profileAdapter;
+    Policy m_policy;
+    std::map<quint32, Download> m_downloads;
+    double m_credit = 0;
+    QTimer m_updateTimer;
+    QElapsedTimer m_clock;
+};
+
+} // namespace QtWebEngineCore
+
+#endif // DOWNLOAD_THROTTLE_H
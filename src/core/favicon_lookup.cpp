@@ -0,0 +1,149 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "favicon_lookup.h"
+
+#include "components/history/core/browser/history_backend.h"
+#include "components/history/core/browser/history_db_task.h"
+#include "components/history/core/browser/history_service.h"
+
+#include "type_conversion.h"
+
+#include <cstdlib>
+
+namespace QtWebEngineCore {
+
+namespace {
+
+inline int area(const gfx::Size &size)
+{
+    return size.width() * size.height();
+}
+
+// Runs on the history backend sequence.
+QImage decodeBestMatch(const std::vector<favicon_base::FaviconRawBitmapResult> &bitmaps,
+                       int desiredSizeInPixel, GURL *iconUrl)
+{
+    const favicon_base::FaviconRawBitmapResult *best = nullptr;
+    const int desiredArea = desiredSizeInPixel * desiredSizeInPixel;
+    for (const auto &bitmap : bitmaps) {
+        if (!bitmap.is_valid())
+            continue;
+        if (!best) {
+            best = &bitmap;
+            continue;
+        }
+        const int bestDistance = std::abs(area(best->pixel_size) - desiredArea);
+        const int distance = std::abs(area(bitmap.pixel_size) - desiredArea);
+        if (desiredSizeInPixel ? distance < bestDistance
+                               : area(bitmap.pixel_size) > area(best->pixel_size))
+            best = &bitmap;
+    }
+    if (!best)
+        return QImage();
+
+    QImage image;
+    if (!image.loadFromData(best->bitmap_data->data(), best->bitmap_data->size(), "PNG"))
+        return QImage();
+    *iconUrl = best->icon_url;
+
+    const QSize desiredSize(desiredSizeInPixel, desiredSizeInPixel);
+    if (desiredSizeInPixel && image.size() != desiredSize)
+        image = image.scaled(desiredSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    return image;
+}
+
+class FaviconLookupTask : public history::HistoryDBTask
+{
+public:
+    enum Kind { PageUrls, IconUrl };
+
+    FaviconLookupTask(Kind kind, const QList<QUrl> &urls, const favicon_base::IconTypeSet &iconTypes,
+                      int desiredSizeInPixel, FaviconLookupCallback callback)
+        : m_kind(kind)
+        , m_urls(urls)
+        , m_iconTypes(iconTypes)
+        , m_desiredSizeInPixel(desiredSizeInPixel)
+        , m_callback(std::move(callback))
+    {
+        m_lookupUrls.reserve(urls.size());
+        for (const QUrl &url : urls)
+            m_lookupUrls.push_back(toGurl(url));
+    }
+
+    // history::HistoryDBTask overrides:
+    bool RunOnDBThread(history::HistoryBackend *backend, history::HistoryDatabase *) override
+    {
+        const std::vector<int> desiredSizes = { m_desiredSizeInPixel };
+        m_iconUrls.resize(m_lookupUrls.size());
+        m_images.resize(m_lookupUrls.size());
+        for (size_t i = 0; i < m_lookupUrls.size(); ++i) {
+            if (m_kind == PageUrls) {
+                m_images[i] = decodeBestMatch(
+                        backend->GetFaviconsForURL(m_lookupUrls[i], m_iconTypes, desiredSizes,
+                                                   true /* fallback_to_host */),
+                        m_desiredSizeInPixel, &m_iconUrls[i]);
+                continue;
+            }
+            for (favicon_base::IconType iconType : m_iconTypes) {
+                m_images[i] = decodeBestMatch(
+                        backend->GetFavicon(m_lookupUrls[i], iconType, desiredSizes),
+                        m_desiredSizeInPixel, &m_iconUrls[i]);
+                if (!m_images[i].isNull())
+                    break;
+            }
+        }
+        return true;
+    }
+
+    void DoneRunOnMainThread() override
+    {
+        std::vector<FaviconLookupResult> results;
+        results.reserve(m_urls.size());
+        for (qsizetype i = 0; i < m_urls.size(); ++i) {
+            if (m_kind == PageUrls)
+                results.push_back({ m_urls.at(i), toQt(m_iconUrls[i]), std::move(m_images[i]) });
+            else
+                results.push_back({ QUrl(), m_urls.at(i), std::move(m_images[i]) });
+        }
+        std::move(m_callback).Run(std::move(results));
+    }
+
+private:
+    const Kind m_kind;
+    const QList<QUrl> m_urls;
+    std::vector<GURL> m_lookupUrls;
+    const favicon_base::IconTypeSet m_iconTypes;
+    const int m_desiredSizeInPixel;
+    FaviconLookupCallback m_callback;
+
+    // Written on the history backend sequence.
+    std::vector<GURL> m_iconUrls;
+    std::vector<QImage> m_images;
+};
+
+} // namespace
+
+void lookupFaviconsForPageUrls(history::HistoryService *service, const QList<QUrl> &pageUrls,
+                               const favicon_base::IconTypeSet &iconTypes, int desiredSizeInPixel,
+                               FaviconLookupCallback callback, base::CancelableTaskTracker *tracker)
+{
+    service->ScheduleDBTask(FROM_HERE,
+                            std::make_unique<FaviconLookupTask>(FaviconLookupTask::PageUrls, pageUrls,
+                                                                iconTypes, desiredSizeInPixel,
+                                                                std::move(callback)),
+                            tracker);
+}
+
+void lookupFaviconForIconUrl(history::HistoryService *service, const QUrl &iconUrl,
+                             const favicon_base::IconTypeSet &iconTypes, int desiredSizeInPixel,
+                             FaviconLookupCallback callback, base::CancelableTaskTracker *tracker)
+{
+    service->ScheduleDBTask(FROM_HERE,
+                            std::make_unique<FaviconLookupTask>(FaviconLookupTask::IconUrl,
+                                                                QList<QUrl>{ iconUrl }, iconTypes,
+                                                                desiredSizeInPixel, std::move(callback)),
+                            tracker);
+}
+
+} // namespace QtWebEngineCore
@@ -0,0 +1,65 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef FAVICON_LOOKUP_H
+#define FAVICON_LOOKUP_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include "base/functional/callback.h"
+#include "components/favicon_base/favicon_types.h"
+
+#include <QtCore/QList>
+#include <QtCore/QUrl>
+#include <QtGui/QImage>
+
+#include <vector>
+
+namespace base {
+class CancelableTaskTracker;
+}
+
+namespace history {
+class HistoryService;
+}
+
+namespace QtWebEngineCore {
+
+struct FaviconLookupResult
+{
+    QUrl pageUrl;
+    QUrl iconUrl;
+    QImage image;
+};
+
+using FaviconLookupCallback = base::OnceCallback<void(std::vector<FaviconLookupResult>)>;
+
+// Both lookups run as a single task on the history backend sequence, where the
+// stored PNGs are also decoded, so the UI thread only receives ready images.
+// A desiredSizeInPixel of 0 selects the largest available bitmap, any other
+// size scales the closest match to it.
+
+// Resolves the icons of all pageUrls at once, one result per page in order.
+void lookupFaviconsForPageUrls(history::HistoryService *service, const QList<QUrl> &pageUrls,
+                               const favicon_base::IconTypeSet &iconTypes, int desiredSizeInPixel,
+                               FaviconLookupCallback callback, base::CancelableTaskTracker *tracker);
+
+// Resolves iconUrl, trying iconTypes in ascending order until one is stored.
+void lookupFaviconForIconUrl(history::HistoryService *service, const QUrl &iconUrl,
+                             const favicon_base::IconTypeSet &iconTypes, int desiredSizeInPixel,
+                             FaviconLookupCallback callback, base::CancelableTaskTracker *tracker);
+
+} // namespace QtWebEngineCore
+
+#endif // FAVICON_LOOKUP_H
@@ -0,0 +1,152 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "frame_sink_capturer.h"
+
+#include "base/functional/bind.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/task/sequenced_task_runner.h"
+#include "components/viz/common/surfaces/video_capture_target.h"
+#include "components/viz/host/client_frame_sink_video_capturer.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+#include "media/base/video_frame.h"
+#include "mojo/public/cpp/bindings/remote.h"
+
+#include "render_widget_host_view_qt.h"
+#include "type_conversion.h"
+
+namespace QtWebEngineCore {
+
+namespace {
+
+struct FrameBuffer
+{
+    base::ReadOnlySharedMemoryMapping mapping;
+    scoped_refptr<media::VideoFrame> frame;
+    mojo::Remote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks> callbacks;
+};
+
+// Used if neither a maximum size is set nor the page is shown.
+constexpr gfx::Size kDefaultCaptureSize(1920, 1080);
+
+} // namespace
+
+FrameSinkCapturer::FrameSinkCapturer(content::WebContents *webContents, FrameCallback frameCallback,
+                                     StoppedCallback stoppedCallback)
+    : content::WebContentsObserver(webContents)
+    , m_frameCallback(std::move(frameCallback))
+    , m_stoppedCallback(std::move(stoppedCallback))
+{
+}
+
+FrameSinkCapturer::~FrameSinkCapturer()
+{
+    stop();
+}
+
+bool FrameSinkCapturer::start(CapturedFrame::PixelFormat format, qreal maximumFrameRate,
+                              const QSize &maximumSize)
+{
+    stop();
+    if (!web_contents() || !web_contents()->GetRenderWidgetHostView() || maximumFrameRate <= 0)
+        return false;
+
+    content::RenderWidgetHostView *view = web_contents()->GetRenderWidgetHostView();
+    gfx::Size size = toGfx(maximumSize);
+    if (size.IsEmpty())
+        size = view->GetCompositorViewportPixelSize();
+    if (size.IsEmpty())
+        size = kDefaultCaptureSize;
+
+    m_capturer = view->CreateVideoCapturer();
+    m_capturer->SetFormat(format == CapturedFrame::I420 ? media::PIXEL_FORMAT_I420
+                                                        : media::PIXEL_FORMAT_ARGB);
+    m_capturer->SetMinCapturePeriod(base::Seconds(1) / maximumFrameRate);
+    // Frames are only delivered when the page changed, at most at the requested rate.
+    m_capturer->SetAutoThrottlingEnabled(false);
+    m_capturer->SetResolutionConstraints(size, size, /*use_fixed_aspect_ratio=*/true);
+    m_keepPainting = web_contents()->IncrementCapturerCount(size, /*stay_hidden=*/true,
+                                                            /*stay_awake=*/true,
+                                                            /*is_activity=*/false);
+    m_capturer->Start(this, viz::mojom::BufferFormatPreference::kDefault);
+    return true;
+}
+
+void FrameSinkCapturer::stop()
+{
+    if (!m_capturer)
+        return;
+    m_capturer.reset();
+    m_keepPainting.RunAndReset();
+}
+
+void FrameSinkCapturer::retarget()
+{
+    auto *view = static_cast<RenderWidgetHostViewQt *>(web_contents()->GetRenderWidgetHostView());
+    if (!view)
+        return;
+    m_capturer->ChangeTarget(viz::VideoCaptureTarget(view->GetFrameSinkId()),
+                             /*sub_capture_target_version=*/0);
+}
+
+void FrameSinkCapturer::OnFrameCaptured(media::mojom::VideoBufferHandlePtr data,
+                                        media::mojom::VideoFrameInfoPtr info,
+                                        const gfx::Rect &contentRect,
+                                        mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks> callbacks)
+{
+    // Dropping the callbacks without mapping the buffer returns it to the capturer.
+    if (!data->is_read_only_shmem_region())
+        return;
+
+    auto buffer = std::make_unique<FrameBuffer>();
+    buffer->mapping = data->get_read_only_shmem_region().Map();
+    if (!buffer->mapping.IsValid())
+        return;
+    buffer->frame = media::VideoFrame::WrapExternalData(
+            info->pixel_format, info->coded_size, info->visible_rect, info->visible_rect.size(),
+            buffer->mapping.GetMemoryAs<uint8_t>(), buffer->mapping.size(), info->timestamp);
+    if (!buffer->frame)
+        return;
+    buffer->callbacks.Bind(std::move(callbacks));
+
+    CapturedFrame frame;
+    frame.format = info->pixel_format == media::PIXEL_FORMAT_I420 ? CapturedFrame::I420
+                                                                   : CapturedFrame::ARGB;
+    frame.size = toQt(info->coded_size);
+    frame.contentRect = toQt(contentRect);
+    frame.damageRect = info->metadata.capture_update_rect ? toQt(*info->metadata.capture_update_rect)
+                                                           : frame.contentRect;
+    frame.timestamp = info->timestamp.InMicroseconds();
+    for (size_t plane = 0; plane < media::VideoFrame::NumPlanes(info->pixel_format); ++plane) {
+        frame.planes.append({ buffer->frame->data(plane), buffer->frame->stride(plane),
+                              int(buffer->frame->rows(plane)) });
+    }
+
+    // The buffer may be released on any thread, while the capturer has to be told on this one.
+    scoped_refptr<base::SequencedTaskRunner> taskRunner = base::SequencedTaskRunner::GetCurrentDefault();
+    frame.buffer = std::shared_ptr<void>(buffer.release(), [taskRunner](void *pointer) {
+        std::unique_ptr<FrameBuffer> buffer(static_cast<FrameBuffer *>(pointer));
+        taskRunner->PostTask(FROM_HERE, base::BindOnce([](std::unique_ptr<FrameBuffer> buffer) {
+            buffer->callbacks->Done();
+        }, std::move(buffer)));
+    });
+    m_frameCallback(frame);
+}
+
+void FrameSinkCapturer::RenderFrameHostChanged(content::RenderFrameHost *oldHost,
+                                               content::RenderFrameHost *newHost)
+{
+    if (m_capturer && newHost && newHost->IsInPrimaryMainFrame())
+        retarget();
+}
+
+void FrameSinkCapturer::WebContentsDestroyed()
+{
+    if (!m_capturer)
+        return;
+    stop();
+    m_stoppedCallback();
+}
+
+} // namespace QtWebEngineCore
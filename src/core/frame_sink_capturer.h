@@ -0,0 +1,98 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef FRAME_SINK_CAPTURER_H
+#define FRAME_SINK_CAPTURER_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include "base/functional/callback_helpers.h"
+#include "content/public/browser/web_contents_observer.h"
+#include "services/viz/privileged/mojom/compositing/frame_sink_video_capture.mojom.h"
+
+#include <QtCore/qrect.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <functional>
+#include <memory>
+
+namespace viz {
+class ClientFrameSinkVideoCapturer;
+}
+
+namespace QtWebEngineCore {
+
+struct CapturedFrame
+{
+    enum PixelFormat { I420, ARGB };
+    struct Plane
+    {
+        const uchar *bits = nullptr;
+        int bytesPerLine = 0;
+        int rows = 0;
+    };
+
+    PixelFormat format = ARGB;
+    QSize size;
+    QRect contentRect;
+    // The part of the content that changed since the previous frame.
+    QRect damageRect;
+    qint64 timestamp = 0; // in microseconds
+    QVarLengthArray<Plane, 3> planes;
+    // Keeps the planes mapped. Once released, the buffer is handed back to the capturer.
+    std::shared_ptr<void> buffer;
+};
+
+// Captures the composited frames of the primary main frame of a page into shared memory
+// buffers, following the page across render widget host changes.
+class FrameSinkCapturer : public viz::mojom::FrameSinkVideoConsumer,
+                          public content::WebContentsObserver
+{
+public:
+    using FrameCallback = std::function<void(const CapturedFrame &)>;
+    using StoppedCallback = std::function<void()>;
+
+    FrameSinkCapturer(content::WebContents *webContents, FrameCallback frameCallback,
+                      StoppedCallback stoppedCallback);
+    ~FrameSinkCapturer() override;
+
+    bool start(CapturedFrame::PixelFormat format, qreal maximumFrameRate, const QSize &maximumSize);
+    void stop();
+    bool isActive() const { return bool(m_capturer); }
+
+    // viz::mojom::FrameSinkVideoConsumer
+    void OnFrameCaptured(media::mojom::VideoBufferHandlePtr data, media::mojom::VideoFrameInfoPtr info,
+                         const gfx::Rect &contentRect,
+                         mojo::PendingRemote<viz::mojom::FrameSinkVideoConsumerFrameCallbacks> callbacks) override;
+    void OnNewSubCaptureTargetVersion(uint32_t) override { }
+    void OnFrameWithEmptyRegionCapture() override { }
+    void OnStopped() override { }
+    void OnLog(const std::string &) override { }
+
+    // content::WebContentsObserver
+    void RenderFrameHostChanged(content::RenderFrameHost *oldHost, content::RenderFrameHost *newHost) override;
+    void WebContentsDestroyed() override;
+
+private:
+    void retarget();
+
+    FrameCallback m_frameCallback;
+    StoppedCallback m_stoppedCallback;
+    std::unique_ptr<viz::ClientFrameSinkVideoCapturer> m_capturer;
+    base::ScopedClosureRunner m_keepPainting;
+};
+
+} // namespace QtWebEngineCore
+
+#endif // FRAME_SINK_CAPTURER_H
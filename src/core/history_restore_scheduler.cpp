@@ -0,0 +1,62 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "history_restore_scheduler.h"
+
+#include "content/public/browser/web_contents.h"
+
+#include "profile_adapter.h"
+#include "web_contents_adapter.h"
+
+namespace QtWebEngineCore {
+
+using namespace std::chrono_literals;
+
+static constexpr auto kPollInterval = 100ms;
+// Number of restored pages that may be loading at the same time.
+static constexpr qsizetype kMaximumLoadingPages = 4;
+
+HistoryRestoreScheduler::HistoryRestoreScheduler(ProfileAdapter *profileAdapter)
+    : m_profileAdapter(profileAdapter)
+{
+    m_timer.setInterval(kPollInterval);
+    QObject::connect(&m_timer, &QTimer::timeout, [this]() { restoreNextBatch(); });
+}
+
+HistoryRestoreScheduler::~HistoryRestoreScheduler() = default;
+
+void HistoryRestoreScheduler::schedule(const QSharedPointer<WebContentsAdapter> &adapter)
+{
+    Q_ASSERT(adapter->hasDeferredNavigationHistory());
+    m_pendingAdapters.append(adapter.toWeakRef());
+    if (!m_timer.isActive()) {
+        m_timer.start();
+        QTimer::singleShot(0, &m_timer, [this]() { restoreNextBatch(); });
+    }
+}
+
+void HistoryRestoreScheduler::restoreNextBatch()
+{
+    // Restored pages would load before the stored permissions and preferences are known.
+    if (!m_profileAdapter->isReady())
+        return;
+
+    m_loadingAdapters.removeIf([](const QWeakPointer<WebContentsAdapter> &weakAdapter) {
+        const auto adapter = weakAdapter.toStrongRef();
+        return !adapter || !adapter->webContents() || !adapter->webContents()->IsLoading();
+    });
+
+    while (m_loadingAdapters.size() < kMaximumLoadingPages && !m_pendingAdapters.isEmpty()) {
+        const auto adapter = m_pendingAdapters.takeFirst().toStrongRef();
+        // The page may have been shown, navigated, or restored again in the meantime.
+        if (!adapter || adapter->isInitialized() || !adapter->hasDeferredNavigationHistory())
+            continue;
+        adapter->loadDefault();
+        m_loadingAdapters.append(adapter.toWeakRef());
+    }
+
+    if (m_pendingAdapters.isEmpty())
+        m_timer.stop();
+}
+
+} // namespace QtWebEngineCore
@@ -0,0 +1,51 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef HISTORY_RESTORE_SCHEDULER_H
+#define HISTORY_RESTORE_SCHEDULER_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include <QList>
+#include <QSharedPointer>
+#include <QTimer>
+
+namespace QtWebEngineCore {
+
+class ProfileAdapter;
+class WebContentsAdapter;
+
+// Initializes the pages of a profile whose navigation history was restored without
+// a WebContents, in the order they were scheduled. Only a few restored pages are
+// loading at any time, so a large session does not start all of its loads at once.
+class HistoryRestoreScheduler
+{
+public:
+    explicit HistoryRestoreScheduler(ProfileAdapter *profileAdapter);
+    ~HistoryRestoreScheduler();
+
+    void schedule(const QSharedPointer<WebContentsAdapter> &adapter);
+
+private:
+    void restoreNextBatch();
+
+    ProfileAdapter *m_profileAdapter;
+    QList<QWeakPointer<WebContentsAdapter>> m_pendingAdapters;
+    QList<QWeakPointer<WebContentsAdapter>> m_loadingAdapters;
+    QTimer m_timer;
+};
+
+} // namespace QtWebEngineCore
+
+#endif // HISTORY_RESTORE_SCHEDULER_H
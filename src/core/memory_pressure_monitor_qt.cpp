@@ -0,0 +1,163 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "memory_pressure_monitor_qt.h"
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/functional/bind.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "content/browser/renderer_host/render_process_host_impl.h"
+#include "content/public/browser/browser_thread.h"
+
+#include "api/qwebengineglobalsettings.h"
+#include "api/qwebengineglobalsettings_p.h"
+#include "profile_adapter.h"
+#include "profile_qt.h"
+#include "web_engine_context.h"
+
+#include <string_view>
+
+#if BUILDFLAG(IS_LINUX)
+#include <unistd.h>
+#endif
+
+namespace QtWebEngineCore {
+
+using MemoryPressureLevel = base::MemoryPressureListener::MemoryPressureLevel;
+
+ASSERT_ENUMS_MATCH(QWebEngineGlobalSettings::MemoryPressureLevel::None,
+                   base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+ASSERT_ENUMS_MATCH(QWebEngineGlobalSettings::MemoryPressureLevel::Moderate,
+                   base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE)
+ASSERT_ENUMS_MATCH(QWebEngineGlobalSettings::MemoryPressureLevel::Critical,
+                   base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL)
+
+static constexpr base::TimeDelta kSampleInterval = base::Seconds(1);
+// Chromium's own monitors repeat notifications while the pressure persists.
+static constexpr base::TimeDelta kRenotifyInterval = base::Seconds(5);
+
+// Share of the last 10 seconds, in percent, in which some or all tasks stalled on memory.
+static constexpr double kModerateSomeAvg10 = 10.0;
+static constexpr double kCriticalSomeAvg10 = 40.0;
+static constexpr double kCriticalFullAvg10 = 10.0;
+
+static const char kPressureFile[] = "/proc/pressure/memory";
+
+void notifyMemoryPressure(MemoryPressureLevel level, ProfileAdapter *profileAdapter)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    if (level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+        return;
+
+    // Listeners in the browser process are shared between all profiles.
+    if (!profileAdapter)
+        base::MemoryPressureListener::NotifyMemoryPressure(level);
+
+    for (auto it = content::RenderProcessHost::AllHostsIterator(); !it.IsAtEnd(); it.Advance()) {
+        content::RenderProcessHost *host = it.GetCurrentValue();
+        if (!host->IsInitializedAndNotDead())
+            continue;
+        if (profileAdapter && host->GetBrowserContext() != profileAdapter->profile())
+            continue;
+        static_cast<content::RenderProcessHostImpl *>(host)->NotifyMemoryPressureToRenderer(level);
+    }
+}
+
+// The file has the format:
+//   some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+//   full avg10=0.00 avg60=0.00 avg300=0.00 total=0
+static double parseAvg10(std::string_view contents, std::string_view kind)
+{
+    const std::string prefix = std::string(kind) + " avg10=";
+    const size_t start = contents.find(prefix);
+    if (start == std::string_view::npos)
+        return 0.0;
+    std::string_view value = contents.substr(start + prefix.size());
+    value = value.substr(0, value.find(' '));
+    double result = 0.0;
+    if (!base::StringToDouble(value, &result))
+        return 0.0;
+    return result;
+}
+
+// Runs on the thread pool, as reading the file may block.
+static MemoryPressureLevel readPressureLevel()
+{
+    std::string contents;
+    if (!base::ReadFileToString(base::FilePath::FromASCII(kPressureFile), &contents))
+        return base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
+
+    const double some = parseAvg10(contents, "some");
+    const double full = parseAvg10(contents, "full");
+    if (full >= kCriticalFullAvg10 || some >= kCriticalSomeAvg10)
+        return base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL;
+    if (some >= kModerateSomeAvg10)
+        return base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE;
+    return base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
+}
+
+bool MemoryPressureMonitorQt::isSupported()
+{
+#if BUILDFLAG(IS_LINUX)
+    return access(kPressureFile, R_OK) == 0;
+#else
+    return false;
+#endif
+}
+
+MemoryPressureMonitorQt::MemoryPressureMonitorQt()
+    : m_taskRunner(base::ThreadPool::CreateSequencedTaskRunner(
+              { base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+                base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN }))
+{
+    m_timer.Start(FROM_HERE, kSampleInterval,
+                  base::BindRepeating(&MemoryPressureMonitorQt::sample, base::Unretained(this)));
+}
+
+MemoryPressureMonitorQt::~MemoryPressureMonitorQt() = default;
+
+void MemoryPressureMonitorQt::sample()
+{
+    m_taskRunner->PostTaskAndReplyWithResult(
+            FROM_HERE, base::BindOnce(&readPressureLevel),
+            base::BindOnce(&MemoryPressureMonitorQt::onSampled, m_weakPtrFactory.GetWeakPtr()));
+}
+
+void MemoryPressureMonitorQt::onSampled(MemoryPressureLevel level)
+{
+    const base::TimeTicks now = base::TimeTicks::Now();
+    const bool changed = level != m_level;
+    m_level = level;
+    if (level == base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE)
+        return;
+    if (!changed && now - m_lastNotification < kRenotifyInterval)
+        return;
+
+    m_lastNotification = now;
+    notifyMemoryPressure(level);
+}
+
+// Entry points for QWebEngineGlobalSettings
+
+void notifyMemoryPressure(QWebEngineGlobalSettings::MemoryPressureLevel level)
+{
+    if (!WebEngineContext::isInitialized())
+        return;
+    notifyMemoryPressure(static_cast<MemoryPressureLevel>(level));
+}
+
+void setMemoryPressureMonitoringEnabled(bool enabled)
+{
+    if (WebEngineContext::isInitialized())
+        WebEngineContext::current()->setMemoryPressureMonitoringEnabled(enabled);
+}
+
+bool isMemoryPressureMonitoringSupported()
+{
+    return MemoryPressureMonitorQt::isSupported();
+}
+
+} // namespace QtWebEngineCore
@@ -0,0 +1,63 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef MEMORY_PRESSURE_MONITOR_QT_H
+#define MEMORY_PRESSURE_MONITOR_QT_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace QtWebEngineCore {
+
+class ProfileAdapter;
+
+// Forwards memory pressure to the browser process and the renderer processes,
+// either of all profiles or only of the given one.
+void notifyMemoryPressure(base::MemoryPressureListener::MemoryPressureLevel level,
+                          ProfileAdapter *profileAdapter = nullptr);
+
+// Polls the Linux pressure stall information of the memory resource and
+// notifies about memory pressure derived from it.
+class MemoryPressureMonitorQt
+{
+public:
+    static bool isSupported();
+
+    MemoryPressureMonitorQt();
+    ~MemoryPressureMonitorQt();
+
+private:
+    void sample();
+    void onSampled(base::MemoryPressureListener::MemoryPressureLevel level);
+
+    scoped_refptr<base::SequencedTaskRunner> m_taskRunner;
+    base::RepeatingTimer m_timer;
+    base::MemoryPressureListener::MemoryPressureLevel m_level =
+            base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
+    base::TimeTicks m_lastNotification;
+    base::WeakPtrFactory<MemoryPressureMonitorQt> m_weakPtrFactory { this };
+};
+
+} // namespace QtWebEngineCore
+
+#endif // MEMORY_PRESSURE_MONITOR_QT_H
@@ -0,0 +1,68 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "cookie_access_policy_qt.h"
+
+#include "net/base/registry_controlled_domains/registry_controlled_domain.h"
+#include "url/gurl.h"
+
+namespace QtWebEngineCore {
+
+void CookieAccessPolicyQt::setRule(std::string domain, Rule rule)
+{
+    m_rules.insert_or_assign(std::move(domain), rule);
+}
+
+bool CookieAccessPolicyQt::removeRule(const std::string &domain)
+{
+    return m_rules.erase(domain) > 0;
+}
+
+std::optional<CookieAccessPolicyQt::Rule> CookieAccessPolicyQt::ruleForHost(std::string_view host,
+                                                                            bool isIPAddress) const
+{
+    // A rule for a domain also covers all of its subdomains, the most specific one wins.
+    while (!host.empty()) {
+        auto it = m_rules.find(host);
+        if (it != m_rules.end())
+            return it->second;
+        if (isIPAddress)
+            break;
+        const size_t dot = host.find('.');
+        if (dot == std::string_view::npos)
+            break;
+        host.remove_prefix(dot + 1);
+    }
+
+    auto it = m_rules.find(std::string_view());
+    if (it != m_rules.end())
+        return it->second;
+    return std::nullopt;
+}
+
+std::optional<bool> CookieAccessPolicyQt::allowedAccess(const GURL &firstPartyUrl,
+                                                        const GURL &url) const
+{
+    if (m_rules.empty())
+        return std::nullopt;
+
+    const std::optional<Rule> rule = ruleForHost(url.host_piece(), url.HostIsIPAddress());
+    if (!rule)
+        return std::nullopt;
+
+    switch (*rule) {
+    case Allow:
+        return true;
+    case Block:
+        return false;
+    case BlockThirdParty:
+        // Empty first-party URL indicates a first-party request (see net/base/static_cookie_policy.cc)
+        return firstPartyUrl.is_empty()
+                || net::registry_controlled_domains::SameDomainOrHost(
+                        url, firstPartyUrl,
+                        net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
+    }
+    return std::nullopt;
+}
+
+} // namespace QtWebEngineCore
@@ -0,0 +1,61 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef COOKIE_ACCESS_POLICY_QT_H
+#define COOKIE_ACCESS_POLICY_QT_H
+
+#include "base/containers/flat_map.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+class GURL;
+
+namespace QtWebEngineCore {
+
+// Immutable lookup table for the declarative cookie access rules of a
+// QWebEngineCookieStore. Works on GURLs directly so that it can be evaluated
+// for every cookie access without converting to Qt types or calling user code.
+class CookieAccessPolicyQt
+{
+public:
+    // Must match QWebEngineCookieStore::AccessRule
+    enum Rule {
+        Allow,
+        Block,
+        BlockThirdParty,
+    };
+
+    CookieAccessPolicyQt() = default;
+
+    bool isEmpty() const { return m_rules.empty(); }
+    void setRule(std::string domain, Rule rule);
+    bool removeRule(const std::string &domain);
+
+    // Returns whether |url| may access cookies in the context of |firstPartyUrl|,
+    // or nullopt if no rule applies.
+    std::optional<bool> allowedAccess(const GURL &firstPartyUrl, const GURL &url) const;
+
+private:
+    std::optional<Rule> ruleForHost(std::string_view host, bool isIPAddress) const;
+
+    // Keyed by canonical (lower-case, ASCII compatible) domain. The empty
+    // domain holds the rule for all sites without a more specific one.
+    base::flat_map<std::string, Rule, std::less<>> m_rules;
+};
+
+} // namespace QtWebEngineCore
+
+#endif // COOKIE_ACCESS_POLICY_QT_H
@@ -3,7 +3,10 @@
 
 #include "cookie_monster_delegate_qt.h"
 
+#include "base/barrier_callback.h"
 #include "base/functional/bind.h"
+#include "base/task/sequenced_task_runner.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "net/cookies/cookie_util.h"
 #include "services/network/public/mojom/cookie_manager.mojom.h"
 
@@ -39,7 +42,7 @@ public:
 
     void AllowedAccess(const GURL &url, const net::SiteForCookies &site_for_cookies, AllowedAccessCallback callback) override
     {
-        bool allow = m_delegate->canGetCookies(toQt(site_for_cookies.first_party_url()), toQt(url));
+        bool allow = m_delegate->canGetCookies(site_for_cookies.first_party_url(), url);
         std::move(callback).Run(allow);
     }
 
@@ -54,6 +57,40 @@ static GURL sourceUrlForCookie(const QNetworkCookie &cookie)
     return net::cookie_util::CookieOriginToURL(urlFragment.toStdString(), /* is_https */ cookie.isSecure());
 }
 
+static std::unique_ptr<net::CanonicalCookie> createCanonicalCookie(const QNetworkCookie &cookie, const QUrl &origin, GURL *gurl)
+{
+    *gurl = origin.isEmpty() ? sourceUrlForCookie(cookie) : toGurl(origin);
+    std::string cookie_line = cookie.toRawForm().toStdString();
+
+    net::CookieInclusionStatus inclusion;
+    auto canonCookie = net::CanonicalCookie::Create(*gurl, cookie_line, base::Time::Now(),
+                                                    std::nullopt, std::nullopt, true,
+                                                    net::CookieSourceType::kOther, &inclusion);
+    if (!canonCookie || !inclusion.IsInclude())
+        return nullptr;
+    return canonCookie;
+}
+
+static net::CookieOptions userCookieOptions()
+{
+    net::CookieOptions options;
+    options.set_include_httponly();
+    options.set_same_site_cookie_context(net::CookieOptions::SameSiteCookieContext::MakeInclusiveForSet());
+    return options;
+}
+
+static bool cookieMatchesDomain(const net::CanonicalCookie &cookie, const std::string &domain)
+{
+    if (domain.empty())
+        return true;
+    std::string_view cookieDomain = cookie.Domain();
+    if (cookieDomain.starts_with('.'))
+        cookieDomain.remove_prefix(1);
+    if (cookieDomain.size() < domain.size() || !cookieDomain.ends_with(domain))
+        return false;
+    return cookieDomain.size() == domain.size() || cookieDomain[cookieDomain.size() - domain.size() - 1] == '.';
+}
+
 CookieMonsterDelegateQt::CookieMonsterDelegateQt()
     : m_client(nullptr)
     , m_listener(new CookieChangeListener(this))
@@ -88,26 +125,109 @@ void CookieMonsterDelegateQt::getAllCookies()
     m_mojoCookieManager->GetAllCookies(net::CookieStore::GetAllCookiesCallback());
 }
 
-void CookieMonsterDelegateQt::setCookie(const QNetworkCookie &cookie, const QUrl &origin)
+void CookieMonsterDelegateQt::getCookies(const std::string &domain, size_t pageSize, CookiePageCallback callback)
 {
     Q_ASSERT(hasCookieMonster());
     Q_ASSERT(m_client);
 
-    GURL gurl = origin.isEmpty() ? sourceUrlForCookie(cookie) : toGurl(origin);
-    std::string cookie_line = cookie.toRawForm().toStdString();
+    m_mojoCookieManager->GetAllCookies(
+            mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+                    base::BindOnce(&CookieMonsterDelegateQt::onGotCookies, base::WrapRefCounted(this),
+                                   domain, pageSize, std::move(callback)),
+                    net::CookieList()));
+}
 
-    net::CookieInclusionStatus inclusion;
-    auto canonCookie = net::CanonicalCookie::Create(gurl, cookie_line, base::Time::Now(),
-                                                    std::nullopt, std::nullopt, true,
-                                                    net::CookieSourceType::kOther, &inclusion);
-    if (!canonCookie || !inclusion.IsInclude()) {
+void CookieMonsterDelegateQt::onGotCookies(const std::string &domain, size_t pageSize, CookiePageCallback callback,
+                                           const net::CookieList &cookies)
+{
+    net::CookieList matching;
+    if (domain.empty()) {
+        matching = cookies;
+    } else {
+        for (const net::CanonicalCookie &cookie : cookies) {
+            if (cookieMatchesDomain(cookie, domain))
+                matching.push_back(cookie);
+        }
+    }
+    deliverCookiePage(std::move(matching), 0, pageSize, std::move(callback));
+}
+
+void CookieMonsterDelegateQt::deliverCookiePage(net::CookieList cookies, size_t offset, size_t pageSize,
+                                                CookiePageCallback callback)
+{
+    const size_t end = pageSize ? std::min(cookies.size(), offset + pageSize) : cookies.size();
+    QList<QNetworkCookie> page;
+    page.reserve(end - offset);
+    for (size_t i = offset; i < end; ++i)
+        page.append(toQt(cookies[i]));
+
+    const bool last = end == cookies.size();
+    if (!callback(page, last) || last)
+        return;
+
+    // Return to the event loop between pages, so that large stores do not block it.
+    base::SequencedTaskRunner::GetCurrentDefault()->PostTask(
+            FROM_HERE,
+            base::BindOnce(&CookieMonsterDelegateQt::deliverCookiePage, base::WrapRefCounted(this),
+                           std::move(cookies), end, pageSize, std::move(callback)));
+}
+
+void CookieMonsterDelegateQt::setCookie(const QNetworkCookie &cookie, const QUrl &origin)
+{
+    Q_ASSERT(hasCookieMonster());
+    Q_ASSERT(m_client);
+
+    GURL gurl;
+    auto canonCookie = createCanonicalCookie(cookie, origin, &gurl);
+    if (!canonCookie) {
         LOG(WARNING) << "QWebEngineCookieStore::setCookie() - Tried to set invalid cookie";
         return;
     }
-    net::CookieOptions options;
-    options.set_include_httponly();
-    options.set_same_site_cookie_context(net::CookieOptions::SameSiteCookieContext::MakeInclusiveForSet());
-    m_mojoCookieManager->SetCanonicalCookie(*canonCookie.get(), gurl, options, net::CookieStore::SetCookiesCallback());
+    m_mojoCookieManager->SetCanonicalCookie(*canonCookie.get(), gurl, userCookieOptions(), net::CookieStore::SetCookiesCallback());
+}
+
+void CookieMonsterDelegateQt::setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin,
+                                         CookieImportCallback callback)
+{
+    Q_ASSERT(hasCookieMonster());
+    Q_ASSERT(m_client);
+
+    std::vector<std::pair<std::unique_ptr<net::CanonicalCookie>, GURL>> canonCookies;
+    canonCookies.reserve(cookies.size());
+    for (const QNetworkCookie &cookie : cookies) {
+        GURL gurl;
+        if (auto canonCookie = createCanonicalCookie(cookie, origin, &gurl))
+            canonCookies.emplace_back(std::move(canonCookie), std::move(gurl));
+    }
+    if (canonCookies.size() != size_t(cookies.size()))
+        LOG(WARNING) << "QWebEngineCookieStore::setCookies() - Skipped "
+                     << cookies.size() - canonCookies.size() << " invalid cookies";
+
+    if (canonCookies.empty()) {
+        if (callback)
+            callback(0);
+        return;
+    }
+
+    auto barrier = base::BarrierCallback<net::CookieAccessResult>(
+            canonCookies.size(),
+            base::BindOnce([](CookieImportCallback callback, const std::vector<net::CookieAccessResult> &results) {
+                if (!callback)
+                    return;
+                callback(std::count_if(results.begin(), results.end(), [](const net::CookieAccessResult &result) {
+                    return result.status.IsInclude();
+                }));
+            }, std::move(callback)));
+
+    const net::CookieOptions options = userCookieOptions();
+    for (const auto &[canonCookie, gurl] : canonCookies) {
+        m_mojoCookieManager->SetCanonicalCookie(
+                *canonCookie, gurl, options,
+                mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+                        base::OnceCallback<void(net::CookieAccessResult)>(barrier),
+                        net::CookieAccessResult(net::CookieInclusionStatus(
+                                net::CookieInclusionStatus::EXCLUDE_UNKNOWN_ERROR))));
+    }
 }
 
 void CookieMonsterDelegateQt::deleteCookie(const QNetworkCookie &cookie, const QUrl &origin)
@@ -194,7 +314,7 @@ void CookieMonsterDelegateQt::setClient(QWebEngineCookieStore *client)
         m_client->d_func()->processPendingUserCookies();
 }
 
-bool CookieMonsterDelegateQt::canSetCookie(const QUrl &firstPartyUrl, const QByteArray &/*cookieLine*/, const QUrl &url) const
+bool CookieMonsterDelegateQt::canSetCookie(const GURL &firstPartyUrl, const QByteArray &/*cookieLine*/, const GURL &url) const
 {
     if (!m_client)
         return true;
@@ -202,7 +322,7 @@ bool CookieMonsterDelegateQt::canSetCookie(const QUrl &firstPartyUrl, const QByt
     return m_client->d_func()->canAccessCookies(firstPartyUrl, url);
 }
 
-bool CookieMonsterDelegateQt::canGetCookies(const QUrl &firstPartyUrl, const QUrl &url) const
+bool CookieMonsterDelegateQt::canGetCookies(const GURL &firstPartyUrl, const GURL &url) const
 {
     if (!m_client)
         return true;
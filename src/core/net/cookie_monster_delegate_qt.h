@@ -33,8 +33,11 @@
 #undef StAsH_signals
 #endif
 
+#include <QList>
 #include <QPointer>
 
+#include <functional>
+
 QT_FORWARD_DECLARE_CLASS(QNetworkCookie)
 QT_FORWARD_DECLARE_CLASS(QWebEngineCookieStore)
 
@@ -54,6 +57,10 @@ class Q_WEBENGINECORE_EXPORT CookieMonsterDelegateQt : public base::RefCountedTh
     mojo::Receiver<network::mojom::CookieRemoteAccessFilter> m_filterReceiver;
     bool m_hasFilter;
 public:
+    // Returns false to stop delivering further pages
+    using CookiePageCallback = std::function<bool(const QList<QNetworkCookie> &page, bool last)>;
+    using CookieImportCallback = std::function<void(qsizetype imported)>;
+
     CookieMonsterDelegateQt();
     ~CookieMonsterDelegateQt();
 
@@ -62,6 +69,8 @@ public:
     void setCookie(const QNetworkCookie &cookie, const QUrl &origin);
     void deleteCookie(const QNetworkCookie &cookie, const QUrl &origin);
     void getAllCookies();
+    void getCookies(const std::string &domain, size_t pageSize, CookiePageCallback callback);
+    void setCookies(const QList<QNetworkCookie> &cookies, const QUrl &origin, CookieImportCallback callback);
     void deleteSessionCookies();
     void deleteAllCookies();
 
@@ -70,11 +79,16 @@ public:
     void unsetMojoCookieManager();
     void setHasFilter(bool b);
 
-    bool canSetCookie(const QUrl &firstPartyUrl, const QByteArray &cookieLine, const QUrl &url) const;
-    bool canGetCookies(const QUrl &firstPartyUrl, const QUrl &url) const;
+    bool canSetCookie(const GURL &firstPartyUrl, const QByteArray &cookieLine, const GURL &url) const;
+    bool canGetCookies(const GURL &firstPartyUrl, const GURL &url) const;
 
     void AddStore(net::CookieStore *store);
     void OnCookieChanged(const net::CookieChangeInfo &change);
+
+private:
+    void onGotCookies(const std::string &domain, size_t pageSize, CookiePageCallback callback,
+                      const net::CookieList &cookies);
+    void deliverCookiePage(net::CookieList cookies, size_t offset, size_t pageSize, CookiePageCallback callback);
 };
 
 } // namespace QtWebEngineCore
@@ -0,0 +1,199 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "page_capture.h"
+
+#include "base/functional/bind.h"
+#include "base/task/single_thread_task_runner.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/web_contents.h"
+#include "content/public/browser/web_contents_user_data.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "ui/gfx/geometry/size_conversions.h"
+
+#include "render_widget_host_view_qt.h"
+#include "type_conversion.h"
+
+#include <QtCore/qlist.h>
+#include <QtCore/qmath.h>
+
+namespace QtWebEngineCore {
+
+// Larger surfaces exceed the maximum texture size of most GPUs.
+static constexpr int kMaxCaptureSize = 16384;
+
+// The captures of a page waiting to run, the first one is running.
+class PageCaptureQueue : public content::WebContentsUserData<PageCaptureQueue>
+{
+public:
+    QList<PageCapture *> captures;
+
+private:
+    explicit PageCaptureQueue(content::WebContents *webContents)
+        : content::WebContentsUserData<PageCaptureQueue>(*webContents)
+    {}
+    friend class content::WebContentsUserData<PageCaptureQueue>;
+    WEB_CONTENTS_USER_DATA_KEY_DECL();
+};
+
+WEB_CONTENTS_USER_DATA_KEY_IMPL(PageCaptureQueue);
+
+void PageCapture::capture(content::WebContents *webContents, const QRect &rect, qreal scale,
+                          Callback callback)
+{
+    auto *capture = new PageCapture(webContents, scale, std::move(callback));
+    capture->m_rect = rect;
+    capture->enqueue();
+}
+
+void PageCapture::captureFullPage(content::WebContents *webContents, int width, qreal scale,
+                                  Callback callback)
+{
+    auto *capture = new PageCapture(webContents, scale, std::move(callback));
+    capture->m_fullPageWidth = qMin(width, kMaxCaptureSize);
+    capture->enqueue();
+}
+
+PageCapture::PageCapture(content::WebContents *webContents, qreal scale, Callback callback)
+    : content::WebContentsObserver(webContents), m_scale(scale), m_callback(std::move(callback))
+{
+}
+
+PageCapture::~PageCapture() = default;
+
+RenderWidgetHostViewQt *PageCapture::view() const
+{
+    if (!web_contents())
+        return nullptr;
+    return static_cast<RenderWidgetHostViewQt *>(web_contents()->GetRenderWidgetHostView());
+}
+
+void PageCapture::enqueue()
+{
+    PageCaptureQueue *queue = PageCaptureQueue::GetOrCreateForWebContents(web_contents());
+    queue->captures.append(this);
+    // Also posted when the queue was empty, so that the callback never runs before capture returns.
+    if (queue->captures.size() == 1)
+        base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+                FROM_HERE, base::BindOnce(&PageCapture::start, m_weakPtrFactory.GetWeakPtr()));
+}
+
+void PageCapture::start()
+{
+    m_started = true;
+    RenderWidgetHostViewQt *rwhv = view();
+    if (!rwhv) {
+        finish(QImage());
+        return;
+    }
+
+    // Keeps hidden pages, including pages without a view, producing frames.
+    m_keepPainting = web_contents()->IncrementCapturerCount(gfx::Size(), /*stay_hidden=*/true,
+                                                            /*stay_awake=*/true,
+                                                            /*is_activity=*/false);
+
+    const QSize viewSize = toQt(rwhv->GetViewBounds().size());
+    if (m_fullPageWidth > 0) {
+        // The height of the contents depends on the width they are laid out at.
+        layout(QSize(m_fullPageWidth, qMax(viewSize.height(), 1)), &PageCapture::measureFullPage);
+        return;
+    }
+
+    if (m_rect.isEmpty())
+        m_rect = QRect(QPoint(), viewSize);
+    if (m_rect.isEmpty() || m_rect.left() < 0 || m_rect.top() < 0) {
+        finish(QImage());
+        return;
+    }
+    const QSize requiredSize = QSize(m_rect.right() + 1, m_rect.bottom() + 1)
+                                       .boundedTo(QSize(kMaxCaptureSize, kMaxCaptureSize));
+    m_rect &= QRect(QPoint(), requiredSize);
+    // Only areas beyond the viewport require laying the page out at a different size.
+    const QSize layoutSize = viewSize.expandedTo(requiredSize);
+    layout(layoutSize == viewSize ? QSize() : layoutSize, &PageCapture::copy);
+}
+
+void PageCapture::layout(const QSize &size, Step next)
+{
+    view()->setCaptureSize(size);
+    // Runs once a frame reflecting the new size has been submitted.
+    web_contents()->GetPrimaryMainFrame()->InsertVisualStateCallback(
+            base::BindOnce(&PageCapture::layoutDone, m_weakPtrFactory.GetWeakPtr(), next));
+}
+
+void PageCapture::layoutDone(Step next, bool success)
+{
+    if (!success || !view()) {
+        finish(QImage());
+        return;
+    }
+    // The frame has been submitted, its metadata such as the contents size may not have arrived yet.
+    view()->runAfterFrameActivation(
+            base::BindOnce(&PageCapture::frameActivated, m_weakPtrFactory.GetWeakPtr(), next));
+}
+
+void PageCapture::frameActivated(Step next, bool success)
+{
+    if (!success || !view()) {
+        finish(QImage());
+        return;
+    }
+    (this->*next)();
+}
+
+void PageCapture::measureFullPage()
+{
+    const int height = qMin(qCeil(view()->lastContentsSize().height()), kMaxCaptureSize);
+    m_rect = QRect(0, 0, m_fullPageWidth, qMax(height, 1));
+    layout(m_rect.size(), &PageCapture::copy);
+}
+
+void PageCapture::copy()
+{
+    RenderWidgetHostViewQt *rwhv = view();
+    if (!rwhv->IsSurfaceAvailableForCopy()) {
+        finish(QImage());
+        return;
+    }
+    const gfx::Size outputSize = gfx::ToCeiledSize(gfx::ScaleSize(gfx::SizeF(toGfx(m_rect.size())), m_scale));
+    rwhv->CopyFromSurface(toGfx(m_rect), outputSize,
+                          base::BindOnce(&PageCapture::copied, m_weakPtrFactory.GetWeakPtr()));
+}
+
+void PageCapture::copied(const SkBitmap &bitmap)
+{
+    finish(bitmap.drawsNothing() ? QImage() : toQImage(bitmap));
+}
+
+void PageCapture::finish(const QImage &image)
+{
+    if (web_contents()) {
+        if (m_started) {
+            if (RenderWidgetHostViewQt *rwhv = view())
+                rwhv->setCaptureSize(QSize());
+        }
+        PageCaptureQueue *queue = PageCaptureQueue::FromWebContents(web_contents());
+        const bool wasFirst = queue->captures.first() == this;
+        queue->captures.removeOne(this);
+        if (wasFirst && !queue->captures.isEmpty())
+            base::SingleThreadTaskRunner::GetCurrentDefault()->PostTask(
+                    FROM_HERE, base::BindOnce(&PageCapture::start,
+                                              queue->captures.first()->m_weakPtrFactory.GetWeakPtr()));
+    }
+    Callback callback = std::move(m_callback);
+    delete this;
+    if (callback)
+        callback(image);
+}
+
+void PageCapture::PrimaryMainFrameRenderProcessGone(base::TerminationStatus)
+{
+    finish(QImage());
+}
+
+void PageCapture::WebContentsDestroyed()
+{
+    finish(QImage());
+}
+
+} // namespace QtWebEngineCore
@@ -0,0 +1,84 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef PAGE_CAPTURE_H
+#define PAGE_CAPTURE_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include "base/functional/callback_helpers.h"
+#include "base/memory/weak_ptr.h"
+#include "content/public/browser/web_contents_observer.h"
+
+#include <QtCore/qrect.h>
+#include <QtGui/qimage.h>
+
+#include <functional>
+
+class SkBitmap;
+
+namespace QtWebEngineCore {
+
+class RenderWidgetHostViewQt;
+
+// Copies an area of the compositor surface of a page into a QImage. Pages that are hidden
+// or have no view are kept painting for the duration of the capture, and areas beyond the
+// viewport are captured by temporarily laying the page out at a larger size.
+// Captures of a page run one after the other, as they share its layout size. The callback
+// is always run asynchronously, and the capture deletes itself after running it.
+class PageCapture : public content::WebContentsObserver
+{
+public:
+    using Callback = std::function<void(const QImage &)>;
+
+    // An empty rect captures the viewport.
+    static void capture(content::WebContents *webContents, const QRect &rect, qreal scale,
+                        Callback callback);
+    // Lays the page out at the given width and captures all of its contents.
+    static void captureFullPage(content::WebContents *webContents, int width, qreal scale,
+                                Callback callback);
+
+private:
+    using Step = void (PageCapture::*)();
+
+    PageCapture(content::WebContents *webContents, qreal scale, Callback callback);
+    ~PageCapture() override;
+
+    RenderWidgetHostViewQt *view() const;
+    void enqueue();
+    void start();
+    void layout(const QSize &size, Step next);
+    void layoutDone(Step next, bool success);
+    void frameActivated(Step next, bool success);
+    void measureFullPage();
+    void copy();
+    void copied(const SkBitmap &bitmap);
+    void finish(const QImage &image);
+
+    // content::WebContentsObserver
+    void PrimaryMainFrameRenderProcessGone(base::TerminationStatus) override;
+    void WebContentsDestroyed() override;
+
+    QRect m_rect;
+    int m_fullPageWidth = 0;
+    qreal m_scale;
+    Callback m_callback;
+    bool m_started = false;
+    base::ScopedClosureRunner m_keepPainting;
+    base::WeakPtrFactory<PageCapture> m_weakPtrFactory { this };
+};
+
+} // namespace QtWebEngineCore
+
+#endif // PAGE_CAPTURE_H
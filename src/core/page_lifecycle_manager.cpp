@@ -0,0 +1,196 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "page_lifecycle_manager.h"
+
+#include "base/functional/bind.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
+
+#include "profile_adapter.h"
+#include "profile_adapter_client.h"
+#include "web_contents_adapter.h"
+#include "web_contents_adapter_client.h"
+
+#include <algorithm>
+
+namespace QtWebEngineCore {
+
+using namespace std::chrono_literals;
+using LifecycleState = WebContentsAdapter::LifecycleState;
+
+static constexpr auto kUpdateInterval = 5s;
+
+static qint64 processIdForPage(WebContentsAdapter *adapter)
+{
+    content::RenderProcessHost *process = adapter->webContents()->GetPrimaryMainFrame()->GetProcess();
+    if (!process || !process->GetProcess().IsValid())
+        return 0;
+    return process->GetProcess().Pid();
+}
+
+PageLifecycleManager::PageLifecycleManager(ProfileAdapter *profileAdapter)
+    : m_profileAdapter(profileAdapter)
+{
+    m_updateTimer.setInterval(kUpdateInterval);
+    QObject::connect(&m_updateTimer, &QTimer::timeout, [this]() { update(); });
+}
+
+PageLifecycleManager::~PageLifecycleManager() = default;
+
+void PageLifecycleManager::setPolicy(const Policy &policy)
+{
+    if (policy.enabled && !m_policy.enabled)
+        m_statistics = Statistics();
+    m_policy = policy;
+
+    if (!m_policy.enabled) {
+        m_updateTimer.stop();
+        return;
+    }
+    m_updateTimer.start();
+    QTimer::singleShot(0, &m_updateTimer, [this]() { update(); });
+}
+
+void PageLifecycleManager::update()
+{
+    if (!m_policy.enabled || m_memoryDumpPending)
+        return;
+
+    auto *instrumentation = memory_instrumentation::MemoryInstrumentation::GetInstance();
+    if (m_policy.memoryBudget > 0 && instrumentation) {
+        m_memoryDumpPending = true;
+        instrumentation->RequestPrivateMemoryFootprint(
+                base::kNullProcessId,
+                base::BindOnce(&PageLifecycleManager::onMemoryDump, m_weakPtrFactory.GetWeakPtr()));
+        return;
+    }
+
+    applyPolicy({});
+}
+
+void PageLifecycleManager::onMemoryDump(bool success, std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump)
+{
+    m_memoryDumpPending = false;
+    if (!m_policy.enabled)
+        return;
+
+    QHash<qint64, qint64> processFootprints;
+    if (success && dump) {
+        for (const auto &processDump : dump->process_dumps())
+            processFootprints.insert(processDump.pid(), qint64(processDump.os_dump().private_footprint_kb) * 1024);
+    }
+    applyPolicy(processFootprints);
+}
+
+void PageLifecycleManager::applyPolicy(const QHash<qint64, qint64> &processFootprints)
+{
+    // Keep the adapters alive, as lifecycle transitions notify the application.
+    QList<QSharedPointer<WebContentsAdapter>> pages;
+    for (WebContentsAdapterClient *client : m_profileAdapter->webContentsAdapterClients()) {
+        WebContentsAdapter *adapter = client->webContentsAdapter();
+        if (adapter && adapter->isInitialized())
+            pages.append(adapter->sharedFromThis());
+    }
+
+    // Renderer memory is shared evenly between the pages hosted by the same process.
+    QHash<qint64, int> pagesPerProcess;
+    QHash<WebContentsAdapter *, qint64> processIds;
+    for (const auto &page : std::as_const(pages)) {
+        const qint64 pid = processIdForPage(page.get());
+        processIds.insert(page.get(), pid);
+        if (pid && processFootprints.contains(pid))
+            ++pagesPerProcess[pid];
+    }
+    qint64 usedMemory = 0;
+    for (auto it = pagesPerProcess.cbegin(); it != pagesPerProcess.cend(); ++it)
+        usedMemory += processFootprints.value(it.key());
+    const auto estimatedFootprint = [&](WebContentsAdapter *adapter) -> qint64 {
+        const qint64 pid = processIds.value(adapter);
+        const int sharing = pagesPerProcess.value(pid);
+        return sharing ? processFootprints.value(pid) / sharing : 0;
+    };
+
+    QList<QSharedPointer<WebContentsAdapter>> candidates;
+    int activePages = 0;
+    for (const auto &page : std::as_const(pages)) {
+        if (page->lifecycleState() == LifecycleState::Active)
+            ++activePages;
+        if (!page->isVisible() && page->lifecycleState() != LifecycleState::Discarded)
+            candidates.append(page);
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](const auto &a, const auto &b) {
+        return a->lastActiveTime() < b->lastActiveTime();
+    });
+
+    bool changed = false;
+    const auto freezePage = [&](WebContentsAdapter *adapter) {
+        if (adapter->lifecycleState() != LifecycleState::Active)
+            return adapter->lifecycleState() == LifecycleState::Frozen;
+        if (adapter->recommendedState() == LifecycleState::Active)
+            return false;
+        adapter->setLifecycleState(LifecycleState::Frozen);
+        if (adapter->lifecycleState() != LifecycleState::Frozen)
+            return false;
+        --activePages;
+        changed = true;
+        return true;
+    };
+    const auto discardPage = [&](WebContentsAdapter *adapter) {
+        const qint64 footprint = estimatedFootprint(adapter);
+        if (!freezePage(adapter) || adapter->recommendedState() != LifecycleState::Discarded)
+            return false;
+        adapter->setLifecycleState(LifecycleState::Discarded);
+        if (adapter->lifecycleState() != LifecycleState::Discarded)
+            return false;
+        usedMemory -= footprint;
+        m_statistics.reclaimedMemory += footprint;
+        changed = true;
+        return true;
+    };
+
+    const auto now = std::chrono::steady_clock::now();
+    for (const auto &page : std::as_const(candidates)) {
+        const auto idle = now - page->lastActiveTime();
+        if (m_policy.discardTimeout > 0ms && idle >= m_policy.discardTimeout)
+            discardPage(page.get());
+        else if (m_policy.freezeTimeout > 0ms && idle >= m_policy.freezeTimeout)
+            freezePage(page.get());
+    }
+
+    if (m_policy.maximumActivePages > 0) {
+        for (const auto &page : std::as_const(candidates)) {
+            if (activePages <= m_policy.maximumActivePages)
+                break;
+            freezePage(page.get());
+        }
+    }
+
+    if (m_policy.memoryBudget > 0 && !processFootprints.isEmpty()) {
+        for (const auto &page : std::as_const(candidates)) {
+            if (usedMemory <= m_policy.memoryBudget)
+                break;
+            if (page->lifecycleState() != LifecycleState::Discarded)
+                discardPage(page.get());
+        }
+    }
+
+    if (!changed)
+        return;
+
+    m_statistics.frozenPages = 0;
+    m_statistics.discardedPages = 0;
+    for (const auto &page : std::as_const(pages)) {
+        if (page->lifecycleState() == LifecycleState::Frozen)
+            ++m_statistics.frozenPages;
+        else if (page->lifecycleState() == LifecycleState::Discarded)
+            ++m_statistics.discardedPages;
+    }
+    for (ProfileAdapterClient *client : m_profileAdapter->clients())
+        client->pageLifecycleStatisticsChanged(m_statistics.frozenPages, m_statistics.discardedPages,
+                                               m_statistics.reclaimedMemory);
+}
+
+} // namespace QtWebEngineCore
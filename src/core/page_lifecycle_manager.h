@@ -0,0 +1,84 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef PAGE_LIFECYCLE_MANAGER_H
+#define PAGE_LIFECYCLE_MANAGER_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include "base/memory/weak_ptr.h"
+
+#include <QHash>
+#include <QTimer>
+
+#include <chrono>
+#include <memory>
+
+namespace memory_instrumentation {
+class GlobalMemoryDump;
+}
+
+namespace QtWebEngineCore {
+
+class ProfileAdapter;
+class WebContentsAdapter;
+
+// Applies freeze and discard transitions to the hidden pages of a profile in
+// least-recently-used order, limited by what WebContentsAdapter::recommendedState()
+// considers safe.
+class Q_WEBENGINECORE_EXPORT PageLifecycleManager
+{
+public:
+    struct Policy {
+        bool enabled = false;
+        // Limit for the private memory footprint of the profile's renderers in bytes, 0 for none
+        qint64 memoryBudget = 0;
+        // Maximum number of pages in the Active state, 0 for no limit
+        int maximumActivePages = 0;
+        // Time a page has to be hidden before it is frozen or discarded, 0 to disable
+        std::chrono::milliseconds freezeTimeout { 0 };
+        std::chrono::milliseconds discardTimeout { 0 };
+    };
+
+    struct Statistics {
+        int frozenPages = 0;
+        int discardedPages = 0;
+        // Estimated memory released by discarding pages since the manager was enabled
+        qint64 reclaimedMemory = 0;
+    };
+
+    explicit PageLifecycleManager(ProfileAdapter *profileAdapter);
+    ~PageLifecycleManager();
+
+    const Policy &policy() const { return m_policy; }
+    void setPolicy(const Policy &policy);
+
+    const Statistics &statistics() const { return m_statistics; }
+
+private:
+    void update();
+    void onMemoryDump(bool success, std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump);
+    void applyPolicy(const QHash<qint64, qint64> &processFootprints);
+
+    ProfileAdapter *m_profileAdapter;
+    Policy m_policy;
+    Statistics m_statistics;
+    QTimer m_updateTimer;
+    bool m_memoryDumpPending = false;
+    base::WeakPtrFactory<PageLifecycleManager> m_weakPtrFactory { this };
+};
+
+} // namespace QtWebEngineCore
+
+#endif // PAGE_LIFECYCLE_MANAGER_H
@@ -0,0 +1,164 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "page_load_metrics_qt.h"
+
+#include "components/page_load_metrics/browser/metrics_web_contents_observer.h"
+#include "components/page_load_metrics/browser/page_load_metrics_observer_delegate.h"
+#include "components/page_load_metrics/browser/page_load_tracker.h"
+#include "content/browser/renderer_host/navigation_request.h"
+#include "content/public/browser/web_contents.h"
+#include "net/base/load_timing_info.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+
+#include "type_conversion.h"
+#include "web_contents_delegate_qt.h"
+
+namespace QtWebEngineCore {
+
+void initializePageLoadMetricsForWebContents(content::WebContents *webContents)
+{
+    page_load_metrics::MetricsWebContentsObserver::CreateForWebContents(
+            webContents, std::make_unique<PageLoadMetricsEmbedderQt>(webContents));
+}
+
+PageLoadMetricsEmbedderQt::PageLoadMetricsEmbedderQt(content::WebContents *webContents)
+    : page_load_metrics::PageLoadMetricsEmbedderBase(webContents)
+{
+}
+
+PageLoadMetricsEmbedderQt::~PageLoadMetricsEmbedderQt() = default;
+
+bool PageLoadMetricsEmbedderQt::IsNewTabPageUrl(const GURL &)
+{
+    return false;
+}
+
+bool PageLoadMetricsEmbedderQt::IsNoStatePrefetch(content::WebContents *)
+{
+    return false;
+}
+
+bool PageLoadMetricsEmbedderQt::IsExtensionUrl(const GURL &)
+{
+    return false;
+}
+
+bool PageLoadMetricsEmbedderQt::IsNonTabWebUI(const GURL &)
+{
+    return false;
+}
+
+page_load_metrics::PageLoadMetricsMemoryTracker *
+PageLoadMetricsEmbedderQt::GetMemoryTrackerForBrowserContext(content::BrowserContext *)
+{
+    return nullptr;
+}
+
+void PageLoadMetricsEmbedderQt::RegisterEmbedderObservers(page_load_metrics::PageLoadTracker *tracker)
+{
+    tracker->AddObserver(std::make_unique<PageLoadMetricsObserverQt>());
+}
+
+static qint64 durationBetween(base::TimeTicks start, base::TimeTicks end)
+{
+    if (start.is_null() || end.is_null())
+        return -1;
+    return (end - start).InMilliseconds();
+}
+
+template<typename Optional>
+static qint64 toMilliseconds(const Optional &delta)
+{
+    return delta ? delta->InMilliseconds() : -1;
+}
+
+PageLoadMetricsObserverQt::PageLoadMetricsObserverQt() = default;
+PageLoadMetricsObserverQt::~PageLoadMetricsObserverQt() = default;
+
+const char *PageLoadMetricsObserverQt::GetObserverName() const
+{
+    static const char kName[] = "PageLoadMetricsObserverQt";
+    return kName;
+}
+
+page_load_metrics::PageLoadMetricsObserver::ObservePolicy
+PageLoadMetricsObserverQt::OnFencedFramesStart(content::NavigationHandle *, const GURL &)
+{
+    return STOP_OBSERVING;
+}
+
+page_load_metrics::PageLoadMetricsObserver::ObservePolicy
+PageLoadMetricsObserverQt::OnPrerenderStart(content::NavigationHandle *, const GURL &)
+{
+    // Timings of prerendered pages are relative to the prerendering, not to the activation.
+    return STOP_OBSERVING;
+}
+
+page_load_metrics::PageLoadMetricsObserver::ObservePolicy
+PageLoadMetricsObserverQt::OnCommit(content::NavigationHandle *navigationHandle)
+{
+    m_metrics.url = toQt(navigationHandle->GetURL());
+    const network::mojom::URLResponseHead *response =
+            content::NavigationRequest::From(navigationHandle)->response();
+    if (!response)
+        return CONTINUE_OBSERVING;
+
+    const net::LoadTimingInfo::ConnectTiming &connectTiming = response->load_timing.connect_timing;
+    m_metrics.domainLookup = durationBetween(connectTiming.domain_lookup_start, connectTiming.domain_lookup_end);
+    m_metrics.connect = durationBetween(connectTiming.connect_start, connectTiming.connect_end);
+    m_metrics.tlsHandshake = durationBetween(connectTiming.ssl_start, connectTiming.ssl_end);
+    return CONTINUE_OBSERVING;
+}
+
+void PageLoadMetricsObserverQt::OnLoadEventStart(const page_load_metrics::mojom::PageLoadTiming &timing)
+{
+    report(timing, false);
+}
+
+page_load_metrics::PageLoadMetricsObserver::ObservePolicy
+PageLoadMetricsObserverQt::FlushMetricsOnAppEnterBackground(const page_load_metrics::mojom::PageLoadTiming &timing)
+{
+    report(timing, true);
+    return STOP_OBSERVING;
+}
+
+void PageLoadMetricsObserverQt::OnComplete(const page_load_metrics::mojom::PageLoadTiming &timing)
+{
+    report(timing, true);
+}
+
+void PageLoadMetricsObserverQt::report(const page_load_metrics::mojom::PageLoadTiming &timing, bool isFinal)
+{
+    if (m_reportedFinal)
+        return;
+    m_reportedFinal = isFinal;
+
+    // The page might be closing, in which case nobody is left to report to.
+    content::WebContents *webContents = GetDelegate().GetWebContents();
+    if (!webContents || webContents->IsBeingDestroyed() || !webContents->GetDelegate())
+        return;
+
+    m_metrics.timeToFirstByte = toMilliseconds(timing.response_start);
+    if (timing.paint_timing)
+        m_metrics.firstContentfulPaint = toMilliseconds(timing.paint_timing->first_contentful_paint);
+    if (timing.document_timing)
+        m_metrics.loadEventStart = toMilliseconds(timing.document_timing->load_event_start);
+    if (timing.interactive_timing)
+        m_metrics.firstInputDelay = toMilliseconds(timing.interactive_timing->first_input_delay);
+
+    const auto &largestContentfulPaint =
+            GetDelegate().GetLargestContentfulPaintHandler().MergeMainFrameAndSubframes();
+    if (largestContentfulPaint.ContainsValidTime())
+        m_metrics.largestContentfulPaint = toMilliseconds(largestContentfulPaint.Time());
+    m_metrics.cumulativeLayoutShift =
+            GetDelegate()
+                    .GetNormalizedCLSData(page_load_metrics::PageLoadMetricsObserverDelegate::BfcacheStrategy::ACCUMULATE)
+                    .session_windows_gap1000ms_max5000ms_max_cls;
+    m_metrics.isFinal = isFinal;
+
+    auto *delegate = static_cast<WebContentsDelegateQt *>(webContents->GetDelegate());
+    delegate->adapterClient()->pageLoadMetricsReported(m_metrics);
+}
+
+} // namespace QtWebEngineCore
@@ -0,0 +1,79 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef PAGE_LOAD_METRICS_QT_H
+#define PAGE_LOAD_METRICS_QT_H
+
+#include "components/page_load_metrics/browser/page_load_metrics_embedder_base.h"
+#include "components/page_load_metrics/browser/page_load_metrics_observer.h"
+
+#include "web_contents_adapter_client.h"
+
+namespace content {
+class WebContents;
+}
+
+namespace QtWebEngineCore {
+
+// Attaches Chromium's page load metrics collection to the given WebContents.
+void initializePageLoadMetricsForWebContents(content::WebContents *webContents);
+
+class PageLoadMetricsEmbedderQt : public page_load_metrics::PageLoadMetricsEmbedderBase
+{
+public:
+    explicit PageLoadMetricsEmbedderQt(content::WebContents *webContents);
+    ~PageLoadMetricsEmbedderQt() override;
+
+    // page_load_metrics::PageLoadMetricsEmbedderInterface
+    bool IsNewTabPageUrl(const GURL &url) override;
+    bool IsNoStatePrefetch(content::WebContents *webContents) override;
+    bool IsExtensionUrl(const GURL &url) override;
+    bool IsNonTabWebUI(const GURL &url) override;
+    page_load_metrics::PageLoadMetricsMemoryTracker *
+    GetMemoryTrackerForBrowserContext(content::BrowserContext *browserContext) override;
+
+protected:
+    // page_load_metrics::PageLoadMetricsEmbedderBase
+    void RegisterEmbedderObservers(page_load_metrics::PageLoadTracker *tracker) override;
+};
+
+// Reports the metrics of a page load to the WebContentsAdapterClient, once when the
+// load event fired, and finally when the page is left or the application is backgrounded.
+class PageLoadMetricsObserverQt : public page_load_metrics::PageLoadMetricsObserver
+{
+public:
+    PageLoadMetricsObserverQt();
+    ~PageLoadMetricsObserverQt() override;
+
+    // page_load_metrics::PageLoadMetricsObserver
+    const char *GetObserverName() const override;
+    ObservePolicy OnFencedFramesStart(content::NavigationHandle *navigationHandle,
+                                      const GURL &currentlyCommittedUrl) override;
+    ObservePolicy OnPrerenderStart(content::NavigationHandle *navigationHandle,
+                                   const GURL &currentlyCommittedUrl) override;
+    ObservePolicy OnCommit(content::NavigationHandle *navigationHandle) override;
+    void OnLoadEventStart(const page_load_metrics::mojom::PageLoadTiming &timing) override;
+    ObservePolicy FlushMetricsOnAppEnterBackground(const page_load_metrics::mojom::PageLoadTiming &timing) override;
+    void OnComplete(const page_load_metrics::mojom::PageLoadTiming &timing) override;
+
+private:
+    void report(const page_load_metrics::mojom::PageLoadTiming &timing, bool isFinal);
+
+    PageLoadMetrics m_metrics;
+    bool m_reportedFinal = false;
+};
+
+} // namespace QtWebEngineCore
+
+#endif // PAGE_LOAD_METRICS_QT_H
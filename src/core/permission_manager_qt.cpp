@@ -3,7 +3,6 @@
 
 #include "permission_manager_qt.h"
 
-#include "base/threading/thread_restrictions.h"
 #include "content/browser/renderer_host/render_view_host_delegate.h"
 #include "content/browser/web_contents/web_contents_impl.h"
 #include "content/public/browser/permission_controller.h"
@@ -188,7 +187,7 @@ PermissionManagerQt::PermissionManagerQt(ProfileAdapter *profileAdapter)
     , m_persistence(true)
 {
     PrefServiceFactory factory;
-    factory.set_async(false);
+    factory.set_async(true);
     factory.set_command_line_prefs(base::MakeRefCounted<ChromeCommandLinePrefStore>(
             base::CommandLine::ForCurrentProcess()));
 
@@ -222,10 +221,10 @@ PermissionManagerQt::PermissionManagerQt(ProfileAdapter *profileAdapter)
     if (policy == ProfileAdapter::PersistentPermissionsPolicy::AskEveryTime)
         m_persistence = false;
 
-    {
-        base::ScopedAllowBlocking allowBlock;
-        m_prefService = factory.Create(prefRegistry);
-    }
+    m_prefService = factory.Create(prefRegistry);
+    if (!isInitialized())
+        m_prefService->AddPrefInitObserver(
+                base::BindOnce(&PermissionManagerQt::onInitialized, base::Unretained(this)));
 }
 
 PermissionManagerQt::~PermissionManagerQt()
@@ -372,6 +371,35 @@ QList<QWebEnginePermission> PermissionManagerQt::listPermissions(const QUrl &ori
     return returnList;
 }
 
+bool PermissionManagerQt::isInitialized() const
+{
+    return m_prefService->GetInitializationStatus() != PrefService::INITIALIZATION_STATUS_WAITING;
+}
+
+void PermissionManagerQt::runWhenInitialized(base::OnceClosure callback)
+{
+    if (isInitialized())
+        std::move(callback).Run();
+    else
+        m_pendingTasks.push_back(std::move(callback));
+}
+
+void PermissionManagerQt::onInitialized(bool success)
+{
+    if (!success)
+        LOG(WARNING) << "Could not read the stored permissions, using defaults.";
+
+    std::vector<base::OnceClosure> writes;
+    writes.swap(m_pendingWrites);
+    for (auto &write : writes)
+        std::move(write).Run();
+
+    std::vector<base::OnceClosure> tasks;
+    tasks.swap(m_pendingTasks);
+    for (auto &task : tasks)
+        std::move(task).Run();
+}
+
 void PermissionManagerQt::commit()
 {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
@@ -585,6 +613,11 @@ void PermissionManagerQt::ResetPermission(
 
     ScopedDictPrefUpdate updater(m_prefService.get(), permissionTypeString(permissionType));
     updater.Get().Remove(requesting_origin.spec());
+
+    // Reading the store replaces whatever was changed before, apply it again then.
+    if (!isInitialized())
+        m_pendingWrites.push_back(base::BindOnce(&PermissionManagerQt::ResetPermission, base::Unretained(this),
+                                                 permission, requesting_origin, GURL()));
 }
 
 content::PermissionControllerDelegate::SubscriptionId
@@ -643,6 +676,10 @@ void PermissionManagerQt::setPersistentPermission(
     updater.Get().Set(requesting_origin.spec(), granted);
 
     m_prefService->SchedulePendingLossyWrites();
+
+    if (!isInitialized())
+        m_pendingWrites.push_back(base::BindOnce(&PermissionManagerQt::setPersistentPermission, base::Unretained(this),
+                                                 permission, requesting_origin, granted));
 }
 
 void PermissionManagerQt::setTransientPermission(blink::PermissionType permission,
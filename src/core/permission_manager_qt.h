@@ -35,6 +35,10 @@ public:
     QList<QWebEnginePermission> listPermissions(const QUrl &origin, QWebEnginePermission::PermissionType permissionType);
 
     void commit();
+    // The permissions store is read asynchronously, \a callback runs once it
+    // has been loaded, or immediately if it already is.
+    bool isInitialized() const;
+    void runWhenInitialized(base::OnceClosure callback);
 
     // content::PermissionManager implementation:
     blink::mojom::PermissionStatus GetPermissionStatus(
@@ -106,6 +110,8 @@ private:
         bool granted,
         content::GlobalRenderFrameHostToken token);
 
+    void onInitialized(bool success);
+
     void resetTransientPermission(blink::PermissionType permission,
         const GURL& requesting_origin,
         content::GlobalRenderFrameHostToken token);
@@ -120,6 +126,9 @@ private:
     int m_requestIdCount;
     int m_transientWriteCount;
     std::unique_ptr<PrefService> m_prefService;
+    // Changes made while loading, applied again before m_pendingTasks run.
+    std::vector<base::OnceClosure> m_pendingWrites;
+    std::vector<base::OnceClosure> m_pendingTasks;
     QPointer<QtWebEngineCore::ProfileAdapter> m_profileAdapter;
     bool m_persistence;
 };
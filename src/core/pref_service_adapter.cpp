@@ -9,7 +9,6 @@
 #include "web_engine_library_info.h"
 
 #include "base/base_paths.h"
-#include "base/threading/thread_restrictions.h"
 #include "chrome/browser/prefs/chrome_command_line_pref_store.h"
 #include "content/public/browser/browser_thread.h"
 #include "components/autofill/core/common/autofill_prefs.h"
@@ -61,6 +60,9 @@ void PrefServiceAdapter::setup(const ProfileAdapter &profileAdapter)
 {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
     PrefServiceFactory factory;
+    // Read the stores on the JsonPrefStore's background sequence instead of
+    // blocking the UI thread; see onInitialized().
+    factory.set_async(true);
     factory.set_command_line_prefs(base::MakeRefCounted<ChromeCommandLinePrefStore>(
             base::CommandLine::ForCurrentProcess()));
 
@@ -142,10 +144,21 @@ void PrefServiceAdapter::setup(const ProfileAdapter &profileAdapter)
     registry->RegisterDictionaryPref(prefs::kDevToolsSyncedPreferencesSyncDisabled);
     registry->RegisterDictionaryPref(prefs::kDevToolsSyncedPreferencesSyncEnabled);
 
-    {
-        base::ScopedAllowBlocking allowBlock;
-        m_prefService = factory.Create(registry);
+    m_prefService = factory.Create(registry);
+
+    if (isInitialized()) {
+        onInitialized(m_prefService->GetInitializationStatus() != PrefService::INITIALIZATION_STATUS_ERROR);
+        return;
     }
+    m_prefService->AddPrefInitObserver(
+            base::BindOnce(&PrefServiceAdapter::onInitialized, base::Unretained(this)));
+}
+
+void PrefServiceAdapter::onInitialized(bool success)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    if (!success)
+        LOG(WARNING) << "Could not read the stored user preferences, using defaults.";
 
 #if QT_CONFIG(webengine_spellchecker)
     // Ignore stored values for these options to preserve backwards compatibility.
@@ -154,6 +167,30 @@ void PrefServiceAdapter::setup(const ProfileAdapter &profileAdapter)
 #endif // QT_CONFIG(webengine_spellchecker)
 
     m_prefService->SchedulePendingLossyWrites();
+
+    std::vector<base::OnceClosure> writes;
+    writes.swap(m_pendingWrites);
+    for (auto &write : writes)
+        std::move(write).Run();
+
+    std::vector<base::OnceClosure> tasks;
+    tasks.swap(m_pendingTasks);
+    for (auto &task : tasks)
+        std::move(task).Run();
+}
+
+bool PrefServiceAdapter::isInitialized() const
+{
+    return m_prefService
+            && m_prefService->GetInitializationStatus() != PrefService::INITIALIZATION_STATUS_WAITING;
+}
+
+void PrefServiceAdapter::runWhenInitialized(base::OnceClosure callback)
+{
+    if (isInitialized())
+        std::move(callback).Run();
+    else
+        m_pendingTasks.push_back(std::move(callback));
 }
 
 void PrefServiceAdapter::commit()
@@ -190,6 +227,11 @@ void PrefServiceAdapter::setSpellCheckLanguages(const QStringList &languages)
         dictionaries.push_back(language.toStdString());
     dictionaries_pref.SetValue(dictionaries);
     m_prefService->SchedulePendingLossyWrites();
+
+    // Reading the store replaces whatever was set before, apply it again then.
+    if (!isInitialized())
+        m_pendingWrites.push_back(base::BindOnce(&PrefServiceAdapter::setSpellCheckLanguages,
+                                                 base::Unretained(this), languages));
 }
 
 QStringList PrefServiceAdapter::spellCheckLanguages() const
@@ -208,6 +250,9 @@ void PrefServiceAdapter::setSpellCheckEnabled(bool enabled)
     if (!WebEngineLibraryInfo::getPath(base::DIR_APP_DICTIONARIES, true).empty()) {
         m_prefService->SetBoolean(spellcheck::prefs::kSpellCheckEnable, enabled);
         m_prefService->SchedulePendingLossyWrites();
+        if (!isInitialized())
+            m_pendingWrites.push_back(base::BindOnce(&PrefServiceAdapter::setSpellCheckEnabled,
+                                                     base::Unretained(this), enabled));
     }
 }
 
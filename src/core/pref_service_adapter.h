@@ -4,9 +4,12 @@
 #ifndef PREF_SERVICE_ADAPTER_H
 #define PREF_SERVICE_ADAPTER_H
 
+#include "base/functional/callback.h"
 #include "components/prefs/pref_service.h"
 #include "qtwebenginecoreglobal_p.h"
 
+#include <vector>
+
 namespace QtWebEngineCore {
 
 class ProfileAdapter;
@@ -22,6 +25,10 @@ public:
 
     void setup(const ProfileAdapter &adapter);
     void commit();
+    // The user preference store is read asynchronously, \a callback runs once
+    // it has been loaded, or immediately if it already is.
+    bool isInitialized() const;
+    void runWhenInitialized(base::OnceClosure callback);
     PrefService *prefService();
     const PrefService *prefService() const;
     std::string mediaDeviceIdSalt() const;
@@ -34,7 +41,12 @@ public:
 #endif // QT_CONFIG(webengine_spellchecker)
 
 private:
+    void onInitialized(bool success);
+
     std::unique_ptr<PrefService> m_prefService;
+    // Changes made while loading, applied again before m_pendingTasks run.
+    std::vector<base::OnceClosure> m_pendingWrites;
+    std::vector<base::OnceClosure> m_pendingTasks;
 };
 
 }
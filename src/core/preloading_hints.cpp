@@ -0,0 +1,264 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "preloading_hints.h"
+
+#include "base/functional/bind.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/storage_partition.h"
+#include "mojo/public/cpp/bindings/receiver.h"
+#include "net/base/isolation_info.h"
+#include "net/base/load_flags.h"
+#include "net/base/load_timing_info.h"
+#include "net/base/net_errors.h"
+#include "net/base/network_anonymization_key.h"
+#include "net/base/schemeful_site.h"
+#include "net/cookies/site_for_cookies.h"
+#include "net/http/http_response_headers.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+#include "services/network/public/cpp/resolve_host_client_base.h"
+#include "services/network/public/cpp/resource_request.h"
+#include "services/network/public/cpp/simple_url_loader.h"
+#include "services/network/public/mojom/network_context.mojom.h"
+#include "services/network/public/mojom/url_response_head.mojom.h"
+#include "third_party/blink/public/mojom/loader/resource_load_info.mojom.h"
+#include "url/origin.h"
+
+#include "profile_adapter.h"
+#include "profile_qt.h"
+
+namespace QtWebEngineCore {
+
+using namespace std::chrono_literals;
+
+// Matches the minimum lifetime of host cache entries and idle sockets in the network stack.
+static constexpr auto kHintLifetime = 1min;
+static constexpr auto kPrefetchHintLifetime = 5min;
+static constexpr auto kExpiryInterval = 5s;
+// Larger responses are not worth keeping a prefetch for.
+static constexpr size_t kMaxPrefetchSize = 10 * 1024 * 1024;
+
+static net::NetworkAnonymizationKey anonymizationKeyForUrl(const GURL &url)
+{
+    // Hints target navigations to the URL, which partition the network state by its site.
+    return net::NetworkAnonymizationKey::CreateSameSite(net::SchemefulSite(url));
+}
+
+// A socket handed out without connecting first was either preconnected or reused.
+static bool usedConnectedSocket(const net::LoadTimingInfo &timing)
+{
+    return timing.socket_reused || timing.connect_timing.connect_start.is_null();
+}
+
+namespace {
+
+class ResolveHostClient : public network::ResolveHostClientBase
+{
+public:
+    using Callback = base::OnceCallback<void(int result)>;
+
+    static mojo::PendingRemote<network::mojom::ResolveHostClient> create(Callback callback)
+    {
+        auto *client = new ResolveHostClient(std::move(callback));
+        auto remote = client->m_receiver.BindNewPipeAndPassRemote();
+        client->m_receiver.set_disconnect_handler(
+                base::BindOnce(&ResolveHostClient::finish, base::Unretained(client), net::ERR_FAILED));
+        return remote;
+    }
+
+    void OnComplete(int result, const net::ResolveErrorInfo &,
+                    const absl::optional<net::AddressList> &,
+                    const absl::optional<net::HostResolverEndpointResults> &) override
+    {
+        finish(result);
+    }
+
+private:
+    explicit ResolveHostClient(Callback callback) : m_callback(std::move(callback)) { }
+
+    void finish(int result)
+    {
+        std::move(m_callback).Run(result);
+        delete this;
+    }
+
+    Callback m_callback;
+    mojo::Receiver<network::mojom::ResolveHostClient> m_receiver { this };
+};
+
+} // namespace
+
+PreloadingHints::PreloadingHints(ProfileAdapter *profileAdapter)
+    : m_profileAdapter(profileAdapter)
+{
+    m_expiryTimer.setInterval(kExpiryInterval);
+    QObject::connect(&m_expiryTimer, &QTimer::timeout, [this]() { expireHints(); });
+}
+
+PreloadingHints::~PreloadingHints() = default;
+
+void PreloadingHints::preresolve(const GURL &url, ResultCallback callback)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    const quint64 id = addHint(Type::Preresolve, url, std::move(callback));
+    if (!m_hints.count(id))
+        return;
+
+    auto parameters = network::mojom::ResolveHostParameters::New();
+    parameters->initial_priority = net::RequestPriority::IDLE;
+    parameters->is_speculative = true;
+    m_profileAdapter->profile()->GetDefaultStoragePartition()->GetNetworkContext()->ResolveHost(
+            network::mojom::HostResolverHost::NewSchemeHostPort(url::SchemeHostPort(url)),
+            anonymizationKeyForUrl(url), std::move(parameters),
+            ResolveHostClient::create(
+                    base::BindOnce(&PreloadingHints::onResolved, m_weakPtrFactory.GetWeakPtr(), id)));
+}
+
+void PreloadingHints::preconnect(const GURL &url, ResultCallback callback)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    const quint64 id = addHint(Type::Preconnect, url, std::move(callback));
+    if (!m_hints.count(id))
+        return;
+
+    // Also resolves the host, and for https URLs completes the TLS handshake.
+    m_profileAdapter->profile()->GetDefaultStoragePartition()->GetNetworkContext()->PreconnectSockets(
+            1, url, network::mojom::CredentialsMode::kInclude, anonymizationKeyForUrl(url));
+}
+
+void PreloadingHints::prefetch(const GURL &url, ResultCallback callback)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    const quint64 id = addHint(Type::Prefetch, url, std::move(callback));
+    auto it = m_hints.find(id);
+    if (it == m_hints.end())
+        return;
+
+    net::NetworkTrafficAnnotationTag traffic_annotation =
+        net::DefineNetworkTrafficAnnotation(
+            "PreloadingHints::prefetch", R"(
+            semantics {
+              sender: "Application"
+              description:
+                "Application requested prefetching a resource into the HTTP cache"
+              trigger: "Application."
+              data: "None."
+              destination: OTHER
+            }
+            policy {
+              cookies_allowed: YES
+              cookies_store: "user"
+              setting:
+                "It's possible not to use this feature."
+            })");
+
+    const url::Origin origin = url::Origin::Create(url);
+    auto request = std::make_unique<network::ResourceRequest>();
+    request->url = url;
+    request->priority = net::RequestPriority::IDLE;
+    request->load_flags = net::LOAD_PREFETCH;
+    request->credentials_mode = network::mojom::CredentialsMode::kInclude;
+    request->site_for_cookies = net::SiteForCookies::FromOrigin(origin);
+    request->trusted_params = network::ResourceRequest::TrustedParams();
+    // Use the cache partition of a page of the same site, which is where a later load looks.
+    request->trusted_params->isolation_info = net::IsolationInfo::Create(
+            net::IsolationInfo::RequestType::kOther, origin, origin, request->site_for_cookies);
+
+    it->second.loader = network::SimpleURLLoader::Create(std::move(request), traffic_annotation);
+    it->second.loader->DownloadToString(
+            m_profileAdapter->profile()->GetDefaultStoragePartition()->GetURLLoaderFactoryForBrowserProcess().get(),
+            base::BindOnce(&PreloadingHints::onPrefetched, m_weakPtrFactory.GetWeakPtr(), id),
+            kMaxPrefetchSize);
+}
+
+void PreloadingHints::resourceLoaded(const blink::mojom::ResourceLoadInfo &info)
+{
+    if (m_hints.empty() || info.net_error != net::OK)
+        return;
+
+    const GURL &url = info.final_url;
+    std::vector<std::pair<quint64, bool>> results;
+    for (const auto &[id, hint] : m_hints) {
+        switch (hint.type) {
+        case Type::Preresolve:
+            if (url.host_piece() == hint.url.host_piece())
+                results.emplace_back(id, true);
+            break;
+        case Type::Preconnect:
+            // Responses from the cache say nothing about the connection.
+            if (!info.was_cached && url::Origin::Create(url).IsSameOriginWith(hint.url))
+                results.emplace_back(id, usedConnectedSocket(info.load_timing_info));
+            break;
+        case Type::Prefetch:
+            if (url.GetWithoutRef() == hint.url.GetWithoutRef()
+                || info.original_url.GetWithoutRef() == hint.url.GetWithoutRef())
+                results.emplace_back(id, info.was_cached);
+            break;
+        }
+    }
+    for (const auto &[id, used] : results)
+        finishHint(id, used);
+}
+
+quint64 PreloadingHints::addHint(Type type, const GURL &url, ResultCallback callback)
+{
+    const quint64 id = ++m_nextId;
+    if (!url.SchemeIsHTTPOrHTTPS()) {
+        if (callback)
+            callback(false);
+        return id;
+    }
+
+    const auto lifetime = type == Type::Prefetch ? kPrefetchHintLifetime : kHintLifetime;
+    m_hints.emplace(id, Hint { type, url, std::move(callback), std::chrono::steady_clock::now() + lifetime, nullptr });
+    if (!m_expiryTimer.isActive())
+        m_expiryTimer.start();
+    return id;
+}
+
+void PreloadingHints::finishHint(quint64 id, bool used)
+{
+    auto it = m_hints.find(id);
+    if (it == m_hints.end())
+        return;
+    ResultCallback callback = std::move(it->second.callback);
+    m_hints.erase(it);
+    if (m_hints.empty())
+        m_expiryTimer.stop();
+    if (callback)
+        callback(used);
+}
+
+void PreloadingHints::onResolved(quint64 id, int result)
+{
+    if (result != net::OK)
+        finishHint(id, false);
+}
+
+void PreloadingHints::onPrefetched(quint64 id, std::unique_ptr<std::string> body)
+{
+    auto it = m_hints.find(id);
+    if (it == m_hints.end())
+        return;
+
+    std::unique_ptr<network::SimpleURLLoader> loader = std::move(it->second.loader);
+    const auto *responseInfo = loader->ResponseInfo();
+    const bool cached = body && responseInfo && responseInfo->headers
+            && responseInfo->headers->response_code() / 100 == 2;
+    if (!cached)
+        finishHint(id, false);
+}
+
+void PreloadingHints::expireHints()
+{
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<quint64> expired;
+    for (const auto &[id, hint] : m_hints) {
+        if (hint.expiry <= now)
+            expired.push_back(id);
+    }
+    for (quint64 id : expired)
+        finishHint(id, false);
+}
+
+} // namespace QtWebEngineCore
@@ -0,0 +1,84 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef PRELOADING_HINTS_H
+#define PRELOADING_HINTS_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include "base/memory/weak_ptr.h"
+#include "url/gurl.h"
+
+#include <QTimer>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+
+namespace blink::mojom {
+class ResourceLoadInfo;
+}
+
+namespace network {
+class SimpleURLLoader;
+}
+
+namespace QtWebEngineCore {
+
+class ProfileAdapter;
+
+// Warms up the network stack of a profile for URLs that are likely to be loaded next,
+// and reports for each hint whether a later load of a page of the profile made use of it.
+class Q_WEBENGINECORE_EXPORT PreloadingHints
+{
+public:
+    using ResultCallback = std::function<void(bool used)>;
+
+    explicit PreloadingHints(ProfileAdapter *profileAdapter);
+    ~PreloadingHints();
+
+    void preresolve(const GURL &url, ResultCallback callback);
+    void preconnect(const GURL &url, ResultCallback callback);
+    void prefetch(const GURL &url, ResultCallback callback);
+
+    // Called for every resource loaded by a page of the profile.
+    void resourceLoaded(const blink::mojom::ResourceLoadInfo &info);
+
+private:
+    enum class Type { Preresolve, Preconnect, Prefetch };
+    struct Hint {
+        Type type;
+        GURL url;
+        ResultCallback callback;
+        std::chrono::steady_clock::time_point expiry;
+        std::unique_ptr<network::SimpleURLLoader> loader;
+    };
+
+    quint64 addHint(Type type, const GURL &url, ResultCallback callback);
+    void finishHint(quint64 id, bool used);
+    void onResolved(quint64 id, int result);
+    void onPrefetched(quint64 id, std::unique_ptr<std::string> body);
+    void expireHints();
+
+    ProfileAdapter *m_profileAdapter;
+    std::map<quint64, Hint> m_hints;
+    quint64 m_nextId = 0;
+    QTimer m_expiryTimer;
+    base::WeakPtrFactory<PreloadingHints> m_weakPtrFactory { this };
+};
+
+} // namespace QtWebEngineCore
+
+#endif // PRELOADING_HINTS_H
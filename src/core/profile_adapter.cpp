@@ -22,13 +22,19 @@
 #include "api/qwebengineurlscheme.h"
 #include "content_browser_client_qt.h"
 #include "download_manager_delegate_qt.h"
+#include "download_throttle.h"
 #include "favicon_driver_qt.h"
+#include "favicon_lookup.h"
 #include "favicon_service_factory_qt.h"
+#include "history_restore_scheduler.h"
+#include "page_lifecycle_manager.h"
 #include "permission_manager_qt.h"
+#include "preloading_hints.h"
 #include "profile_adapter_client.h"
 #include "profile_io_data_qt.h"
 #include "profile_qt.h"
 #include "renderer_host/user_resource_controller_host.h"
+#include "spare_render_process_manager.h"
 #include "type_conversion.h"
 #include "visited_links_manager_qt.h"
 #include "web_contents_adapter_client.h"
@@ -76,12 +82,17 @@ ProfileAdapter::ProfileAdapter(const QString &storageName):
     m_customUrlSchemeHandlers.insert(QByteArrayLiteral("qrc"), &m_qrcHandler);
     m_cancelableTaskTracker.reset(new base::CancelableTaskTracker());
 
-    m_profile->DoFinalInit();
+    // Push subscriptions are kept in the preference store.
+    runWhenReady([this] { m_profile->DoFinalInit(); });
 }
 
 ProfileAdapter::~ProfileAdapter()
 {
     m_cancelableTaskTracker->TryCancelAll();
+    m_pageLifecycleManager.reset();
+    m_historyRestoreScheduler.reset();
+    m_preloadingHints.reset();
+    m_spareRenderProcessManager.reset();
     m_profile->NotifyWillBeDestroyed();
     releaseAllWebContentsAdapterClients();
 
@@ -90,6 +101,7 @@ ProfileAdapter::~ProfileAdapter()
         m_profile->GetDownloadManager()->Shutdown();
         m_downloadManagerDelegate.reset();
     }
+    m_downloadThrottle.reset();
 #if QT_CONFIG(ssl)
     delete m_clientCertificateStore;
     m_clientCertificateStore = nullptr;
@@ -230,6 +242,13 @@ void ProfileAdapter::acceptDownload(quint32 downloadId, bool accepted, bool useD
         downloadManagerDelegate()->savePathDetermined(downloadId, accepted, path, savePageFormat);
 }
 
+void ProfileAdapter::setDownloadSink(quint32 downloadId,
+                                     std::optional<QCryptographicHash::Algorithm> hashAlgorithm,
+                                     QIODevice *device)
+{
+    downloadManagerDelegate()->setDownloadSink(downloadId, hashAlgorithm, device);
+}
+
 ProfileAdapter *ProfileAdapter::createDefaultProfileAdapter()
 {
     return WebEngineContext::current()->createDefaultProfileAdapter();
@@ -792,6 +811,82 @@ void ProfileAdapter::removeWebContentsAdapterClient(WebContentsAdapterClient *cl
     m_webContentsAdapterClients.removeAll(client);
 }
 
+PageLifecycleManager *ProfileAdapter::pageLifecycleManager()
+{
+    if (!m_pageLifecycleManager)
+        m_pageLifecycleManager.reset(new PageLifecycleManager(this));
+    return m_pageLifecycleManager.get();
+}
+
+HistoryRestoreScheduler *ProfileAdapter::historyRestoreScheduler()
+{
+    if (!m_historyRestoreScheduler)
+        m_historyRestoreScheduler.reset(new HistoryRestoreScheduler(this));
+    return m_historyRestoreScheduler.get();
+}
+
+DownloadThrottle *ProfileAdapter::downloadThrottle()
+{
+    if (!m_downloadThrottle)
+        m_downloadThrottle.reset(new DownloadThrottle(this));
+    return m_downloadThrottle.get();
+}
+
+PreloadingHints *ProfileAdapter::preloadingHints()
+{
+    if (!m_preloadingHints)
+        m_preloadingHints.reset(new PreloadingHints(this));
+    return m_preloadingHints.get();
+}
+
+void ProfileAdapter::runWhenReady(std::function<void()> &&task)
+{
+    if (isReady()) {
+        task();
+        return;
+    }
+    m_readyTasks.append(std::move(task));
+}
+
+void ProfileAdapter::storageLoadStarted(StorageComponent component)
+{
+    m_pendingStorage |= component;
+}
+
+void ProfileAdapter::storageLoadFinished(StorageComponent component)
+{
+    if (!(m_pendingStorage & component))
+        return;
+    m_pendingStorage &= ~quint8(component);
+    if (!isReady())
+        return;
+
+    for (ProfileAdapterClient *client : std::as_const(m_clients))
+        client->profileReady();
+
+    const auto tasks = std::exchange(m_readyTasks, {});
+    for (qsizetype i = 0; i < tasks.size(); ++i) {
+        if (!isReady()) {
+            // A task moved the storage elsewhere, wait for it to be loaded again.
+            m_readyTasks = tasks.mid(i) + m_readyTasks;
+            return;
+        }
+        tasks.at(i)();
+    }
+}
+
+void ProfileAdapter::setSpareRenderProcessEnabled(bool enabled)
+{
+    if (enabled == isSpareRenderProcessEnabled())
+        return;
+    if (!enabled) {
+        m_spareRenderProcessManager.reset();
+        return;
+    }
+    m_spareRenderProcessManager.reset(new SpareRenderProcessManager(this));
+    m_spareRenderProcessManager->warmUp();
+}
+
 void ProfileAdapter::releaseAllWebContentsAdapterClients()
 {
     while (!m_webContentsAdapterClients.isEmpty())
@@ -859,78 +954,54 @@ QWebEngineClientCertificateStore *ProfileAdapter::clientCertificateStore()
 }
 #endif
 
-static void callbackOnIconAvailableForPageURL(std::function<void (const QIcon &, const QUrl &, const QUrl &)> iconAvailableCallback,
-                                              const QUrl &pageUrl,
-                                              const favicon_base::FaviconRawBitmapResult &result)
+static favicon_base::IconTypeSet iconTypes(bool touchIconsEnabled)
 {
-    if (!result.is_valid()) {
-        iconAvailableCallback(QIcon(), toQt(result.icon_url), pageUrl);
-        return;
+    favicon_base::IconTypeSet types = { favicon_base::IconType::kFavicon };
+    if (touchIconsEnabled) {
+        types.insert(favicon_base::IconType::kTouchIcon);
+        types.insert(favicon_base::IconType::kTouchPrecomposedIcon);
+        types.insert(favicon_base::IconType::kWebManifestIcon);
     }
-    QPixmap pixmap(toQt(result.pixel_size));
-    pixmap.loadFromData(result.bitmap_data->data(), result.bitmap_data->size());
-    iconAvailableCallback(QIcon(pixmap), toQt(result.icon_url), pageUrl);
+    return types;
+}
+
+static QIcon toIcon(const QImage &image)
+{
+    return image.isNull() ? QIcon() : QIcon(QPixmap::fromImage(image));
 }
 
 void ProfileAdapter::requestIconForPageURL(const QUrl &pageUrl,
                                            int desiredSizeInPixel,
                                            bool touchIconsEnabled,
                                            std::function<void (const QIcon &, const QUrl &, const QUrl &)> iconAvailableCallback)
+{
+    requestIconsForPageURLs({ pageUrl }, desiredSizeInPixel, touchIconsEnabled, std::move(iconAvailableCallback));
+}
+
+void ProfileAdapter::requestIconsForPageURLs(const QList<QUrl> &pageUrls,
+                                             int desiredSizeInPixel,
+                                             bool touchIconsEnabled,
+                                             std::function<void (const QIcon &, const QUrl &, const QUrl &)> iconAvailableCallback)
 {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
     favicon::FaviconService *service = FaviconServiceFactoryQt::GetForBrowserContext(m_profile.data());
 
     if (!service->HistoryService()) {
-        callbackOnIconAvailableForPageURL(iconAvailableCallback, pageUrl,
-                                          favicon_base::FaviconRawBitmapResult());
+        for (const QUrl &pageUrl : pageUrls)
+            iconAvailableCallback(QIcon(), QUrl(), pageUrl);
         return;
     }
 
-    favicon_base::IconTypeSet types = { favicon_base::IconType::kFavicon };
-    if (touchIconsEnabled) {
-        types.insert(favicon_base::IconType::kTouchIcon);
-        types.insert(favicon_base::IconType::kTouchPrecomposedIcon);
-        types.insert(favicon_base::IconType::kWebManifestIcon);
-    }
-    service->GetRawFaviconForPageURL(
-            toGurl(pageUrl), types, desiredSizeInPixel, true /* fallback_to_host */,
-            base::BindOnce(&callbackOnIconAvailableForPageURL, iconAvailableCallback, pageUrl),
+    lookupFaviconsForPageUrls(
+            service->HistoryService(), pageUrls, iconTypes(touchIconsEnabled), desiredSizeInPixel,
+            base::BindOnce([](std::function<void (const QIcon &, const QUrl &, const QUrl &)> iconAvailableCallback,
+                              std::vector<FaviconLookupResult> results) {
+                for (const FaviconLookupResult &result : results)
+                    iconAvailableCallback(toIcon(result.image), result.iconUrl, result.pageUrl);
+            }, std::move(iconAvailableCallback)),
             m_cancelableTaskTracker.get());
 }
 
-static void callbackOnIconAvailableForIconURL(std::function<void (const QIcon &, const QUrl &)> iconAvailableCallback,
-                                              ProfileAdapter *profileAdapter,
-                                              const QUrl &iconUrl, int iconType,
-                                              int desiredSizeInPixel,
-                                              bool touchIconsEnabled,
-                                              const favicon_base::FaviconRawBitmapResult &result)
-{
-    if (!result.is_valid()) {
-        // If touch icons are disabled there is no need to try further icon types.
-        if (!touchIconsEnabled) {
-            iconAvailableCallback(QIcon(), iconUrl);
-            return;
-        }
-        if (static_cast<favicon_base::IconType>(iconType) != favicon_base::IconType::kMax) {
-            //Q_ASSERT(profileAdapter->profile());
-            favicon::FaviconService *service = FaviconServiceFactoryQt::GetForBrowserContext(profileAdapter->profile());
-            service->GetRawFavicon(toGurl(iconUrl),
-                                   static_cast<favicon_base::IconType>(iconType + 1),
-                                   desiredSizeInPixel,
-                                   base::BindOnce(&callbackOnIconAvailableForIconURL, iconAvailableCallback,
-                                                  profileAdapter, iconUrl, iconType + 1, desiredSizeInPixel,
-                                                  touchIconsEnabled),
-                                   profileAdapter->cancelableTaskTracker());
-            return;
-        }
-        iconAvailableCallback(QIcon(), iconUrl);
-        return;
-    }
-    QPixmap pixmap(toQt(result.pixel_size));
-    pixmap.loadFromData(result.bitmap_data->data(), result.bitmap_data->size());
-    iconAvailableCallback(QIcon(pixmap), toQt(result.icon_url));
-}
-
 void ProfileAdapter::requestIconForIconURL(const QUrl &iconUrl,
                                            int desiredSizeInPixel,
                                            bool touchIconsEnabled,
@@ -940,19 +1011,18 @@ void ProfileAdapter::requestIconForIconURL(const QUrl &iconUrl,
     favicon::FaviconService *service = FaviconServiceFactoryQt::GetForBrowserContext(m_profile.data());
 
     if (!service->HistoryService()) {
-        callbackOnIconAvailableForIconURL(iconAvailableCallback,
-                                          this,
-                                          iconUrl,
-                                          static_cast<int>(favicon_base::IconType::kMax), 0,
-                                          touchIconsEnabled,
-                                          favicon_base::FaviconRawBitmapResult());
+        iconAvailableCallback(QIcon(), iconUrl);
         return;
     }
-    service->GetRawFavicon(
-            toGurl(iconUrl), favicon_base::IconType::kFavicon, desiredSizeInPixel,
-            base::BindOnce(&callbackOnIconAvailableForIconURL, iconAvailableCallback, this, iconUrl,
-                           static_cast<int>(favicon_base::IconType::kFavicon), desiredSizeInPixel,
-                           touchIconsEnabled),
+
+    // The icon types are tried in order within one task, without touch icons only kFavicon is.
+    lookupFaviconForIconUrl(
+            service->HistoryService(), iconUrl, iconTypes(touchIconsEnabled), desiredSizeInPixel,
+            base::BindOnce([](std::function<void (const QIcon &, const QUrl &)> iconAvailableCallback,
+                              std::vector<FaviconLookupResult> results) {
+                const FaviconLookupResult &result = results.front();
+                iconAvailableCallback(toIcon(result.image), result.iconUrl);
+            }, std::move(iconAvailableCallback)),
             m_cancelableTaskTracker.get());
 }
 
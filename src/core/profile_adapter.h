@@ -17,6 +17,7 @@
 
 #include <QtWebEngineCore/private/qtwebenginecoreglobal_p.h>
 
+#include <QCryptographicHash>
 #include <QHash>
 #include <QList>
 #include <QPointer>
@@ -31,6 +32,10 @@
 #include <QtWebEngineCore/qwebenginepermission.h>
 #include "net/qrc_url_scheme_handler.h"
 
+#include <functional>
+#include <optional>
+
+QT_FORWARD_DECLARE_CLASS(QIODevice)
 QT_FORWARD_DECLARE_CLASS(QObject)
 
 namespace base {
@@ -45,6 +50,11 @@ namespace QtWebEngineCore {
 
 class UserNotificationController;
 class DownloadManagerDelegateQt;
+class DownloadThrottle;
+class HistoryRestoreScheduler;
+class PageLifecycleManager;
+class PreloadingHints;
+class SpareRenderProcessManager;
 class ProfileAdapterClient;
 class ProfileQt;
 class UserResourceControllerHost;
@@ -80,6 +90,9 @@ public:
     void acceptDownload(quint32 downloadId, bool accepted,
                         bool useDownloadTargetCallback, const QString &path,
                         int savePageFormat);
+    void setDownloadSink(quint32 downloadId,
+                         std::optional<QCryptographicHash::Algorithm> hashAlgorithm,
+                         QIODevice *device);
 
     ProfileQt *profile();
     bool ensureDataPathExists();
@@ -115,6 +128,28 @@ public:
     void addWebContentsAdapterClient(WebContentsAdapterClient *client);
     void removeWebContentsAdapterClient(WebContentsAdapterClient *client);
     void releaseAllWebContentsAdapterClients();
+    const QList<WebContentsAdapterClient *> &webContentsAdapterClients() const { return m_webContentsAdapterClients; }
+
+    PageLifecycleManager *pageLifecycleManager();
+    HistoryRestoreScheduler *historyRestoreScheduler();
+    DownloadThrottle *downloadThrottle();
+    PreloadingHints *preloadingHints();
+
+    // The preference and permission stores are read on a background sequence.
+    // Until both have been loaded the profile is not ready, and work that
+    // depends on their contents, such as navigations, is queued.
+    enum StorageComponent : quint8 {
+        PreferenceStorage = 0x1,
+        PermissionStorage = 0x2
+    };
+    bool isReady() const { return !m_pendingStorage; }
+    void runWhenReady(std::function<void()> &&task);
+    void storageLoadStarted(StorageComponent component);
+    void storageLoadFinished(StorageComponent component);
+
+    bool isSpareRenderProcessEnabled() const { return bool(m_spareRenderProcessManager); }
+    void setSpareRenderProcessEnabled(bool enabled);
+    SpareRenderProcessManager *spareRenderProcessManager() const { return m_spareRenderProcessManager.get(); }
 
     // KEEP IN SYNC with API or add mapping layer
     enum HttpCacheType {
@@ -141,6 +176,12 @@ public:
         StoreOnDisk,
     };
 
+    enum class HistoryRestorePolicy : quint8 {
+        Immediate = 0,
+        OnDemand,
+        Background,
+    };
+
     enum ClientHint : uchar {
         UAArchitecture,
         UAPlatform,
@@ -162,6 +203,9 @@ public:
     PersistentPermissionsPolicy persistentPermissionsPolicy() const;
     void setPersistentPermissionsPolicy(ProfileAdapter::PersistentPermissionsPolicy);
 
+    HistoryRestorePolicy historyRestorePolicy() const { return m_historyRestorePolicy; }
+    void setHistoryRestorePolicy(HistoryRestorePolicy policy) { m_historyRestorePolicy = policy; }
+
     VisitedLinksPolicy visitedLinksPolicy() const;
     void setVisitedLinksPolicy(ProfileAdapter::VisitedLinksPolicy);
 
@@ -212,6 +256,8 @@ public:
 
     void requestIconForPageURL(const QUrl &pageUrl, int desiredSizeInPixel, bool touchIconsEnabled,
                                std::function<void (const QIcon &, const QUrl &, const QUrl &)> iconAvailableCallback);
+    void requestIconsForPageURLs(const QList<QUrl> &pageUrls, int desiredSizeInPixel, bool touchIconsEnabled,
+                                 std::function<void (const QIcon &, const QUrl &, const QUrl &)> iconAvailableCallback);
     void requestIconForIconURL(const QUrl &iconUrl, int desiredSizeInPixel, bool touchIconsEnabled,
                                std::function<void (const QIcon &, const QUrl &)> iconAvailableCallback);
     base::CancelableTaskTracker *cancelableTaskTracker() { return m_cancelableTaskTracker.get(); }
@@ -254,6 +300,14 @@ private:
     int m_httpCacheMaxSize;
     QrcUrlSchemeHandler m_qrcHandler;
     std::unique_ptr<base::CancelableTaskTracker> m_cancelableTaskTracker;
+    std::unique_ptr<PageLifecycleManager> m_pageLifecycleManager;
+    std::unique_ptr<HistoryRestoreScheduler> m_historyRestoreScheduler;
+    HistoryRestorePolicy m_historyRestorePolicy = HistoryRestorePolicy::Immediate;
+    std::unique_ptr<DownloadThrottle> m_downloadThrottle;
+    std::unique_ptr<PreloadingHints> m_preloadingHints;
+    std::unique_ptr<SpareRenderProcessManager> m_spareRenderProcessManager;
+    quint8 m_pendingStorage = 0;
+    QList<std::function<void()>> m_readyTasks;
 
     Q_DISABLE_COPY(ProfileAdapter)
 };
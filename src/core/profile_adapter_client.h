@@ -16,6 +16,7 @@
 #define PROFILE_ADAPTER_CLIENT_H
 
 #include "api/qtwebenginecoreglobal_p.h"
+#include <QByteArray>
 #include <QSharedPointer>
 #include <QString>
 #include <QUrl>
@@ -87,6 +88,7 @@ public:
         int state;
         qint64 totalBytes;
         qint64 receivedBytes;
+        qint64 bytesPerSecond;
         QString mimeType;
         QString path;
         int savePageFormat;
@@ -99,6 +101,7 @@ public:
         WebContentsAdapterClient *page;
         QString suggestedFileName;
         qint64 startTime;
+        QByteArray hash;
     };
 
     virtual ~ProfileAdapterClient() { }
@@ -111,6 +114,13 @@ public:
     virtual void removeWebContentsAdapterClient(WebContentsAdapterClient *adapter) = 0;
     virtual WebEngineSettings *coreSettings() const = 0;
     virtual void clearHttpCacheCompleted() = 0;
+    virtual void pageLifecycleStatisticsChanged(int frozenPages, int discardedPages, qint64 reclaimedMemory)
+    {
+        Q_UNUSED(frozenPages);
+        Q_UNUSED(discardedPages);
+        Q_UNUSED(reclaimedMemory);
+    }
+    virtual void profileReady() { }
 
     static QString downloadInterruptReasonToString(DownloadInterruptReason reason);
 };
@@ -170,7 +170,7 @@ void ProfileIODataQt::OnNetworkContextCreated(content::StoragePartition *storage
         client->clearHttpCacheCompleted();
 }
 
-bool ProfileIODataQt::canGetCookies(const QUrl &firstPartyUrl, const QUrl &url) const
+bool ProfileIODataQt::canGetCookies(const GURL &firstPartyUrl, const GURL &url) const
 {
     return m_cookieDelegate->canGetCookies(firstPartyUrl, url);
 }
@@ -62,7 +62,7 @@ public:
     void initializeOnUIThread(); // runs on ui thread
     void shutdownOnUIThread(); // runs on ui thread
 
-    bool canGetCookies(const QUrl &firstPartyUrl, const QUrl &url) const;
+    bool canGetCookies(const GURL &firstPartyUrl, const GURL &url) const;
 
     void setFullConfiguration(); // runs on ui thread
     void resetNetworkContext(); // runs on ui thread
@@ -249,6 +249,11 @@ void ProfileQt::setupPrefService()
         extensions::ExtensionPrefsFactory::GetInstance()->SetInstanceForTesting(this, std::move(extensionPrefs));
     }
 #endif
+
+    m_profileAdapter->storageLoadStarted(ProfileAdapter::PreferenceStorage);
+    m_prefServiceAdapter.runWhenInitialized(base::BindOnce(&ProfileAdapter::storageLoadFinished,
+                                                           base::Unretained(m_profileAdapter),
+                                                           ProfileAdapter::PreferenceStorage));
 }
 
 void ProfileQt::setupStoragePath()
@@ -287,6 +292,10 @@ void ProfileQt::setupStoragePath()
 void ProfileQt::setupPermissionsManager()
 {
     m_permissionManager.reset(new PermissionManagerQt(profileAdapter()));
+    m_profileAdapter->storageLoadStarted(ProfileAdapter::PermissionStorage);
+    m_permissionManager->runWhenInitialized(base::BindOnce(&ProfileAdapter::storageLoadFinished,
+                                                           base::Unretained(m_profileAdapter),
+                                                           ProfileAdapter::PermissionStorage));
 }
 
 PrefServiceAdapter &ProfileQt::prefServiceAdapter()
@@ -189,6 +189,10 @@ RenderWidgetHostViewQt::RenderWidgetHostViewQt(content::RenderWidgetHost *widget
 
 RenderWidgetHostViewQt::~RenderWidgetHostViewQt()
 {
+    // Waiting callbacks must not run while the view is being destroyed.
+    for (auto &pending : m_frameActivationCallbacks)
+        m_taskRunner->PostTask(FROM_HERE, base::BindOnce(std::move(pending.second), false));
+
     m_delegate.reset();
 
     QObject::disconnect(m_adapterClientDestroyedConnection);
@@ -349,7 +353,11 @@ void RenderWidgetHostViewQt::CopyFromSurface(const gfx::Rect &src_rect,
 void RenderWidgetHostViewQt::ShowWithVisibility(content::PageVisibilityState page_visibility)
 {
     Q_ASSERT(page_visibility != content::PageVisibilityState::kHidden);
-    if (m_delegate)
+    // A hidden page being captured has to paint, without showing up on screen.
+    if (m_delegate && page_visibility == content::PageVisibilityState::kHiddenButPainting
+            && !m_delegate->isVisible())
+        notifyShown();
+    else if (m_delegate)
         m_delegate->show();
     else
         m_deferredShow = true;
@@ -1039,6 +1047,18 @@ void RenderWidgetHostViewQt::OnRenderFrameMetadataChangedAfterActivation(base::T
     std::swap(m_lastContentsSize, contentsSize);
     if (m_adapterClient && contentsSize != m_lastContentsSize)
         m_adapterClient->updateContentsSize(toQt(m_lastContentsSize));
+
+    if (!m_frameActivationCallbacks.empty() && metadata.local_surface_id) {
+        std::vector<base::OnceCallback<void(bool)>> activated;
+        std::erase_if(m_frameActivationCallbacks, [&](auto &pending) {
+            if (!metadata.local_surface_id->IsSameOrNewerThan(pending.first))
+                return false;
+            activated.push_back(std::move(pending.second));
+            return true;
+        });
+        for (auto &callback : activated)
+            std::move(callback).Run(true);
+    }
 }
 
 void RenderWidgetHostViewQt::synchronizeVisualProperties(const std::optional<viz::LocalSurfaceId> &childSurfaceId)
@@ -1064,6 +1084,26 @@ void RenderWidgetHostViewQt::synchronizeVisualProperties(const std::optional<viz
     host()->SynchronizeVisualProperties();
 }
 
+void RenderWidgetHostViewQt::setCaptureSize(const QSize &size)
+{
+    if (m_delegateClient->m_captureSize == size)
+        return;
+    m_delegateClient->m_captureSize = size;
+    m_delegateClient->visualPropertiesChanged();
+}
+
+void RenderWidgetHostViewQt::runAfterFrameActivation(base::OnceCallback<void(bool)> callback)
+{
+    const viz::LocalSurfaceId &localSurfaceId = GetLocalSurfaceId();
+    const std::optional<viz::LocalSurfaceId> &activated =
+            host()->render_frame_metadata_provider()->LastRenderFrameMetadata().local_surface_id;
+    if (activated && activated->IsSameOrNewerThan(localSurfaceId)) {
+        m_taskRunner->PostTask(FROM_HERE, base::BindOnce(std::move(callback), true));
+        return;
+    }
+    m_frameActivationCallbacks.emplace_back(localSurfaceId, std::move(callback));
+}
+
 void RenderWidgetHostViewQt::resetTouchSelectionController()
 {
     Q_ASSERT(m_touchSelectionControllerClient);
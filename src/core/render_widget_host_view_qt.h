@@ -173,6 +173,11 @@ public:
     // Called from WebContentsAdapter.
     gfx::SizeF lastContentsSize() const { return m_lastContentsSize; }
     gfx::PointF lastScrollOffset() const { return m_lastScrollOffset; }
+    // Lays the page out at the given size instead of the size of the delegate, empty to reset.
+    void setCaptureSize(const QSize &size);
+    // Runs the callback with true once a frame for the current visual properties has been
+    // activated, or with false if the view is destroyed first.
+    void runAfterFrameActivation(base::OnceCallback<void(bool)> callback);
 
     ui::TouchSelectionController *getTouchSelectionController() const { return m_touchSelectionController.get(); }
     TouchSelectionControllerClientQt *getTouchSelectionControllerClient() const { return m_touchSelectionControllerClient.get(); }
@@ -210,6 +215,7 @@ private:
     bool m_deferredShow = false;
     gfx::PointF m_lastScrollOffset;
     gfx::SizeF m_lastContentsSize;
+    std::vector<std::pair<viz::LocalSurfaceId, base::OnceCallback<void(bool)>>> m_frameActivationCallbacks;
     DelegatedFrameHostClientQt m_delegatedFrameHostClient { this };
 
     // VIZ
@@ -193,6 +193,8 @@ void RenderWidgetHostViewQtDelegateClient::visualPropertiesChanged()
 
     QRect oldViewRect = m_viewRectInDips;
     m_viewRectInDips = delegate->viewGeometry().toAlignedRect();
+    if (!m_captureSize.isEmpty())
+        m_viewRectInDips.setSize(m_captureSize);
 
     QRect oldWindowRect = m_windowRectInDips;
     m_windowRectInDips = delegate->windowGeometry();
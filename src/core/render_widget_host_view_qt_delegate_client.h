@@ -125,6 +125,8 @@ private:
     QRect m_viewRectInDips;
     // Geometry of the window, including frame, in screen DIPs.
     QRect m_windowRectInDips;
+    // Overrides the size of the view while capturing beyond its bounds.
+    QSize m_captureSize;
 };
 
 } // namespace QtWebEngineCore
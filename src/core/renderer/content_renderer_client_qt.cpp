@@ -20,6 +20,7 @@
 #include "components/error_page/common/localized_error.h"
 #include "components/grit/components_resources.h"
 #include "components/network_hints/renderer/web_prescient_networking_impl.h"
+#include "components/page_load_metrics/renderer/metrics_render_frame_observer.h"
 #include "components/visitedlink/renderer/visitedlink_reader.h"
 #include "components/web_cache/renderer/web_cache_impl.h"
 #include "content/public/renderer/render_frame.h"
@@ -183,6 +184,7 @@ void ContentRendererClientQt::RenderFrameCreated(content::RenderFrame *render_fr
     m_userResourceController->renderFrameCreated(render_frame);
 
     new QtWebEngineCore::ContentSettingsObserverQt(render_frame);
+    new page_load_metrics::MetricsRenderFrameObserver(render_frame);
 
 #if QT_CONFIG(webengine_spellchecker)
     new SpellCheckProvider(render_frame, m_spellCheck.data());
@@ -21,18 +21,28 @@ WebEnginePageHost::WebEnginePageHost(content::WebContents *webContents,
 
 void WebEnginePageHost::FetchDocumentMarkup(uint64_t requestId)
 {
-    auto &remote = GetWebEnginePageRenderFrame(web_contents()->GetPrimaryMainFrame());
-    remote->FetchDocumentMarkup(
+    FetchDocumentMarkup(
             requestId,
             base::BindOnce(&WebEnginePageHost::OnDidFetchDocumentMarkup, base::Unretained(this)));
 }
 
 void WebEnginePageHost::FetchDocumentInnerText(uint64_t requestId)
+{
+    FetchDocumentInnerText(requestId,
+                           base::BindOnce(&WebEnginePageHost::OnDidFetchDocumentInnerText,
+                                          base::Unretained(this)));
+}
+
+void WebEnginePageHost::FetchDocumentMarkup(uint64_t requestId, FetchDocumentCallback callback)
+{
+    auto &remote = GetWebEnginePageRenderFrame(web_contents()->GetPrimaryMainFrame());
+    remote->FetchDocumentMarkup(requestId, std::move(callback));
+}
+
+void WebEnginePageHost::FetchDocumentInnerText(uint64_t requestId, FetchDocumentCallback callback)
 {
     auto &remote = GetWebEnginePageRenderFrame(web_contents()->GetPrimaryMainFrame());
-    remote->FetchDocumentInnerText(requestId,
-                                   base::BindOnce(&WebEnginePageHost::OnDidFetchDocumentInnerText,
-                                                  base::Unretained(this)));
+    remote->FetchDocumentInnerText(requestId, std::move(callback));
 }
 
 void WebEnginePageHost::OnDidFetchDocumentMarkup(uint64_t requestId, const std::string &markup)
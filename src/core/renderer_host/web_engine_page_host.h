@@ -4,6 +4,7 @@
 #ifndef WEB_ENGINE_PAGE_HOST_H
 #define WEB_ENGINE_PAGE_HOST_H
 
+#include "base/functional/callback_forward.h"
 #include "content/public/browser/web_contents_observer.h"
 
 #include <QtGlobal>
@@ -32,9 +33,14 @@ class WebContentsAdapterClient;
 class WebEnginePageHost : public content::WebContentsObserver
 {
 public:
+    using FetchDocumentCallback = base::OnceCallback<void(uint64_t, const std::string &)>;
+
     WebEnginePageHost(content::WebContents *, WebContentsAdapterClient *adapterClient);
     void FetchDocumentMarkup(uint64_t requestId);
     void FetchDocumentInnerText(uint64_t requestId);
+    // Variants handing the UTF-8 result straight to |callback| without converting it to QString.
+    void FetchDocumentMarkup(uint64_t requestId, FetchDocumentCallback callback);
+    void FetchDocumentInnerText(uint64_t requestId, FetchDocumentCallback callback);
     void RenderFrameDeleted(content::RenderFrameHost *render_frame) override;
     void SetBackgroundColor(uint32_t color);
 
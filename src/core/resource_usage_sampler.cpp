@@ -0,0 +1,183 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "resource_usage_sampler.h"
+
+#include "base/barrier_closure.h"
+#include "base/functional/bind.h"
+#include "base/memory/ref_counted.h"
+#include "base/process/process.h"
+#include "base/process/process_metrics.h"
+#include "base/task/thread_pool.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/gpu_data_manager.h"
+#include "content/public/browser/network_service_instance.h"
+#include "content/public/browser/render_frame_host.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/web_contents.h"
+#include "gpu/ipc/common/memory_stats.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
+#include "services/network/public/mojom/network_service.mojom.h"
+#include "services/resource_coordinator/public/cpp/memory_instrumentation/memory_instrumentation.h"
+
+#if BUILDFLAG(IS_MAC)
+#include "content/public/browser/browser_child_process_host.h"
+#endif
+
+#include "web_contents_adapter.h"
+
+#include <map>
+
+namespace QtWebEngineCore {
+
+namespace {
+
+using CpuTimes = std::vector<std::pair<int, qint64>>;
+
+// Runs on the thread pool, reading the process statistics may block.
+CpuTimes sampleCpuTimes(std::vector<std::pair<int, base::Process>> processes)
+{
+    CpuTimes result;
+    result.reserve(processes.size());
+    for (const auto &[childId, process] : processes) {
+#if BUILDFLAG(IS_MAC)
+        auto metrics = base::ProcessMetrics::CreateProcessMetrics(process.Handle(),
+                content::BrowserChildProcessHost::GetPortProvider());
+#else
+        auto metrics = base::ProcessMetrics::CreateProcessMetrics(process.Handle());
+#endif
+        result.emplace_back(childId, metrics->GetCumulativeCPUUsage().InMicroseconds());
+    }
+    return result;
+}
+
+class SampleRequest : public base::RefCounted<SampleRequest>
+{
+public:
+    explicit SampleRequest(ResourceUsageSampler::Callback callback) : m_callback(std::move(callback)) { }
+
+    // Keyed by the child process id, which unlike the pid is known before a process launched.
+    std::map<int, ProcessResourceUsage> processes;
+
+    void onMemoryDump(bool success, std::unique_ptr<memory_instrumentation::GlobalMemoryDump> dump)
+    {
+        if (!success || !dump)
+            return;
+        for (const auto &processDump : dump->process_dumps()) {
+            if (auto *usage = findByPid(processDump.pid()))
+                usage->privateMemoryFootprint = qint64(processDump.os_dump().private_footprint_kb) * 1024;
+        }
+    }
+
+    void onGpuMemoryStats(const gpu::VideoMemoryUsageStats &stats)
+    {
+        for (const auto &[pid, processStats] : stats.process_map) {
+            if (auto *usage = findByPid(pid))
+                usage->gpuMemory = qint64(processStats.video_memory);
+        }
+    }
+
+    void onNetworkUsages(std::vector<network::mojom::NetworkUsagePtr> usages)
+    {
+        for (auto &[childId, usage] : processes) {
+            usage.networkBytesReceived = 0;
+            usage.networkBytesSent = 0;
+        }
+        for (const auto &networkUsage : usages) {
+            auto it = processes.find(networkUsage->process_id);
+            if (it == processes.end())
+                continue;
+            it->second.networkBytesReceived += networkUsage->total_bytes_received;
+            it->second.networkBytesSent += networkUsage->total_bytes_sent;
+        }
+    }
+
+    void onCpuTimes(const CpuTimes &cpuTimes)
+    {
+        for (const auto &[childId, cpuTime] : cpuTimes) {
+            auto it = processes.find(childId);
+            if (it != processes.end())
+                it->second.cpuTime = cpuTime;
+        }
+    }
+
+    void finish()
+    {
+        QList<ProcessResourceUsage> result;
+        result.reserve(processes.size());
+        for (auto &[childId, usage] : processes)
+            result.append(std::move(usage));
+        processes.clear();
+        m_callback(result);
+    }
+
+private:
+    friend class base::RefCounted<SampleRequest>;
+    ~SampleRequest() = default;
+
+    ProcessResourceUsage *findByPid(base::ProcessId pid)
+    {
+        for (auto &[childId, usage] : processes) {
+            if (usage.pid == qint64(pid))
+                return &usage;
+        }
+        return nullptr;
+    }
+
+    ResourceUsageSampler::Callback m_callback;
+};
+
+} // namespace
+
+void ResourceUsageSampler::sample(const QList<QSharedPointer<WebContentsAdapter>> &pages, Callback callback)
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    auto request = base::MakeRefCounted<SampleRequest>(std::move(callback));
+
+    std::vector<std::pair<int, base::Process>> launchedProcesses;
+    for (const auto &page : pages) {
+        if (!page->isInitialized())
+            continue;
+        QWeakPointer<WebContentsAdapter> weakPage = page;
+        page->webContents()->ForEachRenderFrameHost([&](content::RenderFrameHost *rfh) {
+            if (!rfh->IsRenderFrameLive())
+                return;
+            content::RenderProcessHost *host = rfh->GetProcess();
+            auto [it, inserted] = request->processes.try_emplace(host->GetID());
+            ProcessResourceUsage &usage = it->second;
+            if (inserted && host->GetProcess().IsValid()) {
+                usage.pid = host->GetProcess().Pid();
+                launchedProcesses.emplace_back(host->GetID(), host->GetProcess().Duplicate());
+            }
+            usage.frames.append({ weakPage, quint64(rfh->GetFrameTreeNodeId()) });
+        });
+    }
+
+    base::RepeatingClosure barrier = base::BarrierClosure(
+            4, base::BindOnce(&SampleRequest::finish, request));
+
+    if (auto *instrumentation = memory_instrumentation::MemoryInstrumentation::GetInstance()) {
+        instrumentation->RequestPrivateMemoryFootprint(
+                base::kNullProcessId,
+                base::BindOnce(&SampleRequest::onMemoryDump, request).Then(base::OnceClosure(barrier)));
+    } else {
+        barrier.Run();
+    }
+
+    content::GpuDataManager::GetInstance()->RequestVideoMemoryUsageStatsUpdate(
+            mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+                    base::BindOnce(&SampleRequest::onGpuMemoryStats, request).Then(base::OnceClosure(barrier)),
+                    gpu::VideoMemoryUsageStats()));
+
+    content::GetNetworkService()->GetTotalNetworkUsages(
+            mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+                    base::BindOnce(&SampleRequest::onNetworkUsages, request).Then(base::OnceClosure(barrier)),
+                    std::vector<network::mojom::NetworkUsagePtr>()));
+
+    base::ThreadPool::PostTaskAndReplyWithResult(
+            FROM_HERE, { base::MayBlock(), base::TaskPriority::USER_VISIBLE },
+            base::BindOnce(&sampleCpuTimes, std::move(launchedProcesses)),
+            base::BindOnce(&SampleRequest::onCpuTimes, request).Then(base::OnceClosure(barrier)));
+}
+
+} // namespace QtWebEngineCore
@@ -0,0 +1,55 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef RESOURCE_USAGE_SAMPLER_H
+#define RESOURCE_USAGE_SAMPLER_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include <QList>
+#include <QSharedPointer>
+
+#include <functional>
+#include <utility>
+
+namespace QtWebEngineCore {
+
+class WebContentsAdapter;
+
+// Values that could not be sampled are -1.
+struct ProcessResourceUsage {
+    qint64 pid = 0;
+    qint64 privateMemoryFootprint = -1;
+    qint64 cpuTime = -1; // in microseconds
+    qint64 gpuMemory = -1;
+    qint64 networkBytesReceived = -1;
+    qint64 networkBytesSent = -1;
+    // Page and frame id of every frame hosted by the process
+    QList<std::pair<QWeakPointer<WebContentsAdapter>, quint64>> frames;
+};
+
+class Q_WEBENGINECORE_EXPORT ResourceUsageSampler
+{
+public:
+    using Callback = std::function<void(const QList<ProcessResourceUsage> &)>;
+
+    // Samples the renderer processes hosting the frames of the given pages. The
+    // measurements run concurrently off the UI thread, and the callback is called
+    // once on the UI thread with the combined result.
+    static void sample(const QList<QSharedPointer<WebContentsAdapter>> &pages, Callback callback);
+};
+
+} // namespace QtWebEngineCore
+
+#endif // RESOURCE_USAGE_SAMPLER_H
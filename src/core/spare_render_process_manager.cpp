@@ -0,0 +1,66 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "spare_render_process_manager.h"
+
+#include "base/auto_reset.h"
+#include "content/public/browser/browser_thread.h"
+
+#include "profile_adapter.h"
+#include "profile_qt.h"
+
+namespace QtWebEngineCore {
+
+SpareRenderProcessManager::SpareRenderProcessManager(ProfileAdapter *profileAdapter)
+    : m_profileAdapter(profileAdapter)
+{
+}
+
+SpareRenderProcessManager::~SpareRenderProcessManager() = default;
+
+void SpareRenderProcessManager::warmUp()
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    // Chromium keeps a single spare process, which is replaced if another profile
+    // asks for one, and does nothing if this profile already has one.
+    base::AutoReset<bool> warmingUp(&m_warmingUp, true);
+    content::RenderProcessHost::WarmupSpareRenderProcessHost(m_profileAdapter->profile());
+}
+
+bool SpareRenderProcessManager::takeSpareRenderProcess(content::RenderProcessHost *host)
+{
+    const bool wasSpare = m_spareRenderProcessIds.count(host->GetID());
+    if (wasSpare)
+        forgetRenderProcess(host);
+    warmUp();
+    return wasSpare;
+}
+
+void SpareRenderProcessManager::OnRenderProcessHostCreated(content::RenderProcessHost *host)
+{
+    // Only the process created by WarmupSpareRenderProcessHost() is a spare.
+    if (!m_warmingUp || host->GetBrowserContext() != m_profileAdapter->profile())
+        return;
+    m_spareRenderProcessIds.insert(host->GetID());
+    m_observations.AddObservation(host);
+}
+
+void SpareRenderProcessManager::RenderProcessExited(content::RenderProcessHost *host,
+                                                    const content::ChildProcessTerminationInfo &)
+{
+    forgetRenderProcess(host);
+}
+
+void SpareRenderProcessManager::RenderProcessHostDestroyed(content::RenderProcessHost *host)
+{
+    forgetRenderProcess(host);
+}
+
+void SpareRenderProcessManager::forgetRenderProcess(content::RenderProcessHost *host)
+{
+    m_spareRenderProcessIds.erase(host->GetID());
+    if (m_observations.IsObservingSource(host))
+        m_observations.RemoveObservation(host);
+}
+
+} // namespace QtWebEngineCore
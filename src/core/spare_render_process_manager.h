@@ -0,0 +1,65 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef SPARE_RENDER_PROCESS_MANAGER_H
+#define SPARE_RENDER_PROCESS_MANAGER_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include "base/scoped_multi_source_observation.h"
+#include "content/public/browser/render_process_host.h"
+#include "content/public/browser/render_process_host_creation_observer.h"
+#include "content/public/browser/render_process_host_observer.h"
+
+#include <set>
+
+namespace QtWebEngineCore {
+
+class ProfileAdapter;
+
+// Keeps a spare renderer process of a profile launched and initialized, so that
+// the next navigation does not have to wait for a process to start up.
+class SpareRenderProcessManager : public content::RenderProcessHostCreationObserver,
+                                  public content::RenderProcessHostObserver
+{
+public:
+    explicit SpareRenderProcessManager(ProfileAdapter *profileAdapter);
+    ~SpareRenderProcessManager() override;
+
+    void warmUp();
+    // Returns whether the process hosting a committed navigation was a spare that
+    // had not been used before, and prepares the next one.
+    bool takeSpareRenderProcess(content::RenderProcessHost *host);
+
+    // content::RenderProcessHostCreationObserver
+    void OnRenderProcessHostCreated(content::RenderProcessHost *host) override;
+
+    // content::RenderProcessHostObserver
+    void RenderProcessExited(content::RenderProcessHost *host,
+                             const content::ChildProcessTerminationInfo &info) override;
+    void RenderProcessHostDestroyed(content::RenderProcessHost *host) override;
+
+private:
+    void forgetRenderProcess(content::RenderProcessHost *host);
+
+    ProfileAdapter *m_profileAdapter;
+    bool m_warmingUp = false;
+    std::set<int> m_spareRenderProcessIds;
+    base::ScopedMultiSourceObservation<content::RenderProcessHost, content::RenderProcessHostObserver>
+            m_observations { this };
+};
+
+} // namespace QtWebEngineCore
+
+#endif // SPARE_RENDER_PROCESS_MANAGER_H
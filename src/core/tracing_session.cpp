@@ -0,0 +1,160 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "tracing_session.h"
+
+#include "base/functional/bind.h"
+#include "base/functional/callback_helpers.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/task/sequenced_task_runner.h"
+#include "base/task/thread_pool.h"
+#include "base/trace_event/trace_config.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/browser/tracing_controller.h"
+
+#include "web_engine_context.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qpointer.h>
+
+namespace QtWebEngineCore {
+
+namespace {
+
+// Writes the trace chunks in order to a file or a device, on the given sequence.
+class DeviceEndpoint final : public content::TracingController::TraceDataEndpoint
+{
+public:
+    DeviceEndpoint(const QString &filePath, TracingSession::ResultCallback callback)
+        : m_taskRunner(base::ThreadPool::CreateSequencedTaskRunner(
+                  { base::MayBlock(), base::TaskPriority::USER_VISIBLE }))
+        , m_filePath(filePath)
+        , m_callback(std::move(callback))
+    { }
+
+    DeviceEndpoint(QIODevice *device, TracingSession::ResultCallback callback)
+        : m_taskRunner(content::GetUIThreadTaskRunner({}))
+        , m_device(device)
+        , m_callback(std::move(callback))
+    { }
+
+    void ReceiveTraceChunk(std::unique_ptr<std::string> chunk) override
+    {
+        m_taskRunner->PostTask(FROM_HERE, base::BindOnce(&DeviceEndpoint::write, base::RetainedRef(this),
+                                                         std::move(chunk)));
+    }
+
+    void ReceivedTraceFinalContents() override
+    {
+        m_taskRunner->PostTask(FROM_HERE, base::BindOnce(&DeviceEndpoint::finish, base::RetainedRef(this)));
+    }
+
+private:
+    ~DeviceEndpoint() override = default;
+
+    QIODevice *device()
+    {
+        if (m_filePath.isEmpty())
+            return m_device.data();
+        if (!m_file) {
+            // Created on the writing sequence, opening the file may block.
+            m_file = std::make_unique<QFile>(m_filePath);
+            if (!m_file->open(QIODevice::WriteOnly | QIODevice::Truncate))
+                m_failed = true;
+        }
+        return m_file->isOpen() ? m_file.get() : nullptr;
+    }
+
+    void write(std::unique_ptr<std::string> chunk)
+    {
+        if (m_failed)
+            return;
+        QIODevice *target = device();
+        const qint64 size = qint64(chunk->size());
+        if (!target || target->write(chunk->data(), size) != size)
+            m_failed = true;
+    }
+
+    void finish()
+    {
+        if (!device())
+            m_failed = true;
+        if (m_file) {
+            if (!m_file->flush())
+                m_failed = true;
+            m_file->close();
+        }
+        content::GetUIThreadTaskRunner({})->PostTask(
+                FROM_HERE,
+                base::BindOnce([](TracingSession::ResultCallback callback,
+                                  bool success) { if (callback) callback(success); },
+                               std::move(m_callback), !m_failed));
+    }
+
+    scoped_refptr<base::SequencedTaskRunner> m_taskRunner;
+    QString m_filePath;
+    std::unique_ptr<QFile> m_file;
+    QPointer<QIODevice> m_device;
+    TracingSession::ResultCallback m_callback;
+    bool m_failed = false;
+};
+
+content::TracingController *tracingController()
+{
+    DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
+    if (!WebEngineContext::isInitialized())
+        return nullptr;
+    return content::TracingController::GetInstance();
+}
+
+bool stopTracing(scoped_refptr<DeviceEndpoint> endpoint)
+{
+    content::TracingController *controller = tracingController();
+    if (!controller || !controller->IsTracing())
+        return false;
+    return controller->StopTracing(std::move(endpoint));
+}
+
+} // namespace
+
+namespace TracingSession {
+
+bool start(const std::string &categoryFilter, size_t bufferSizeInKb, bool recordContinuously)
+{
+    content::TracingController *controller = tracingController();
+    // Only one session at a time, this includes startup tracing.
+    if (!controller || controller->IsTracing())
+        return false;
+
+    base::trace_event::TraceConfig config(categoryFilter,
+                                          recordContinuously ? base::trace_event::RECORD_CONTINUOUSLY
+                                                             : base::trace_event::RECORD_UNTIL_FULL);
+    if (bufferSizeInKb)
+        config.SetTraceBufferSizeInKb(bufferSizeInKb);
+    return controller->StartTracing(config, base::DoNothing());
+}
+
+bool isActive()
+{
+    content::TracingController *controller = tracingController();
+    return controller && controller->IsTracing();
+}
+
+bool stop(const QString &filePath, ResultCallback callback)
+{
+    if (filePath.isEmpty())
+        return false;
+    return stopTracing(base::MakeRefCounted<DeviceEndpoint>(filePath, std::move(callback)));
+}
+
+bool stop(QIODevice *device, ResultCallback callback)
+{
+    if (!device || !device->isWritable())
+        return false;
+    return stopTracing(base::MakeRefCounted<DeviceEndpoint>(device, std::move(callback)));
+}
+
+} // namespace TracingSession
+
+} // namespace QtWebEngineCore
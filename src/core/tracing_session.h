@@ -0,0 +1,45 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#ifndef TRACING_SESSION_H
+#define TRACING_SESSION_H
+
+#include "qtwebenginecoreglobal_p.h"
+
+#include <QtCore/qstring.h>
+
+#include <functional>
+#include <string>
+
+QT_FORWARD_DECLARE_CLASS(QIODevice)
+
+namespace QtWebEngineCore {
+
+// Runtime tracing sessions on top of content::TracingController. The trace is
+// written in the JSON trace event format, chunk by chunk as it is read back.
+namespace TracingSession {
+
+using ResultCallback = std::function<void(bool)>;
+
+bool start(const std::string &categoryFilter, size_t bufferSizeInKb, bool recordContinuously);
+bool isActive();
+// The file is written on the thread pool, the device on the UI thread.
+bool stop(const QString &filePath, ResultCallback callback);
+bool stop(QIODevice *device, ResultCallback callback);
+
+} // namespace TracingSession
+
+} // namespace QtWebEngineCore
+
+#endif // TRACING_SESSION_H
@@ -15,6 +15,8 @@
 #include "favicon_service_factory_qt.h"
 #include "find_text_helper.h"
 #include "media_capture_devices_dispatcher.h"
+#include "page_capture.h"
+#include "page_load_metrics_qt.h"
 #include "pdf_util_qt.h"
 #include "profile_adapter.h"
 #include "profile_qt.h"
@@ -27,6 +29,7 @@
 #include "web_engine_settings.h"
 
 #include "base/command_line.h"
+#include "base/json/json_writer.h"
 #include "base/metrics/user_metrics.h"
 #include "base/task/current_thread.h"
 #include "base/task/sequence_manager/sequence_manager_impl.h"
@@ -37,6 +40,7 @@
 #include "components/autofill/content/browser/content_autofill_driver_factory.h"
 #include "components/embedder_support/user_agent_utils.h"
 #include "components/favicon/core/favicon_service.h"
+#include "content/browser/renderer_host/frame_tree_node.h"
 #include "content/browser/renderer_host/render_view_host_impl.h"
 #include "content/browser/renderer_host/text_input_manager.h"
 #include "content/browser/web_contents/web_contents_impl.h"
@@ -46,12 +50,14 @@
 #include "content/public/browser/host_zoom_map.h"
 #include "content/public/browser/navigation_entry.h"
 #include "content/public/browser/navigation_entry_restore_context.h"
+#include "content/public/browser/prerender_handle.h"
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/favicon_status.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/common/drop_data.h"
 #include "content/public/common/url_constants.h"
 #include "extensions/buildflags/buildflags.h"
+#include "mojo/public/cpp/bindings/callback_helpers.h"
 #include "third_party/blink/public/common/page/page_zoom.h"
 #include "third_party/blink/public/common/page_state/page_state.h"
 #include "third_party/blink/public/common/peerconnection/webrtc_ip_handling_policy.h"
@@ -63,6 +69,9 @@
 #include "ui/native_theme/native_theme.h"
 #include "qtwebengine/browser/qtwebenginepage.mojom.h"
 
+#include <QtCore/QCborArray>
+#include <QtCore/QCborMap>
+#include <QtCore/QCborValue>
 #include <QtCore/QVariant>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QMimeData>
@@ -107,6 +116,9 @@ namespace QtWebEngineCore {
 
 static const int kHistoryStreamVersion = 4;
 
+// Size of the slices in which streamed document contents are handed to the client.
+static constexpr size_t kDocumentChunkSize = 64 * 1024;
+
 static QVariant fromJSValue(const base::Value *result)
 {
     QVariant ret;
@@ -174,9 +186,93 @@ static QVariant fromJSValue(const base::Value *result)
     return ret;
 }
 
-static void callbackOnEvaluateJS(WebContentsAdapter *adapter, quint64 requestId, base::Value result)
+static QCborValue toCborValue(const base::Value &value)
+{
+    switch (value.type()) {
+    case base::Value::Type::NONE:
+        return QCborValue(nullptr);
+    case base::Value::Type::BOOLEAN:
+        return QCborValue(value.GetBool());
+    case base::Value::Type::INTEGER:
+        return QCborValue(qint64(value.GetInt()));
+    case base::Value::Type::DOUBLE:
+        return QCborValue(value.GetDouble());
+    case base::Value::Type::STRING:
+        return QCborValue(toQt(value.GetString()));
+    case base::Value::Type::LIST:
+    {
+        QCborArray array;
+        for (const auto &item : value.GetList())
+            array.append(toCborValue(item));
+        return array;
+    }
+    case base::Value::Type::DICT:
+    {
+        QCborMap map;
+        for (const auto pair : value.GetDict())
+            map.insert(toQt(pair.first), toCborValue(pair.second));
+        return map;
+    }
+    case base::Value::Type::BINARY:
+    {
+        const auto &blob = value.GetBlob();
+        return QCborValue(QByteArray(reinterpret_cast<const char *>(blob.data()), qsizetype(blob.size())));
+    }
+    default:
+        Q_UNREACHABLE();
+        break;
+    }
+    return QCborValue();
+}
+
+// Converts the result of a script without building a QVariant tree.
+static QVariant fromJSValue(const base::Value &result,
+                            WebContentsAdapter::JavaScriptResultFormat format)
 {
-    adapter->didRunJavaScript(requestId, result);
+    switch (format) {
+    case WebContentsAdapter::JavaScriptResultFormat::Variant:
+        return fromJSValue(&result);
+    case WebContentsAdapter::JavaScriptResultFormat::Json:
+    {
+        std::string json;
+        if (!base::JSONWriter::WriteWithOptions(
+                    result, base::JSONWriter::OPTIONS_OMIT_BINARY_VALUES, &json))
+            return QVariant();
+        return QByteArray(json.data(), qsizetype(json.size()));
+    }
+    case WebContentsAdapter::JavaScriptResultFormat::Cbor:
+        return QVariant::fromValue(toCborValue(result));
+    case WebContentsAdapter::JavaScriptResultFormat::Binary:
+        if (result.is_blob()) {
+            const auto &blob = result.GetBlob();
+            return QByteArray(reinterpret_cast<const char *>(blob.data()), qsizetype(blob.size()));
+        }
+        if (result.is_string()) {
+            const std::string &str = result.GetString();
+            return QByteArray(str.data(), qsizetype(str.size()));
+        }
+        return QVariant();
+    }
+    Q_UNREACHABLE_RETURN(QVariant());
+}
+
+static void callbackOnEvaluateJS(WebContentsAdapter *adapter, quint64 requestId,
+                                 WebContentsAdapter::JavaScriptResultFormat format,
+                                 base::Value result)
+{
+    adapter->didRunJavaScript(requestId, result, format);
+}
+
+static void callbackOnEvaluateJSInFrame(WebContentsAdapter *adapter, quint64 requestId,
+                                        qsizetype index, base::Value result)
+{
+    adapter->didRunJavaScriptInFrame(requestId, index, result);
+}
+
+static void callbackOnFetchDocumentUtf8(WebContentsAdapter *adapter, uint64_t requestId,
+                                        const std::string &result)
+{
+    adapter->didFetchDocumentUtf8(requestId, result);
 }
 
 #if QT_CONFIG(webengine_printing_and_pdf)
@@ -261,7 +357,40 @@ static void serializeNavigationHistory(content::NavigationController &controller
     }
 }
 
-static void deserializeNavigationHistory(QDataStream &input, int *currentIndex, std::vector<std::unique_ptr<content::NavigationEntry>> *entries, content::BrowserContext *browserContext)
+// The entries of a serialized navigation history, as written by serializeNavigationHistory().
+// Reading them does not need a browser context, so the history of a page whose restore is
+// deferred can be kept and queried in this form until a WebContents is created for it.
+struct SerializedNavigationEntry
+{
+    QUrl virtualUrl;
+    QString title;
+    QByteArray pageState;
+    qint32 transitionType = 0;
+    bool hasPostData = false;
+    QUrl referrerUrl;
+    qint32 referrerPolicy = 0;
+    QUrl originalRequestUrl;
+    bool isOverridingUserAgent = false;
+    qint64 timestamp = 0;
+    int httpStatusCode = 0;
+    QUrl iconUrl;
+};
+
+struct NavigationHistorySnapshot
+{
+    int currentIndex = -1;
+    std::vector<SerializedNavigationEntry> entries;
+
+    const SerializedNavigationEntry *entryAt(int index) const
+    {
+        if (index < 0 || index >= int(entries.size()))
+            return nullptr;
+        return &entries[index];
+    }
+    const SerializedNavigationEntry *currentEntry() const { return entryAt(currentIndex); }
+};
+
+static void readNavigationHistory(QDataStream &input, NavigationHistorySnapshot *snapshot)
 {
     int version;
     input >> version;
@@ -269,54 +398,75 @@ static void deserializeNavigationHistory(QDataStream &input, int *currentIndex,
         // We do not try to decode history stream versions before 3.
         // Make sure that our history is cleared and mark the rest of the stream as invalid.
         input.setStatus(QDataStream::ReadCorruptData);
-        *currentIndex = -1;
+        snapshot->currentIndex = -1;
         return;
     }
 
     int count;
-    input >> count >> *currentIndex;
+    input >> count >> snapshot->currentIndex;
 
-    std::unique_ptr<content::NavigationEntryRestoreContext> context = content::NavigationEntryRestoreContext::Create();
-
-    entries->reserve(count);
-    // Logic taken from SerializedNavigationEntry::ReadFromPickle and ToNavigationEntries.
+    snapshot->entries.reserve(count);
+    // Logic taken from SerializedNavigationEntry::ReadFromPickle.
     for (int i = 0; i < count; ++i) {
-        QUrl virtualUrl, referrerUrl, originalRequestUrl, iconUrl;
-        QString title;
-        QByteArray pageState;
-        qint32 transitionType, referrerPolicy;
-        bool hasPostData, isOverridingUserAgent;
-        qint64 timestamp;
-        int httpStatusCode;
-        input >> virtualUrl;
-        input >> title;
-        input >> pageState;
-        input >> transitionType;
-        input >> hasPostData;
-        input >> referrerUrl;
-        input >> referrerPolicy;
-        input >> originalRequestUrl;
-        input >> isOverridingUserAgent;
-        input >> timestamp;
-        input >> httpStatusCode;
+        SerializedNavigationEntry entry;
+        input >> entry.virtualUrl;
+        input >> entry.title;
+        input >> entry.pageState;
+        input >> entry.transitionType;
+        input >> entry.hasPostData;
+        input >> entry.referrerUrl;
+        input >> entry.referrerPolicy;
+        input >> entry.originalRequestUrl;
+        input >> entry.isOverridingUserAgent;
+        input >> entry.timestamp;
+        input >> entry.httpStatusCode;
         // kHistoryStreamVersion >= 4
         if (version >= 4)
-            input >> iconUrl;
+            input >> entry.iconUrl;
 
         // If we couldn't unpack the entry successfully, abort everything.
         if (input.status() != QDataStream::Ok) {
-            *currentIndex = -1;
-            auto it = entries->begin();
-            auto end = entries->end();
-            for (; it != end; ++it)
-                it->reset();
-            entries->clear();
+            snapshot->currentIndex = -1;
+            snapshot->entries.clear();
             return;
         }
+        snapshot->entries.push_back(std::move(entry));
+    }
+}
 
+static void writeNavigationHistory(const NavigationHistorySnapshot &snapshot, QDataStream &output)
+{
+    // Same layout as serializeNavigationHistory() above.
+    output << kHistoryStreamVersion;
+    output << int(snapshot.entries.size());
+    output << snapshot.currentIndex;
+    for (const SerializedNavigationEntry &entry : snapshot.entries) {
+        output << entry.virtualUrl;
+        output << entry.title;
+        output << entry.pageState;
+        output << entry.transitionType;
+        output << entry.hasPostData;
+        output << entry.referrerUrl;
+        output << entry.referrerPolicy;
+        output << entry.originalRequestUrl;
+        output << entry.isOverridingUserAgent;
+        output << entry.timestamp;
+        output << entry.httpStatusCode;
+        output << entry.iconUrl;
+    }
+}
+
+static std::vector<std::unique_ptr<content::NavigationEntry>> toNavigationEntries(const NavigationHistorySnapshot &snapshot, content::BrowserContext *browserContext)
+{
+    std::unique_ptr<content::NavigationEntryRestoreContext> context = content::NavigationEntryRestoreContext::Create();
+
+    std::vector<std::unique_ptr<content::NavigationEntry>> entries;
+    entries.reserve(snapshot.entries.size());
+    // Logic taken from SerializedNavigationEntry::ToNavigationEntries.
+    for (const SerializedNavigationEntry &serialized : snapshot.entries) {
         std::unique_ptr<content::NavigationEntry> entry = content::NavigationController::CreateNavigationEntry(
-            toGurl(virtualUrl),
-            content::Referrer(toGurl(referrerUrl), static_cast<network::mojom::ReferrerPolicy>(referrerPolicy)),
+            toGurl(serialized.virtualUrl),
+            content::Referrer(toGurl(serialized.referrerUrl), static_cast<network::mojom::ReferrerPolicy>(serialized.referrerPolicy)),
             std::nullopt, // optional initiator_origin
             std::nullopt, // optional initiator_base_url
             // Use a transition type of reload so that we don't incorrectly
@@ -328,23 +478,24 @@ static void deserializeNavigationHistory(QDataStream &input, int *currentIndex,
             browserContext,
             nullptr);
 
-        entry->SetTitle(toString16(title));
-        entry->SetPageState(blink::PageState::CreateFromEncodedData(std::string(pageState.data(), pageState.size())), context.get());
-        entry->SetHasPostData(hasPostData);
-        entry->SetOriginalRequestURL(toGurl(originalRequestUrl));
-        entry->SetIsOverridingUserAgent(isOverridingUserAgent);
-        entry->SetTimestamp(base::Time::FromInternalValue(timestamp));
-        entry->SetHttpStatusCode(httpStatusCode);
-        if (iconUrl.isValid()) {
+        entry->SetTitle(toString16(serialized.title));
+        entry->SetPageState(blink::PageState::CreateFromEncodedData(std::string(serialized.pageState.data(), serialized.pageState.size())), context.get());
+        entry->SetHasPostData(serialized.hasPostData);
+        entry->SetOriginalRequestURL(toGurl(serialized.originalRequestUrl));
+        entry->SetIsOverridingUserAgent(serialized.isOverridingUserAgent);
+        entry->SetTimestamp(base::Time::FromInternalValue(serialized.timestamp));
+        entry->SetHttpStatusCode(serialized.httpStatusCode);
+        if (serialized.iconUrl.isValid()) {
             // Note: we don't set .image below as we don't have it and chromium will refetch favicon
             // anyway. However, we set .url and .valid to let QWebEngineHistory items restored from
             // a stream receive valid icon URLs via our getNavigationEntryIconUrl calls.
             content::FaviconStatus &favicon = entry->GetFavicon();
-            favicon.url = toGurl(iconUrl);
+            favicon.url = toGurl(serialized.iconUrl);
             favicon.valid = true;
         }
-        entries->push_back(std::move(entry));
+        entries.push_back(std::move(entry));
     }
+    return entries;
 }
 
 namespace {
@@ -358,12 +509,22 @@ void Navigate(WebContentsAdapter *adapter, const content::NavigationController::
     adapter->findTextHelper()->stopFinding();
 }
 
-void NavigateTask(QWeakPointer<WebContentsAdapter> weakAdapter, const content::NavigationController::LoadURLParams &params)
+void NavigateTask(QWeakPointer<WebContentsAdapter> weakAdapter, content::NavigationController::LoadURLParams params)
 {
     DCHECK_CURRENTLY_ON(content::BrowserThread::UI);
     const auto adapter = weakAdapter.toStrongRef();
     if (!adapter)
         return;
+    ProfileAdapter *profileAdapter = adapter->profileAdapter();
+    if (profileAdapter && !profileAdapter->isReady()) {
+        // Hold the navigation back until the preference and permission stores
+        // of the profile have been read.
+        auto pendingParams = std::make_shared<content::NavigationController::LoadURLParams>(std::move(params));
+        profileAdapter->runWhenReady([weakAdapter, pendingParams]() {
+            NavigateTask(weakAdapter, std::move(*pendingParams));
+        });
+        return;
+    }
     Navigate(adapter.get(), params);
 }
 
@@ -392,21 +553,43 @@ class LoadRecursionGuard {
 
 QSharedPointer<WebContentsAdapter> WebContentsAdapter::createFromSerializedNavigationHistory(QDataStream &input, WebContentsAdapterClient *adapterClient)
 {
-    int currentIndex;
-    std::vector<std::unique_ptr<content::NavigationEntry>> entries;
-    deserializeNavigationHistory(input, &currentIndex, &entries, adapterClient->profileAdapter()->profile());
+    NavigationHistorySnapshot snapshot;
+    readNavigationHistory(input, &snapshot);
 
-    if (currentIndex == -1)
+    if (snapshot.currentIndex == -1)
         return QSharedPointer<WebContentsAdapter>();
 
+    content::BrowserContext *browserContext = adapterClient->profileAdapter()->profile();
+    std::vector<std::unique_ptr<content::NavigationEntry>> entries = toNavigationEntries(snapshot, browserContext);
+
     // Unlike WebCore, Chromium only supports Restoring to a new WebContents instance.
-    std::unique_ptr<content::WebContents> newWebContents = createBlankWebContents(adapterClient, adapterClient->profileAdapter()->profile());
+    std::unique_ptr<content::WebContents> newWebContents = createBlankWebContents(adapterClient, browserContext);
     content::NavigationController &controller = newWebContents->GetController();
-    controller.Restore(currentIndex, content::RestoreType::kRestored, &entries);
+    controller.Restore(snapshot.currentIndex, content::RestoreType::kRestored, &entries);
 
     return QSharedPointer<WebContentsAdapter>::create(std::move(newWebContents));
 }
 
+QSharedPointer<WebContentsAdapter> WebContentsAdapter::createWithDeferredNavigationHistory(QDataStream &input)
+{
+    auto snapshot = std::make_unique<NavigationHistorySnapshot>();
+    readNavigationHistory(input, snapshot.get());
+
+    if (!snapshot->currentEntry())
+        return QSharedPointer<WebContentsAdapter>();
+
+    // The WebContents is only created and restored by initialize(), until then
+    // the navigation history is answered from the snapshot.
+    auto adapter = QSharedPointer<WebContentsAdapter>::create();
+    adapter->m_deferredHistory = std::move(snapshot);
+    return adapter;
+}
+
+bool WebContentsAdapter::hasDeferredNavigationHistory() const
+{
+    return bool(m_deferredHistory);
+}
+
 WebContentsAdapter::WebContentsAdapter(std::unique_ptr<content::WebContents> webContents)
   : m_profileAdapter(nullptr)
   , m_webContents(std::move(webContents))
@@ -430,6 +613,8 @@ WebContentsAdapter::WebContentsAdapter()
 
 WebContentsAdapter::~WebContentsAdapter()
 {
+    // Nobody is left to receive the results of scripts still running in frames.
+    m_javaScriptBatches.clear();
     if (m_devToolsFrontend)
         closeDevToolsFrontend();
     Q_ASSERT(!m_devToolsFrontend);
@@ -460,6 +645,16 @@ void WebContentsAdapter::initialize(content::SiteInstance *site)
     Q_ASSERT(m_adapterClient);
     Q_ASSERT(!isInitialized());
 
+    if (m_deferredHistory) {
+        Q_ASSERT(!m_webContents);
+        const std::unique_ptr<NavigationHistorySnapshot> snapshot = std::move(m_deferredHistory);
+        std::vector<std::unique_ptr<content::NavigationEntry>> entries =
+                toNavigationEntries(*snapshot, m_profileAdapter->profile());
+        m_webContents = createBlankWebContents(m_adapterClient, m_profileAdapter->profile());
+        m_webContents->GetController().Restore(snapshot->currentIndex,
+                                               content::RestoreType::kRestored, &entries);
+    }
+
     // Create our own if a WebContents wasn't provided at construction.
     if (!m_webContents) {
         content::WebContents::CreateParams create_params(m_profileAdapter->profile(), site);
@@ -492,6 +687,7 @@ void WebContentsAdapter::initialize(content::SiteInstance *site)
             webContents(), FaviconServiceFactoryQt::GetForBrowserContext(context), m_adapterClient);
 
     AutofillClientQt::CreateForWebContents(webContents());
+    initializePageLoadMetricsForWebContents(webContents());
 
     // Create an instance of WebEngineVisitedLinksManager to catch the first
     // content::NOTIFICATION_RENDERER_PROCESS_CREATED event. This event will
@@ -557,18 +753,24 @@ void WebContentsAdapter::initializeRenderPrefs()
 
 bool WebContentsAdapter::canGoBack() const
 {
+    if (m_deferredHistory)
+        return m_deferredHistory->currentIndex > 0;
     CHECK_INITIALIZED(false);
     return m_webContents->GetController().CanGoBack();
 }
 
 bool WebContentsAdapter::canGoForward() const
 {
+    if (m_deferredHistory)
+        return m_deferredHistory->currentIndex + 1 < int(m_deferredHistory->entries.size());
     CHECK_INITIALIZED(false);
     return m_webContents->GetController().CanGoForward();
 }
 
 bool WebContentsAdapter::canGoToOffset(int offset) const
 {
+    if (m_deferredHistory)
+        return m_deferredHistory->entryAt(m_deferredHistory->currentIndex + offset);
     CHECK_INITIALIZED(false);
     return m_webContents->GetController().CanGoToOffset(offset);
 }
@@ -718,7 +920,7 @@ void WebContentsAdapter::load(const QWebEngineHttpRequest &request)
         content::GetUIThreadTaskRunner({})->PostTask(FROM_HERE,
                        base::BindOnce(&NavigateTask, sharedFromThis().toWeakRef(), std::move(params)));
     } else {
-        Navigate(this, params);
+        NavigateTask(sharedFromThis().toWeakRef(), std::move(params));
     }
 }
 
@@ -754,7 +956,7 @@ void WebContentsAdapter::setContent(const QByteArray &data, const QString &mimeT
     params.can_load_local_resources = true;
     params.transition_type = ui::PageTransitionFromInt(ui::PAGE_TRANSITION_TYPED | ui::PAGE_TRANSITION_FROM_API);
     params.override_user_agent = content::NavigationController::UA_OVERRIDE_TRUE;
-    Navigate(this, params);
+    NavigateTask(sharedFromThis().toWeakRef(), std::move(params));
 }
 
 void WebContentsAdapter::save(const QString &filePath, int savePageFormat)
@@ -767,12 +969,16 @@ void WebContentsAdapter::save(const QString &filePath, int savePageFormat)
 
 QUrl WebContentsAdapter::activeUrl() const
 {
+    if (m_deferredHistory)
+        return m_deferredHistory->currentEntry()->virtualUrl;
     CHECK_INITIALIZED(QUrl());
     return m_webContentsDelegate->url(webContents());
 }
 
 QUrl WebContentsAdapter::requestedUrl() const
 {
+    if (m_deferredHistory)
+        return m_deferredHistory->currentEntry()->originalRequestUrl;
     CHECK_INITIALIZED(QUrl());
     content::NavigationEntry* entry = m_webContents->GetController().GetVisibleEntry();
     content::NavigationEntry* pendingEntry = m_webContents->GetController().GetPendingEntry();
@@ -803,6 +1009,8 @@ QIcon WebContentsAdapter::icon() const
 
 QString WebContentsAdapter::pageTitle() const
 {
+    if (m_deferredHistory)
+        return m_deferredHistory->currentEntry()->title;
     CHECK_INITIALIZED(QString());
     return m_webContentsDelegate->title();
 }
@@ -878,6 +1086,10 @@ void WebContentsAdapter::unselect()
 
 void WebContentsAdapter::navigateBack()
 {
+    if (m_deferredHistory) {
+        navigateToOffset(-1);
+        return;
+    }
     CHECK_INITIALIZED();
     base::RecordAction(base::UserMetricsAction("Back"));
     CHECK_VALID_RENDER_WIDGET_HOST_VIEW(m_webContents->GetPrimaryMainFrame());
@@ -889,6 +1101,10 @@ void WebContentsAdapter::navigateBack()
 
 void WebContentsAdapter::navigateForward()
 {
+    if (m_deferredHistory) {
+        navigateToOffset(1);
+        return;
+    }
     CHECK_INITIALIZED();
     base::RecordAction(base::UserMetricsAction("Forward"));
     CHECK_VALID_RENDER_WIDGET_HOST_VIEW(m_webContents->GetPrimaryMainFrame());
@@ -900,6 +1116,14 @@ void WebContentsAdapter::navigateForward()
 
 void WebContentsAdapter::navigateToIndex(int offset)
 {
+    if (m_deferredHistory) {
+        // Restore straight to the requested entry instead of loading the current one first.
+        if (!m_deferredHistory->entryAt(offset))
+            return;
+        m_deferredHistory->currentIndex = offset;
+        loadDefault();
+        return;
+    }
     CHECK_INITIALIZED();
     CHECK_VALID_RENDER_WIDGET_HOST_VIEW(m_webContents->GetPrimaryMainFrame());
     m_webContents->GetController().GoToIndex(offset);
@@ -908,6 +1132,10 @@ void WebContentsAdapter::navigateToIndex(int offset)
 
 void WebContentsAdapter::navigateToOffset(int offset)
 {
+    if (m_deferredHistory) {
+        navigateToIndex(m_deferredHistory->currentIndex + offset);
+        return;
+    }
     CHECK_INITIALIZED();
     CHECK_VALID_RENDER_WIDGET_HOST_VIEW(m_webContents->GetPrimaryMainFrame());
     m_webContents->GetController().GoToOffset(offset);
@@ -916,18 +1144,26 @@ void WebContentsAdapter::navigateToOffset(int offset)
 
 int WebContentsAdapter::navigationEntryCount()
 {
+    if (m_deferredHistory)
+        return int(m_deferredHistory->entries.size());
     CHECK_INITIALIZED(0);
     return navigationListSize(m_webContents->GetController());
 }
 
 int WebContentsAdapter::currentNavigationEntryIndex()
 {
+    if (m_deferredHistory)
+        return m_deferredHistory->currentIndex;
     CHECK_INITIALIZED(0);
     return navigationListCurrentIndex(m_webContents->GetController());
 }
 
 QUrl WebContentsAdapter::getNavigationEntryOriginalUrl(int index)
 {
+    if (m_deferredHistory) {
+        const SerializedNavigationEntry *entry = m_deferredHistory->entryAt(index);
+        return entry ? entry->originalRequestUrl : QUrl();
+    }
     CHECK_INITIALIZED(QUrl());
     content::NavigationEntry *entry = m_webContents->GetController().GetEntryAtIndex(index);
     return entry ? toQt(entry->GetOriginalRequestURL()) : QUrl();
@@ -935,6 +1171,10 @@ QUrl WebContentsAdapter::getNavigationEntryOriginalUrl(int index)
 
 QUrl WebContentsAdapter::getNavigationEntryUrl(int index)
 {
+    if (m_deferredHistory) {
+        const SerializedNavigationEntry *entry = m_deferredHistory->entryAt(index);
+        return entry ? entry->virtualUrl : QUrl();
+    }
     CHECK_INITIALIZED(QUrl());
     content::NavigationEntry *entry = m_webContents->GetController().GetEntryAtIndex(index);
     return entry ? toQt(entry->GetURL()) : QUrl();
@@ -942,6 +1182,10 @@ QUrl WebContentsAdapter::getNavigationEntryUrl(int index)
 
 QString WebContentsAdapter::getNavigationEntryTitle(int index)
 {
+    if (m_deferredHistory) {
+        const SerializedNavigationEntry *entry = m_deferredHistory->entryAt(index);
+        return entry ? entry->title : QString();
+    }
     CHECK_INITIALIZED(QString());
     content::NavigationEntry *entry = m_webContents->GetController().GetEntryAtIndex(index);
     return entry ? toQt(entry->GetTitle()) : QString();
@@ -949,6 +1193,10 @@ QString WebContentsAdapter::getNavigationEntryTitle(int index)
 
 QDateTime WebContentsAdapter::getNavigationEntryTimestamp(int index)
 {
+    if (m_deferredHistory) {
+        const SerializedNavigationEntry *entry = m_deferredHistory->entryAt(index);
+        return entry ? toQt(base::Time::FromInternalValue(entry->timestamp)) : QDateTime();
+    }
     CHECK_INITIALIZED(QDateTime());
     content::NavigationEntry *entry = m_webContents->GetController().GetEntryAtIndex(index);
     return entry ? toQt(entry->GetTimestamp()) : QDateTime();
@@ -956,6 +1204,10 @@ QDateTime WebContentsAdapter::getNavigationEntryTimestamp(int index)
 
 QUrl WebContentsAdapter::getNavigationEntryIconUrl(int index)
 {
+    if (m_deferredHistory) {
+        const SerializedNavigationEntry *entry = m_deferredHistory->entryAt(index);
+        return entry ? entry->iconUrl : QUrl();
+    }
     CHECK_INITIALIZED(QUrl());
     content::NavigationEntry *entry = m_webContents->GetController().GetEntryAtIndex(index);
     if (!entry)
@@ -966,6 +1218,13 @@ QUrl WebContentsAdapter::getNavigationEntryIconUrl(int index)
 
 void WebContentsAdapter::clearNavigationHistory()
 {
+    if (m_deferredHistory) {
+        SerializedNavigationEntry current = std::move(m_deferredHistory->entries[m_deferredHistory->currentIndex]);
+        m_deferredHistory->entries.clear();
+        m_deferredHistory->entries.push_back(std::move(current));
+        m_deferredHistory->currentIndex = 0;
+        return;
+    }
     CHECK_INITIALIZED();
     if (m_webContents->GetController().CanPruneAllButLastCommitted())
         m_webContents->GetController().PruneAllButLastCommitted();
@@ -973,6 +1232,10 @@ void WebContentsAdapter::clearNavigationHistory()
 
 void WebContentsAdapter::serializeNavigationHistory(QDataStream &output)
 {
+    if (m_deferredHistory) {
+        writeNavigationHistory(*m_deferredHistory, output);
+        return;
+    }
     CHECK_INITIALIZED();
     QtWebEngineCore::serializeNavigationHistory(m_webContents->GetController(), output);
 }
@@ -1057,6 +1320,13 @@ content::RenderFrameHost *WebContentsAdapter::renderFrameHostFromFrameId(quint64
 
 void WebContentsAdapter::runJavaScript(const QString &javaScript, quint32 worldId, quint64 frameId,
                                        const std::function<void(const QVariant &)> &callback)
+{
+    runJavaScript(javaScript, worldId, frameId, JavaScriptResultFormat::Variant, callback);
+}
+
+void WebContentsAdapter::runJavaScript(const QString &javaScript, quint32 worldId, quint64 frameId,
+                                       JavaScriptResultFormat format,
+                                       const std::function<void(const QVariant &)> &callback)
 {
     auto exit = [&] {
         if (callback)
@@ -1075,7 +1345,7 @@ void WebContentsAdapter::runJavaScript(const QString &javaScript, quint32 worldI
 
     content::RenderFrameHost::JavaScriptResultCallback internalCallback = base::NullCallback();
     if (callback) {
-        internalCallback = base::BindOnce(&callbackOnEvaluateJS, this, m_nextRequestId);
+        internalCallback = base::BindOnce(&callbackOnEvaluateJS, this, m_nextRequestId, format);
         m_javaScriptCallbacks.insert(m_nextRequestId, callback);
         ++m_nextRequestId;
     }
@@ -1086,12 +1356,114 @@ void WebContentsAdapter::runJavaScript(const QString &javaScript, quint32 worldI
                                               worldId);
 }
 
-void WebContentsAdapter::didRunJavaScript(quint64 requestId, const base::Value &result)
+void WebContentsAdapter::didRunJavaScript(quint64 requestId, const base::Value &result,
+                                          JavaScriptResultFormat format)
 {
     Q_ASSERT(requestId);
     auto callback = m_javaScriptCallbacks.take(requestId);
     Q_ASSERT(callback);
-    callback(fromJSValue(&result));
+    callback(fromJSValue(result, format));
+}
+
+// The child indices leading from the main frame to a frame. Sorting by them yields
+// document order, frames of inner frame trees following the children of their owner.
+static std::vector<size_t> frameTreePosition(content::RenderFrameHost *rfh)
+{
+    std::vector<size_t> position;
+    auto *frame = static_cast<content::RenderFrameHostImpl *>(rfh);
+    while (content::RenderFrameHostImpl *parent = frame->GetParentOrOuterDocument()) {
+        size_t index = 0;
+        while (index < parent->child_count() && parent->child_at(index)->current_frame_host() != frame)
+            ++index;
+        position.push_back(index);
+        frame = parent;
+    }
+    std::reverse(position.begin(), position.end());
+    return position;
+}
+
+void WebContentsAdapter::runJavaScriptInFrames(
+        const QString &javaScript, quint32 worldId,
+        const std::function<bool(quint64 frameId)> &frameFilter, JavaScriptResultFormat format,
+        const std::function<void(const FrameJavaScriptResults &)> &callback)
+{
+    if (!isInitialized()) {
+        if (callback)
+            callback({});
+        return;
+    }
+
+    std::vector<content::RenderFrameHost *> frames;
+    m_webContents->GetPrimaryMainFrame()->ForEachRenderFrameHost(
+            [&frames, &frameFilter](content::RenderFrameHost *rfh) {
+                if (!rfh->IsRenderFrameLive()
+                    || !static_cast<content::RenderFrameHostImpl *>(rfh)->GetAssociatedLocalFrame())
+                    return;
+                if (frameFilter && !frameFilter(quint64(rfh->GetFrameTreeNodeId())))
+                    return;
+                frames.push_back(rfh);
+            });
+
+    if (frames.empty()) {
+        if (callback)
+            callback({});
+        return;
+    }
+
+    // ForEachRenderFrameHost() visits the frames breadth-first, results are reported in document order.
+    std::vector<std::pair<std::vector<size_t>, content::RenderFrameHost *>> positions;
+    positions.reserve(frames.size());
+    for (auto *rfh : frames)
+        positions.emplace_back(frameTreePosition(rfh), rfh);
+    std::stable_sort(positions.begin(), positions.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+    for (size_t i = 0; i < positions.size(); ++i)
+        frames[i] = positions[i].second;
+
+    const quint64 requestId = m_nextRequestId++;
+    if (callback) {
+        JavaScriptBatch &batch = m_javaScriptBatches[requestId];
+        batch.results.reserve(qsizetype(frames.size()));
+        for (auto *rfh : frames)
+            batch.results.append({ quint64(rfh->GetFrameTreeNodeId()), QVariant() });
+        batch.pending = qsizetype(frames.size());
+        batch.format = format;
+        batch.callback = callback;
+    }
+
+    // Dispatch all requests up front, so that frames living in different render
+    // processes execute the script in parallel.
+    const std::u16string source = toString16(javaScript);
+    for (size_t i = 0; i < frames.size(); ++i) {
+        content::RenderFrameHost::JavaScriptResultCallback internalCallback = base::NullCallback();
+        if (callback) {
+            // Frames that go away before replying still have to complete the batch.
+            internalCallback = mojo::WrapCallbackWithDefaultInvokeIfNotRun(
+                    base::BindOnce(&callbackOnEvaluateJSInFrame, this, requestId, qsizetype(i)),
+                    base::Value());
+        }
+        if (worldId == 0)
+            frames[i]->ExecuteJavaScript(source, std::move(internalCallback));
+        else
+            frames[i]->ExecuteJavaScriptInIsolatedWorld(source, std::move(internalCallback),
+                                                        worldId);
+    }
+}
+
+void WebContentsAdapter::didRunJavaScriptInFrame(quint64 requestId, qsizetype index,
+                                                 const base::Value &result)
+{
+    auto it = m_javaScriptBatches.find(requestId);
+    if (it == m_javaScriptBatches.end())
+        return;
+    JavaScriptBatch &batch = it->second;
+    Q_ASSERT(index < batch.results.size());
+    batch.results[index].second = fromJSValue(result, batch.format);
+    if (--batch.pending > 0)
+        return;
+    JavaScriptBatch finished = std::move(batch);
+    m_javaScriptBatches.erase(it);
+    finished.callback(finished.results);
 }
 
 // Called when QWebEnginePage is deleted
@@ -1100,6 +1472,11 @@ void WebContentsAdapter::clearJavaScriptCallbacks()
     for (auto varFun : std::as_const(m_javaScriptCallbacks))
         varFun(QVariant());
     m_javaScriptCallbacks.clear();
+
+    auto batches = std::move(m_javaScriptBatches);
+    m_javaScriptBatches.clear();
+    for (auto &pair : batches)
+        pair.second.callback(pair.second.results);
 }
 
 quint64 WebContentsAdapter::fetchDocumentMarkup()
@@ -1116,6 +1493,54 @@ quint64 WebContentsAdapter::fetchDocumentInnerText()
     return m_nextRequestId++;
 }
 
+void WebContentsAdapter::fetchDocumentMarkup(const DocumentChunkCallback &callback)
+{
+    Q_ASSERT(callback);
+    if (!isInitialized())
+        return callback(QByteArrayView(), true);
+    m_documentChunkCallbacks.emplace(m_nextRequestId, callback);
+    m_pageHost->FetchDocumentMarkup(m_nextRequestId++,
+                                    base::BindOnce(&callbackOnFetchDocumentUtf8, this));
+}
+
+void WebContentsAdapter::fetchDocumentInnerText(const DocumentChunkCallback &callback)
+{
+    Q_ASSERT(callback);
+    if (!isInitialized())
+        return callback(QByteArrayView(), true);
+    m_documentChunkCallbacks.emplace(m_nextRequestId, callback);
+    m_pageHost->FetchDocumentInnerText(m_nextRequestId++,
+                                       base::BindOnce(&callbackOnFetchDocumentUtf8, this));
+}
+
+void WebContentsAdapter::didFetchDocumentUtf8(quint64 requestId, const std::string &result)
+{
+    auto it = m_documentChunkCallbacks.find(requestId);
+    if (it == m_documentChunkCallbacks.end())
+        return;
+    DocumentChunkCallback callback = std::move(it->second);
+    m_documentChunkCallbacks.erase(it);
+
+    // Hand out views into the UTF-8 buffer received from the renderer instead of
+    // converting it to QString, so that huge documents are not copied again.
+    size_t offset = 0;
+    do {
+        const size_t length = std::min(kDocumentChunkSize, result.size() - offset);
+        const QByteArrayView chunk(result.data() + offset, qsizetype(length));
+        offset += length;
+        callback(chunk, offset == result.size());
+    } while (offset < result.size());
+}
+
+// Called when QWebEnginePage is deleted
+void WebContentsAdapter::clearDocumentChunkCallbacks()
+{
+    auto callbacks = std::move(m_documentChunkCallbacks);
+    m_documentChunkCallbacks.clear();
+    for (auto &pair : callbacks)
+        pair.second(QByteArrayView(), true);
+}
+
 void WebContentsAdapter::updateWebPreferences(const blink::web_pref::WebPreferences &webPreferences)
 {
     CHECK_INITIALIZED();
@@ -1182,6 +1607,56 @@ void WebContentsAdapter::download(const QUrl &url, const QString &suggestedFileN
     dlm->DownloadUrl(std::move(params));
 }
 
+void WebContentsAdapter::prerender(const QUrl &url, const std::function<void(bool used)> &callback)
+{
+    CHECK_INITIALIZED();
+    // Only a single prerendered page is kept, replacing it counts as unused.
+    prerenderNavigationFinished(false);
+
+    const GURL gurl = toGurl(url);
+    if (gurl.SchemeIsHTTPOrHTTPS())
+        m_prerenderHandle = m_webContentsDelegate->startPrerendering(gurl);
+    m_prerenderCallback = callback;
+    if (!m_prerenderHandle)
+        prerenderNavigationFinished(false);
+}
+
+void WebContentsAdapter::prerenderNavigationFinished(bool activated)
+{
+    m_prerenderHandle.reset();
+    if (auto callback = std::exchange(m_prerenderCallback, nullptr))
+        callback(activated);
+}
+
+// Capture callbacks are always run asynchronously, also when the capture cannot start.
+static void postNullCapture(const std::function<void(const QImage &)> &callback)
+{
+    content::GetUIThreadTaskRunner({})->PostTask(
+            FROM_HERE,
+            base::BindOnce([](const std::function<void(const QImage &)> &callback) { callback(QImage()); },
+                           callback));
+}
+
+void WebContentsAdapter::capture(const QRect &rect, qreal scale,
+                                 const std::function<void(const QImage &)> &callback)
+{
+    if (!isInitialized() || scale <= 0) {
+        postNullCapture(callback);
+        return;
+    }
+    PageCapture::capture(m_webContents.get(), rect, scale, callback);
+}
+
+void WebContentsAdapter::captureFullPage(int width, qreal scale,
+                                         const std::function<void(const QImage &)> &callback)
+{
+    if (!isInitialized() || width <= 0 || scale <= 0) {
+        postNullCapture(callback);
+        return;
+    }
+    PageCapture::captureFullPage(m_webContents.get(), width, scale, callback);
+}
+
 bool WebContentsAdapter::isAudioMuted() const
 {
     CHECK_INITIALIZED(false);
@@ -1337,12 +1812,14 @@ void WebContentsAdapter::changedFullScreen()
 void WebContentsAdapter::wasShown()
 {
     CHECK_INITIALIZED();
+    m_lastActiveTime = std::chrono::steady_clock::now();
     m_webContents->WasShown();
 }
 
 void WebContentsAdapter::wasHidden()
 {
     CHECK_INITIALIZED();
+    m_lastActiveTime = std::chrono::steady_clock::now();
     m_webContents->WasHidden();
 }
 
@@ -2105,6 +2582,8 @@ void WebContentsAdapter::setLifecycleState(LifecycleState state)
 
     // Prevent recursion due to initializationFinished() in undiscard().
     m_lifecycleState = to;
+    if (to == LifecycleState::Active)
+        m_lastActiveTime = std::chrono::steady_clock::now();
 
     switch (to) {
     case LifecycleState::Active:
@@ -2272,6 +2751,7 @@ void WebContentsAdapter::discard()
 #if BUILDFLAG(ENABLE_EXTENSIONS)
     extensions::ExtensionWebContentsObserverQt::CreateForWebContents(webContents());
 #endif
+    initializePageLoadMetricsForWebContents(webContents());
 }
 
 void WebContentsAdapter::undiscard()
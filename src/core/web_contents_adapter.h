@@ -15,6 +15,7 @@
 #ifndef WEB_CONTENTS_ADAPTER_H
 #define WEB_CONTENTS_ADAPTER_H
 
+#include <QtCore/QByteArrayView>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QMap>
 #include <QtCore/QString>
@@ -30,6 +31,7 @@
 
 #include "web_contents_adapter_client.h"
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -45,6 +47,7 @@ class Value;
 }
 
 namespace content {
+class PrerenderHandle;
 class WebContents;
 class SiteInstance;
 class RenderFrameHost;
@@ -55,6 +58,7 @@ class QAccessibleInterface;
 class QDragEnterEvent;
 class QDragMoveEvent;
 class QDropEvent;
+class QImage;
 class QMimeData;
 class QPageLayout;
 class QPageRanges;
@@ -67,6 +71,7 @@ namespace QtWebEngineCore {
 
 class DevToolsFrontendQt;
 class FindTextHelper;
+struct NavigationHistorySnapshot;
 class ProfileQt;
 class WebEnginePageHost;
 class WebChannelIPCTransportHost;
@@ -79,6 +84,8 @@ public:
     static constexpr quint64 kInvalidFrameId = -3;
 
     static QSharedPointer<WebContentsAdapter> createFromSerializedNavigationHistory(QDataStream &input, WebContentsAdapterClient *adapterClient);
+    // Only parses the history, the WebContents is created and restored once the adapter is initialized.
+    static QSharedPointer<WebContentsAdapter> createWithDeferredNavigationHistory(QDataStream &input);
     WebContentsAdapter();
     WebContentsAdapter(std::unique_ptr<content::WebContents> webContents);
     ~WebContentsAdapter();
@@ -86,6 +93,7 @@ public:
     void setClient(WebContentsAdapterClient *adapterClient);
 
     bool isInitialized() const;
+    bool hasDeferredNavigationHistory() const;
 
     // These and only these methods will initialize the WebContentsAdapter. All
     // other methods below will do nothing until one of these has been called.
@@ -140,16 +148,41 @@ public:
     void serializeNavigationHistory(QDataStream &output);
     void setZoomFactor(qreal);
     qreal currentZoomFactor() const;
+    // How the result of a script is passed to the callback of runJavaScript().
+    enum class JavaScriptResultFormat {
+        Variant, // QVariant tree as returned by QWebEnginePage::runJavaScript()
+        Json, // QByteArray holding UTF-8 encoded JSON
+        Cbor, // QCborValue
+        Binary, // QByteArray holding the contents of an ArrayBuffer or the UTF-8 of a string
+    };
+    void runJavaScript(const QString &javaScript, quint32 worldId, quint64 frameId,
+                       const std::function<void(const QVariant &)> &callback);
     void runJavaScript(const QString &javaScript, quint32 worldId, quint64 frameId,
+                       JavaScriptResultFormat format,
                        const std::function<void(const QVariant &)> &callback);
-    void didRunJavaScript(quint64 requestId, const base::Value &result);
+    void didRunJavaScript(quint64 requestId, const base::Value &result,
+                          JavaScriptResultFormat format = JavaScriptResultFormat::Variant);
+    using FrameJavaScriptResults = QList<std::pair<quint64, QVariant>>;
+    void runJavaScriptInFrames(const QString &javaScript, quint32 worldId,
+                               const std::function<bool(quint64 frameId)> &frameFilter,
+                               JavaScriptResultFormat format,
+                               const std::function<void(const FrameJavaScriptResults &)> &callback);
+    void didRunJavaScriptInFrame(quint64 requestId, qsizetype index, const base::Value &result);
     void clearJavaScriptCallbacks();
     quint64 fetchDocumentMarkup();
     quint64 fetchDocumentInnerText();
+    using DocumentChunkCallback = std::function<void(QByteArrayView chunk, bool finished)>;
+    void fetchDocumentMarkup(const DocumentChunkCallback &callback);
+    void fetchDocumentInnerText(const DocumentChunkCallback &callback);
+    void didFetchDocumentUtf8(quint64 requestId, const std::string &result);
+    void clearDocumentChunkCallbacks();
     void updateWebPreferences(const blink::web_pref::WebPreferences &webPreferences);
     void download(const QUrl &url, const QString &suggestedFileName,
                   const QUrl &referrerUrl = QUrl(),
                   ReferrerPolicy referrerPolicy = ReferrerPolicy::Default);
+    void prerender(const QUrl &url, const std::function<void(bool used)> &callback);
+    void capture(const QRect &rect, qreal scale, const std::function<void(const QImage &)> &callback);
+    void captureFullPage(int width, qreal scale, const std::function<void(const QImage &)> &callback);
     bool isAudioMuted() const;
     void setAudioMuted(bool mute);
     bool recentlyAudible() const;
@@ -240,6 +273,8 @@ public:
     content::WebContents *guestWebContents() const;
     WebContentsAdapterClient *adapterClient();
     void updateRecommendedState();
+    std::chrono::steady_clock::time_point lastActiveTime() const { return m_lastActiveTime; }
+    void prerenderNavigationFinished(bool activated);
     void setRequestInterceptor(QWebEngineUrlRequestInterceptor *interceptor);
     QWebEngineUrlRequestInterceptor* requestInterceptor() const;
 
@@ -262,6 +297,14 @@ private:
     void initializeRenderPrefs();
 
     ProfileAdapter *m_profileAdapter;
+    struct JavaScriptBatch {
+        FrameJavaScriptResults results;
+        qsizetype pending;
+        JavaScriptResultFormat format;
+        std::function<void(const FrameJavaScriptResults &)> callback;
+    };
+    // Outlives m_webContents, whose frames complete the pending requests when they go away.
+    std::map<quint64, JavaScriptBatch> m_javaScriptBatches;
     std::unique_ptr<content::WebContents> m_webContents;
     std::unique_ptr<WebContentsDelegateQt> m_webContentsDelegate;
     std::unique_ptr<WebEnginePageHost> m_pageHost;
@@ -275,6 +318,7 @@ private:
     QMap<QUrl, bool> m_pendingMouseLockPermissions;
     QMap<quint64, std::function<void(const QVariant &)>> m_javaScriptCallbacks;
     std::map<quint64, std::function<void(QSharedPointer<QByteArray>)>> m_printCallbacks;
+    std::map<quint64, DocumentChunkCallback> m_documentChunkCallbacks;
     std::unique_ptr<content::DropData> m_currentDropData;
     uint m_currentDropAction;
     bool m_updateDragActionCalled;
@@ -284,9 +328,13 @@ private:
     DevToolsFrontendQt *m_devToolsFrontend;
     LifecycleState m_lifecycleState = LifecycleState::Active;
     LifecycleState m_recommendedState = LifecycleState::Active;
+    std::chrono::steady_clock::time_point m_lastActiveTime = std::chrono::steady_clock::now();
     bool m_inspector = false;
     bool m_documentIsHandlingDrag = false;
     QPointer<QWebEngineUrlRequestInterceptor> m_requestInterceptor;
+    std::unique_ptr<content::PrerenderHandle> m_prerenderHandle;
+    std::function<void(bool)> m_prerenderCallback;
+    std::unique_ptr<NavigationHistorySnapshot> m_deferredHistory;
 };
 
 } // namespace QtWebEngineCore
@@ -64,6 +64,22 @@ class WebContentsAdapter;
 class WebContentsDelegateQt;
 class WebEngineSettings;
 
+// Durations in milliseconds, -1 if not available.
+struct PageLoadMetrics {
+    QUrl url;
+    bool isFinal = false;
+    qint64 domainLookup = -1;
+    qint64 connect = -1;
+    qint64 tlsHandshake = -1;
+    qint64 firstInputDelay = -1;
+    // The remaining ones are relative to the start of the navigation.
+    qint64 timeToFirstByte = -1;
+    qint64 firstContentfulPaint = -1;
+    qint64 largestContentfulPaint = -1;
+    qint64 loadEventStart = -1;
+    double cumulativeLayoutShift = 0;
+};
+
 class Q_WEBENGINECORE_EXPORT WebContentsAdapterClient {
 public:
     // This must match window_open_disposition_list.h.
@@ -162,6 +178,7 @@ public:
     virtual void loadStarted(QWebEngineLoadingInfo info) = 0;
     virtual void loadCommitted() = 0;
     virtual void loadFinished(QWebEngineLoadingInfo info) = 0;
+    virtual void pageLoadMetricsReported(const PageLoadMetrics &) { }
     virtual void focusContainer() = 0;
     virtual void unhandledKeyEvent(QKeyEvent *event) = 0;
     virtual QSharedPointer<WebContentsAdapter>
@@ -20,10 +20,12 @@
 #include "media_capture_devices_dispatcher.h"
 #include "native_web_keyboard_event_qt.h"
 #include "profile_adapter.h"
+#include "preloading_hints.h"
 #include "profile_qt.h"
 #include "qwebengineloadinginfo.h"
 #include "qwebengineregisterprotocolhandlerrequest.h"
 #include "render_widget_host_view_qt.h"
+#include "spare_render_process_manager.h"
 #include "type_conversion.h"
 #include "visited_links_manager_qt.h"
 #include "web_contents_adapter_client.h"
@@ -34,6 +36,7 @@
 #include "web_engine_settings.h"
 #include "certificate_error_controller.h"
 
+#include "base/auto_reset.h"
 #include "components/custom_handlers/protocol_handler_registry.h"
 #include "components/web_cache/browser/web_cache_manager.h"
 #include "content/browser/renderer_host/render_frame_host_impl.h"
@@ -44,6 +47,9 @@
 #include "content/public/browser/media_stream_request.h"
 #include "content/public/browser/navigation_entry.h"
 #include "content/public/browser/navigation_handle.h"
+#include "content/public/browser/preloading.h"
+#include "content/public/browser/prerender_handle.h"
+#include "content/public/browser/prerender_trigger_type.h"
 #include "content/public/browser/render_view_host.h"
 #include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_process_host.h"
@@ -296,8 +302,9 @@ void WebContentsDelegateQt::RenderFrameHostChanged(content::RenderFrameHost *old
         content::FrameTreeNode *new_node = static_cast<content::RenderFrameHostImpl *>(new_host)->frame_tree_node();
         m_frameFocusedObserver.addNode(new_node);
 
-        // Is this a main frame?
-        if (new_host->GetFrameOwnerElementType() == blink::FrameOwnerElementType::kNone) {
+        // Is this a main frame? Prerendered pages are only reported once activated.
+        if (new_host->GetFrameOwnerElementType() == blink::FrameOwnerElementType::kNone
+            && new_host->GetLifecycleState() != content::RenderFrameHost::LifecycleState::kPrerendering) {
             content::RenderProcessHost *renderProcessHost = new_host->GetProcess();
             const base::Process &process = renderProcessHost->GetProcess();
             if (process.IsValid()) {
@@ -357,7 +364,7 @@ void WebContentsDelegateQt::DidStartNavigation(content::NavigationHandle *naviga
     if (!webEngineSettings()->testAttribute(QWebEngineSettings::ErrorPageEnabled))
         navigation_handle->SetSilentlyIgnoreErrors();
 
-    if (!navigation_handle->IsInMainFrame() || navigation_handle->IsSameDocument())
+    if (!navigation_handle->IsInPrimaryMainFrame() || navigation_handle->IsSameDocument())
         return;
 
     m_loadingInfo.url = toQt(navigation_handle->GetURL());
@@ -391,7 +398,8 @@ void WebContentsDelegateQt::emitLoadFinished(bool isErrorPage)
     QWebEngineLoadingInfo info(m_loadingInfo.url, loadStatus, m_loadingInfo.isErrorPage,
                                m_loadingInfo.errorDescription, m_loadingInfo.errorCode,
                                QWebEngineLoadingInfo::ErrorDomain(m_loadingInfo.errorDomain),
-                               m_loadingInfo.responseHeaders, m_loadingInfo.isDownload);
+                               m_loadingInfo.responseHeaders, m_loadingInfo.isDownload,
+                               m_loadingInfo.usedSpareRenderProcess);
     m_viewClient->loadFinished(std::move(info));
     m_viewClient->updateNavigationActions();
 }
@@ -405,12 +413,24 @@ void WebContentsDelegateQt::emitLoadCommitted()
 
 void WebContentsDelegateQt::DidFinishNavigation(content::NavigationHandle *navigation_handle)
 {
-    if (!navigation_handle->IsInMainFrame())
+    if (!navigation_handle->IsInPrimaryMainFrame())
         return;
 
     if (navigation_handle->IsDownload())
         m_loadingInfo.isDownload = true;
 
+    if (navigation_handle->HasCommitted() && !navigation_handle->IsSameDocument()) {
+        const bool activated = navigation_handle->IsPrerenderedPageActivation();
+        webContentsAdapter()->prerenderNavigationFinished(activated);
+        // The prerendered page finished loading before, so DidFinishLoad is not called again.
+        if (activated)
+            m_loadingInfo.success = true;
+        if (auto *manager = m_viewClient->profileAdapter()->spareRenderProcessManager()) {
+            m_loadingInfo.usedSpareRenderProcess =
+                    manager->takeSpareRenderProcess(navigation_handle->GetRenderFrameHost()->GetProcess());
+        }
+    }
+
     if (navigation_handle->HasCommitted() && !navigation_handle->IsErrorPage()) {
         ProfileAdapter *profileAdapter = m_viewClient->profileAdapter();
         // VisistedLinksMaster asserts !IsOffTheRecord().
@@ -508,6 +528,9 @@ void WebContentsDelegateQt::didFailLoad(const QUrl &url, int errorCode, const QS
 
 void WebContentsDelegateQt::DidFailLoad(content::RenderFrameHost* render_frame_host, const GURL& validated_url, int error_code)
 {
+    if (render_frame_host->GetLifecycleState() == content::RenderFrameHost::LifecycleState::kPrerendering)
+        return;
+
     setLoadingState(LoadingState::Loaded);
 
     if (render_frame_host != web_contents()->GetPrimaryMainFrame())
@@ -526,6 +549,9 @@ void WebContentsDelegateQt::DidFailLoad(content::RenderFrameHost* render_frame_h
 void WebContentsDelegateQt::DidFinishLoad(content::RenderFrameHost* render_frame_host, const GURL& validated_url)
 {
     Q_ASSERT(validated_url.is_valid());
+    if (render_frame_host->GetLifecycleState() == content::RenderFrameHost::LifecycleState::kPrerendering)
+        return;
+
     if (validated_url.spec() == content::kUnreachableWebDataURL) {
         // Trigger LoadFinished signal for main frame's error page only.
         if (!render_frame_host->GetParent()) {
@@ -858,6 +884,22 @@ bool WebContentsDelegateQt::TakeFocus(content::WebContents *source, bool reverse
     return m_viewClient->passOnFocus(reverse);
 }
 
+bool WebContentsDelegateQt::IsPrerender2Supported(content::WebContents &)
+{
+    // Pages are only prerendered on request of the application, not by speculation rules.
+    return m_prerenderingAllowed;
+}
+
+std::unique_ptr<content::PrerenderHandle> WebContentsDelegateQt::startPrerendering(const GURL &url)
+{
+    base::AutoReset<bool> allowPrerendering(&m_prerenderingAllowed, true);
+    // The transition has to match the one used by WebContentsAdapter::load() for the page to be activated.
+    return web_contents()->StartPrerendering(
+            url, content::PrerenderTriggerType::kEmbedder, "QtWebEngine",
+            ui::PageTransitionFromInt(ui::PAGE_TRANSITION_TYPED | ui::PAGE_TRANSITION_FROM_ADDRESS_BAR),
+            content::PreloadingHoldbackStatus::kUnspecified, /* preloading_attempt = */ nullptr);
+}
+
 void WebContentsDelegateQt::ContentsZoomChange(bool zoom_in)
 {
     WebContentsAdapter *adapter = webContentsAdapter();
@@ -871,9 +913,13 @@ void WebContentsDelegateQt::ResourceLoadComplete(content::RenderFrameHost* rende
                                                  const content::GlobalRequestID& request_id,
                                                  const blink::mojom::ResourceLoadInfo& resource_load_info)
 {
-    Q_UNUSED(render_frame_host);
     Q_UNUSED(request_id);
 
+    m_viewClient->profileAdapter()->preloadingHints()->resourceLoaded(resource_load_info);
+
+    if (render_frame_host->GetLifecycleState() == content::RenderFrameHost::LifecycleState::kPrerendering)
+        return;
+
     if (resource_load_info.request_destination == network::mojom::RequestDestination::kDocument) {
         m_isDocumentEmpty = (resource_load_info.raw_body_bytes == 0);
     }
@@ -23,6 +23,7 @@ namespace blink {
 namespace content {
 class ColorChooser;
 class JavaScriptDialogManager;
+class PrerenderHandle;
 class WebContents;
 struct MediaStreamRequest;
 }
@@ -113,6 +114,7 @@ public:
     void RegisterProtocolHandler(content::RenderFrameHost* frame_host, const std::string& protocol, const GURL& url, bool user_gesture) override;
     void UnregisterProtocolHandler(content::RenderFrameHost* frame_host, const std::string& protocol, const GURL& url, bool user_gesture) override;
     bool TakeFocus(content::WebContents *source, bool reverse) override;
+    bool IsPrerender2Supported(content::WebContents &web_contents) override;
     void ContentsZoomChange(bool zoom_in) override;
 
     // WebContentsObserver overrides
@@ -144,6 +146,7 @@ public:
     void requestFeaturePermission(QWebEnginePermission::PermissionType permissionType, const QUrl &requestingOrigin);
     void launchExternalURL(const QUrl &url, ui::PageTransition page_transition, bool is_main_frame, bool has_user_gesture);
     FindTextHelper *findTextHelper();
+    std::unique_ptr<content::PrerenderHandle> startPrerendering(const GURL &url);
 
     void setSavePageInfo(SavePageInfo *spi) { m_savePageInfo.reset(spi); }
     SavePageInfo *savePageInfo() { return m_savePageInfo.get(); }
@@ -209,10 +212,12 @@ private:
         bool triggersErrorPage = false;
         QMultiMap<QByteArray, QByteArray> responseHeaders;
         bool isDownload = false;
+        bool usedSpareRenderProcess = false;
         void clear() { *this = LoadingInfo(); }
     } m_loadingInfo;
 
     bool m_isDocumentEmpty = true;
+    bool m_prerenderingAllowed = false;
     base::WeakPtrFactory<WebContentsDelegateQt> m_weakPtrFactory { this };
     QList<QWeakPointer<CertificateErrorController>> m_certificateErrorControllers;
 };
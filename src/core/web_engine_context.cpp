@@ -15,6 +15,7 @@
 #include "base/power_monitor/power_monitor.h"
 #include "base/power_monitor/power_monitor_device_source.h"
 #include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/task/sequence_manager/thread_controller_with_message_pump_impl.h"
 #include "base/task/thread_pool/thread_pool_instance.h"
@@ -31,7 +32,9 @@
 #include "chrome/browser/printing/print_job_manager.h"
 #endif
 #include "components/discardable_memory/service/discardable_shared_memory_manager.h"
+#include "components/download/public/common/download_features.h"
 #include "components/download/public/common/download_task_runner.h"
+#include "components/download/public/common/parallel_download_configs.h"
 #include "components/viz/common/features.h"
 #include "components/web_cache/browser/web_cache_manager.h"
 #include "content/app/mojo_ipc_support.h"
@@ -89,12 +92,14 @@
 #if QT_CONFIG(accessibility)
 #include "accessibility_activation_observer.h"
 #endif
+#include "api/qwebengineglobalsettings_p.h"
 #include "api/qwebengineurlscheme.h"
 #include "content_browser_client_qt.h"
 #include "content_client_qt.h"
 #include "content_main_delegate_qt.h"
 #include "devtools_manager_delegate_qt.h"
 #include "media_capture_devices_dispatcher.h"
+#include "memory_pressure_monitor_qt.h"
 #include "net/webui_controller_factory_qt.h"
 #include "profile_adapter.h"
 #include "type_conversion.h"
@@ -569,6 +574,58 @@ static void setupProxyPac(base::CommandLine *commandLine)
     }
 }
 
+static void setupRasterSettings(base::CommandLine *commandLine)
+{
+    const QWebEngineGlobalSettings::RasterSettings &settings =
+            QWebEngineGlobalSettingsPrivate::instance()->rasterSettings;
+    // Switches given explicitly on the command line take precedence.
+    if (settings.threadCount > 0 && !commandLine->HasSwitch(switches::kNumRasterThreads))
+        commandLine->AppendSwitchASCII(switches::kNumRasterThreads,
+                                       base::NumberToString(settings.threadCount));
+    if (settings.tileSize.isValid() && !commandLine->HasSwitch(cc::switches::kDefaultTileWidth)
+        && !commandLine->HasSwitch(cc::switches::kDefaultTileHeight)) {
+        commandLine->AppendSwitchASCII(cc::switches::kDefaultTileWidth,
+                                       base::NumberToString(settings.tileSize.width()));
+        commandLine->AppendSwitchASCII(cc::switches::kDefaultTileHeight,
+                                       base::NumberToString(settings.tileSize.height()));
+    }
+    if (commandLine->HasSwitch(switches::kEnableZeroCopy)
+        || commandLine->HasSwitch(switches::kDisableZeroCopy))
+        return;
+    switch (settings.mode) {
+    case QWebEngineGlobalSettings::RasterMode::Default:
+        break;
+    case QWebEngineGlobalSettings::RasterMode::ZeroCopy:
+        commandLine->AppendSwitch(switches::kEnableZeroCopy);
+        break;
+    case QWebEngineGlobalSettings::RasterMode::OneCopy:
+        commandLine->AppendSwitch(switches::kDisableZeroCopy);
+        break;
+    }
+}
+
+static void setupParallelDownloads(std::vector<std::string> *enableFeatures)
+{
+    const QWebEngineGlobalSettings::ParallelDownloadSettings &settings =
+            QWebEngineGlobalSettingsPrivate::instance()->parallelDownloadSettings;
+    if (!settings.enabled)
+        return;
+    // The slicing is configured through field trial parameters of the feature.
+    std::vector<std::string> params;
+    if (settings.requestCount > 0) {
+        params.push_back(download::kParallelRequestCountFinchKey);
+        params.push_back(base::NumberToString(settings.requestCount));
+    }
+    if (settings.minimumSliceSize > 0) {
+        params.push_back(download::kMinSliceSizeFinchKey);
+        params.push_back(base::NumberToString(settings.minimumSliceSize));
+    }
+    std::string feature = download::features::kParallelDownloading.name;
+    if (!params.empty())
+        feature += ":" + base::JoinString(params, "/");
+    enableFeatures->push_back(feature);
+}
+
 static void cleanupVizProcess()
 {
     auto gpuChildThread = content::GpuChildThread::instance();
@@ -679,6 +736,7 @@ void WebEngineContext::destroy()
 {
     if (m_devtoolsServer)
         m_devtoolsServer->stop();
+    m_memoryPressureMonitor.reset();
 
     // Normally the GPU thread is shut down when the GpuProcessHost is destroyed
     // on IO thread (triggered by ~BrowserMainRunner). But by that time the UI
@@ -895,6 +953,7 @@ WebEngineContext::WebEngineContext()
             initCommandLine(useEmbeddedSwitches, enableGLSoftwareRendering);
 
     setupProxyPac(parsedCommandLine);
+    setupRasterSettings(parsedCommandLine);
     parsedCommandLine->AppendSwitchPath(switches::kBrowserSubprocessPath, WebEngineLibraryInfo::getPath(content::CHILD_PROCESS_EXE));
 
     parsedCommandLine->AppendSwitchASCII(switches::kApplicationName, QCoreApplication::applicationName().toUtf8().toPercentEncoding().toStdString());
@@ -918,6 +977,7 @@ WebEngineContext::WebEngineContext()
 
     enableFeatures.push_back(features::kNetworkServiceInProcess.name);
     enableFeatures.push_back(features::kTracingServiceInProcess.name);
+    setupParallelDownloads(&enableFeatures);
 #if defined(Q_OS_MACOS) && BUILDFLAG(USE_SCK)
     // The feature name should match the definition of kScreenCaptureKitMacScreen.
     enableFeatures.push_back("ScreenCaptureKitMacScreen");
@@ -1123,6 +1183,9 @@ WebEngineContext::WebEngineContext()
     // Initialize WebCacheManager here to ensure its subscription to render process creation events.
     web_cache::WebCacheManager::GetInstance();
 
+    if (QWebEngineGlobalSettingsPrivate::instance()->memoryPressureMonitoringEnabled)
+        setMemoryPressureMonitoringEnabled(true);
+
 #if defined(Q_OS_LINUX)
     media::AudioManager::SetGlobalAppName(QCoreApplication::applicationName().toStdString());
 #endif
@@ -1227,6 +1290,24 @@ bool WebEngineContext::closingDown()
     return m_closingDown;
 }
 
+bool WebEngineContext::isInitialized()
+{
+    return m_handle.get() && !m_destroyed;
+}
+
+bool isWebEngineContextInitialized()
+{
+    return WebEngineContext::isInitialized();
+}
+
+void WebEngineContext::setMemoryPressureMonitoringEnabled(bool enabled)
+{
+    if (!enabled)
+        m_memoryPressureMonitor.reset();
+    else if (!m_memoryPressureMonitor && MemoryPressureMonitorQt::isSupported())
+        m_memoryPressureMonitor = std::make_unique<MemoryPressureMonitorQt>();
+}
+
 void WebEngineContext::registerMainThreadFactories()
 {
     content::UtilityProcessHost::RegisterUtilityMainThreadFactory(content::CreateInProcessUtilityThread);
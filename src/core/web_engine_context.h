@@ -54,6 +54,7 @@ namespace QtWebEngineCore {
 class AccessibilityActivationObserver;
 class ContentMainDelegateQt;
 class DevToolsServerQt;
+class MemoryPressureMonitorQt;
 class ProfileAdapter;
 
 bool usingSoftwareDynamicGL();
@@ -67,6 +68,7 @@ public:
     static ProxyAuthentication qProxyNetworkAuthentication(QString host, int port);
     static void flushMessages();
     static bool closingDown();
+    static bool isInitialized();
     ProfileAdapter *createDefaultProfileAdapter();
     ProfileAdapter *defaultProfileAdapter();
 
@@ -78,6 +80,7 @@ public:
     void addProfileAdapter(ProfileAdapter *profileAdapter);
     void removeProfileAdapter(ProfileAdapter *profileAdapter);
     void destroy();
+    void setMemoryPressureMonitoringEnabled(bool enabled);
     static base::CommandLine *initCommandLine(bool &useEmbeddedSwitches,
                                               bool &enableGLSoftwareRendering);
 
@@ -98,6 +101,7 @@ private:
     std::unique_ptr<QObject> m_globalQObject;
     std::unique_ptr<ProfileAdapter> m_defaultProfileAdapter;
     std::unique_ptr<DevToolsServerQt> m_devtoolsServer;
+    std::unique_ptr<MemoryPressureMonitorQt> m_memoryPressureMonitor;
     QList<ProfileAdapter*> m_profileAdapters;
     std::unique_ptr<base::FieldTrialList> m_fieldTrialList;
 #if QT_CONFIG(accessibility)
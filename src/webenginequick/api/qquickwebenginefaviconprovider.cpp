@@ -79,9 +79,12 @@ static bool isIconURL(const QUrl &url)
     return false;
 }
 
-FaviconImageRequester::FaviconImageRequester(const QUrl &imageSource, const QSize &requestedSize)
+FaviconImageRequester::FaviconImageRequester(const QUrl &imageSource, const QSize &requestedSize,
+                                             QPointer<QQuickWebEngineView> processedView)
     : m_imageSource(imageSource), m_requestedSize(requestedSize)
 {
+    if (processedView)
+        m_processedViews.append(processedView);
 }
 
 void FaviconImageRequester::start()
@@ -154,6 +157,7 @@ QPointer<QQuickWebEngineView> FaviconImageRequester::getNextViewForProcessing()
 }
 
 FaviconProviderHelper::FaviconProviderHelper()
+    : m_iconCache(16 * 1024), m_pageIconUrls(4096)
 {
     moveToThread(qApp->thread());
 }
@@ -175,6 +179,19 @@ void FaviconProviderHelper::detach(QPointer<QQuickWebEngineView> view)
     m_views.removeAll(view);
 }
 
+void FaviconProviderHelper::iconUrlChanged(const QUrl &pageUrl, const QUrl &iconUrl)
+{
+    // The page may now resolve to another icon, and the icon may have been downloaded again.
+    m_pageIconUrls.remove(pageUrl);
+    if (iconUrl.isEmpty())
+        return;
+    const QList<FaviconCacheKey> keys = m_iconCache.keys();
+    for (const FaviconCacheKey &key : keys) {
+        if (key.iconUrl == iconUrl)
+            m_iconCache.remove(key);
+    }
+}
+
 void FaviconProviderHelper::handleImageRequest(QPointer<FaviconImageResponse> faviconResponse)
 {
     Q_ASSERT(QThread::currentThread() == QCoreApplication::instance()->thread());
@@ -198,9 +215,116 @@ void FaviconProviderHelper::handleImageRequest(QPointer<FaviconImageResponse> fa
             return;
         }
     }
+
+    if (respondFromCache(faviconResponse))
+        return;
+
+    if (!isIconURL(faviconResponse->imageSource())) {
+        m_pendingPageRequests.append(faviconResponse);
+        if (m_pendingPageRequests.size() == 1)
+            QMetaObject::invokeMethod(this, &FaviconProviderHelper::startPageRequests,
+                                      Qt::QueuedConnection);
+        return;
+    }
     startFaviconRequest(faviconResponse);
 }
 
+void FaviconProviderHelper::startPageRequests()
+{
+    const auto pendingRequests = std::exchange(m_pendingPageRequests, {});
+
+    QPointer<QQuickWebEngineView> view;
+    for (const QPointer<QQuickWebEngineView> &candidate : std::as_const(m_views)) {
+        if (!candidate.isNull() && !candidate->profile()->isOffTheRecord()) {
+            view = candidate;
+            break;
+        }
+    }
+
+    if (view.isNull()) {
+        // There is no non-otr view to access icon database.
+        for (const QPointer<FaviconImageResponse> &faviconResponse : pendingRequests) {
+            QMetaObject::invokeMethod(faviconResponse, "handleDone", Qt::QueuedConnection,
+                                      Q_ARG(QPixmap, QPixmap()));
+        }
+        return;
+    }
+
+    // One query for each distinct size, the database scales the icons to it.
+    QHash<int, QList<QPointer<FaviconImageResponse>>> responsesBySize;
+    for (const QPointer<FaviconImageResponse> &faviconResponse : pendingRequests) {
+        if (faviconResponse.isNull())
+            continue;
+        const QSize &requestedSize = faviconResponse->requestedSize();
+        responsesBySize[qMax(requestedSize.width(), requestedSize.height())].append(faviconResponse);
+    }
+
+    QtWebEngineCore::ProfileAdapter *profileAdapter = view->d_ptr->profileAdapter();
+    bool touchIconsEnabled = view->profile()->settings()->touchIconsEnabled();
+    for (auto it = responsesBySize.cbegin(); it != responsesBySize.cend(); ++it) {
+        QList<QUrl> pageUrls;
+        pageUrls.reserve(it.value().size());
+        for (const QPointer<FaviconImageResponse> &faviconResponse : it.value())
+            pageUrls.append(faviconResponse->imageSource());
+
+        // The callback is called once for each page URL, in order.
+        profileAdapter->requestIconsForPageURLs(
+                pageUrls, it.key(), touchIconsEnabled,
+                [this, view, responses = it.value(), index = 0](const QIcon &icon, const QUrl &iconUrl,
+                                                                const QUrl &) mutable {
+                    pageRequestDone(responses.at(index++), view, icon, iconUrl);
+                });
+    }
+}
+
+void FaviconProviderHelper::pageRequestDone(QPointer<FaviconImageResponse> faviconResponse,
+                                            QPointer<QQuickWebEngineView> view, const QIcon &icon,
+                                            const QUrl &iconUrl)
+{
+    if (faviconResponse.isNull())
+        return;
+
+    if (icon.isNull()) {
+        // Fall back to the icon databases of the other profiles.
+        startFaviconRequest(faviconResponse, view);
+        return;
+    }
+
+    const QPixmap pixmap = extractPixmap(icon, faviconResponse->requestedSize());
+    m_pageIconUrls.insert(faviconResponse->imageSource(), new QUrl(iconUrl));
+    addToCache(iconUrl, faviconResponse->requestedSize(), pixmap);
+    QMetaObject::invokeMethod(faviconResponse, "handleDone", Qt::QueuedConnection,
+                              Q_ARG(QPixmap, pixmap));
+}
+
+bool FaviconProviderHelper::respondFromCache(QPointer<FaviconImageResponse> faviconResponse)
+{
+    QUrl iconUrl = faviconResponse->imageSource();
+    if (!isIconURL(iconUrl)) {
+        const QUrl *pageIconUrl = m_pageIconUrls.object(iconUrl);
+        if (!pageIconUrl)
+            return false;
+        iconUrl = *pageIconUrl;
+    }
+
+    const QImage *image = m_iconCache.object({ iconUrl, faviconResponse->requestedSize() });
+    if (!image)
+        return false;
+
+    QMetaObject::invokeMethod(faviconResponse, "handleDone", Qt::QueuedConnection,
+                              Q_ARG(QPixmap, QPixmap::fromImage(*image)));
+    return true;
+}
+
+void FaviconProviderHelper::addToCache(const QUrl &iconUrl, const QSize &requestedSize,
+                                       const QPixmap &pixmap)
+{
+    if (pixmap.isNull())
+        return;
+    QImage *image = new QImage(pixmap.toImage());
+    m_iconCache.insert({ iconUrl, requestedSize }, image, qMax<qsizetype>(1, image->sizeInBytes() / 1024));
+}
+
 QPointer<QQuickWebEngineView> FaviconProviderHelper::findViewByImageSource(const QUrl &imageSource) const
 {
     for (QPointer<QQuickWebEngineView> view : m_views) {
@@ -219,12 +343,19 @@ QPointer<QQuickWebEngineView> FaviconProviderHelper::findViewByImageSource(const
     return nullptr;
 }
 
-void FaviconProviderHelper::startFaviconRequest(QPointer<FaviconImageResponse> faviconResponse)
+void FaviconProviderHelper::startFaviconRequest(QPointer<FaviconImageResponse> faviconResponse,
+                                                QPointer<QQuickWebEngineView> processedView)
 {
     FaviconImageRequester *requester = new FaviconImageRequester(faviconResponse->imageSource(),
-                                                                 faviconResponse->requestedSize());
-
-    connect(requester, &FaviconImageRequester::done, [requester, faviconResponse](QPixmap pixmap) {
+                                                                 faviconResponse->requestedSize(),
+                                                                 processedView);
+
+    const QUrl imageSource = faviconResponse->imageSource();
+    const QSize requestedSize = faviconResponse->requestedSize();
+    connect(requester, &FaviconImageRequester::done,
+            [this, requester, faviconResponse, imageSource, requestedSize](QPixmap pixmap) {
+        if (isIconURL(imageSource))
+            addToCache(imageSource, requestedSize, pixmap);
         QMetaObject::invokeMethod(faviconResponse, "handleDone", Qt::QueuedConnection,
                                   Q_ARG(QPixmap, pixmap));
         requester->deleteLater();
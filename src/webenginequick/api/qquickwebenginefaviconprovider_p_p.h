@@ -16,7 +16,10 @@
 //
 
 #include <QtWebEngineQuick/private/qtwebenginequickglobal_p.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qurl.h>
 #include <QtGui/qimage.h>
 #include <QtQuick/qquickimageprovider.h>
 
@@ -49,7 +52,8 @@ class FaviconImageRequester : public QObject
     Q_OBJECT
 
 public:
-    FaviconImageRequester(const QUrl &imageSource, const QSize &requestedSize);
+    FaviconImageRequester(const QUrl &imageSource, const QSize &requestedSize,
+                          QPointer<QQuickWebEngineView> processedView = nullptr);
     void start();
 
 public slots:
@@ -84,6 +88,21 @@ signals:
     void imageResponseRequested(QPointer<FaviconImageResponse> faviconResponse);
 };
 
+struct FaviconCacheKey
+{
+    QUrl iconUrl;
+    QSize size;
+
+    friend bool operator==(const FaviconCacheKey &lhs, const FaviconCacheKey &rhs) noexcept
+    {
+        return lhs.iconUrl == rhs.iconUrl && lhs.size == rhs.size;
+    }
+    friend size_t qHash(const FaviconCacheKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.iconUrl, key.size.width(), key.size.height());
+    }
+};
+
 class Q_WEBENGINEQUICK_EXPORT FaviconProviderHelper : public QObject
 {
     Q_OBJECT
@@ -92,6 +111,7 @@ public:
     static FaviconProviderHelper *instance();
     void attach(QPointer<QQuickWebEngineView> view);
     void detach(QPointer<QQuickWebEngineView> view);
+    void iconUrlChanged(const QUrl &pageUrl, const QUrl &iconUrl);
     const QList<QPointer<QQuickWebEngineView>> &views() const { return m_views; }
 
 public slots:
@@ -99,9 +119,22 @@ public slots:
 
 private:
     FaviconProviderHelper();
-    void startFaviconRequest(QPointer<FaviconImageResponse> faviconResponse);
+    void startFaviconRequest(QPointer<FaviconImageResponse> faviconResponse,
+                             QPointer<QQuickWebEngineView> processedView = nullptr);
+    void startPageRequests();
+    void pageRequestDone(QPointer<FaviconImageResponse> faviconResponse,
+                         QPointer<QQuickWebEngineView> view, const QIcon &icon,
+                         const QUrl &iconUrl);
+    bool respondFromCache(QPointer<FaviconImageResponse> faviconResponse);
+    void addToCache(const QUrl &iconUrl, const QSize &requestedSize, const QPixmap &pixmap);
     QPointer<QQuickWebEngineView> findViewByImageSource(const QUrl &imageSource) const;
     QList<QPointer<QQuickWebEngineView>> m_views;
+
+    // Requests for page URLs are collected and resolved with one query per event loop pass.
+    QList<QPointer<FaviconImageResponse>> m_pendingPageRequests;
+    // Decoded icons by icon URL and requested size, the cost is in KiB.
+    QCache<FaviconCacheKey, QImage> m_iconCache;
+    QCache<QUrl, QUrl> m_pageIconUrls;
 };
 
 QT_END_NAMESPACE
@@ -599,6 +599,7 @@ void QQuickWebEngineViewPrivate::iconChanged(const QUrl &url)
         return;
 
     iconUrl = QQuickWebEngineFaviconProvider::faviconProviderUrl(url);
+    FaviconProviderHelper::instance()->iconUrlChanged(adapter->activeUrl(), url);
     m_history->reset();
     QTimer::singleShot(0, q, &QQuickWebEngineView::iconChanged);
 }
@@ -37,9 +37,11 @@ private Q_SLOTS:
     void setInvalidCookie();
     void cookieSignals();
     void batchCookieTasks();
+    void bulkCookies();
     void basicFilter();
     void basicFilterOverHTTP();
     void html5featureFilter();
+    void accessRules();
 
 private:
     QWebEngineProfile *m_profile;
@@ -221,6 +223,63 @@ void tst_QWebEngineCookieStore::batchCookieTasks()
     QWE_TRY_COMPARE(cookieRemovedSpy.size(), 4);
 }
 
+void tst_QWebEngineCookieStore::bulkCookies()
+{
+    QWebEnginePage page(m_profile);
+    QWebEngineCookieStore *client = m_profile->cookieStore();
+
+    QSignalSpy loadSpy(&page, SIGNAL(loadFinished(bool)));
+
+    // force to init storage as it's done lazily upon first navigation
+    page.load(QUrl("about:blank"));
+    QWE_TRY_COMPARE(loadSpy.size(), 1);
+
+    QList<QNetworkCookie> cookies;
+    for (int i = 0; i < 25; ++i) {
+        QNetworkCookie cookie(QByteArray("cookie") + QByteArray::number(i), "value");
+        cookie.setDomain(i % 5 ? QStringLiteral(".example.com") : QStringLiteral(".sub.example.org"));
+        cookie.setPath(QStringLiteral("/"));
+        cookies.append(cookie);
+    }
+
+    qsizetype imported = -1;
+    client->setCookies(cookies, QUrl(), [&imported](qsizetype count) { imported = count; });
+    QWE_TRY_COMPARE(imported, 25);
+
+    QList<QNetworkCookie> all;
+    bool allReceived = false;
+    client->getCookies([&](const QList<QNetworkCookie> &result) { all = result; allReceived = true; });
+    QWE_TRY_VERIFY(allReceived);
+    QCOMPARE(all.size(), 25);
+
+    QList<QNetworkCookie> filtered;
+    bool filteredReceived = false;
+    client->getCookies([&](const QList<QNetworkCookie> &result) { filtered = result; filteredReceived = true; },
+                       QStringLiteral("example.org"));
+    QWE_TRY_VERIFY(filteredReceived);
+    QCOMPARE(filtered.size(), 5);
+
+    QList<qsizetype> pageSizes;
+    bool lastPageReceived = false;
+    client->getCookies(10, [&](const QList<QNetworkCookie> &cookiePage, bool last) {
+        pageSizes.append(cookiePage.size());
+        lastPageReceived = last;
+        return true;
+    });
+    QWE_TRY_VERIFY(lastPageReceived);
+    QCOMPARE(pageSizes, QList<qsizetype>({ 10, 10, 5 }));
+
+    // Stopping after the first page
+    pageSizes.clear();
+    client->getCookies(10, [&](const QList<QNetworkCookie> &cookiePage, bool) {
+        pageSizes.append(cookiePage.size());
+        return false;
+    });
+    QWE_TRY_COMPARE(pageSizes.size(), 1);
+    QTest::qWait(100);
+    QCOMPARE(pageSizes.size(), 1);
+}
+
 void tst_QWebEngineCookieStore::basicFilter()
 {
     QWebEnginePage page(m_profile);
@@ -368,5 +427,65 @@ void tst_QWebEngineCookieStore::html5featureFilter()
     QWE_TRY_VERIFY(callbackTriggered);
 }
 
+void tst_QWebEngineCookieStore::accessRules()
+{
+    QWebEnginePage page(m_profile);
+    QWebEngineCookieStore *client = m_profile->cookieStore();
+
+    QAtomicInt accessTested = 0;
+    client->setCookieFilter([&](const QWebEngineCookieStore::FilterRequest &){ ++accessTested; return true; });
+    client->setAccessRule(QStringLiteral(".Test.localhost"), QWebEngineCookieStore::AccessRule::Block);
+
+    HttpServer httpServer;
+    httpServer.setHostDomain(QString("sub.test.localhost"));
+    QVERIFY(httpServer.start());
+
+    QByteArray cookieRequestHeader;
+    connect(&httpServer, &HttpServer::newRequest, [&cookieRequestHeader](HttpReqRep *rr) {
+        if (rr->requestMethod() == "GET" && rr->requestPath() == "/test.html") {
+            cookieRequestHeader = rr->requestHeader(QByteArrayLiteral("Cookie"));
+            if (cookieRequestHeader.isEmpty())
+                rr->setResponseHeader(QByteArrayLiteral("Set-Cookie"), QByteArrayLiteral("Test=test"));
+            rr->setResponseBody("<head><title>Cookie rules</title></head><body></body>");
+            rr->sendResponse();
+        }
+    });
+
+    QSignalSpy loadSpy(&page, SIGNAL(loadFinished(bool)));
+    QSignalSpy cookieAddedSpy(client, SIGNAL(cookieAdded(const QNetworkCookie &)));
+
+    // A blocking rule on the parent domain wins without consulting the filter
+    page.load(httpServer.url("/test.html"));
+    QWE_TRY_COMPARE(loadSpy.size(), 1);
+    QVERIFY(loadSpy.takeFirst().takeFirst().toBool());
+    QTest::qWait(100);
+    QCOMPARE(cookieAddedSpy.size(), 0);
+    QCOMPARE(accessTested.loadAcquire(), 0);
+
+    // The most specific rule applies
+    client->setAccessRule(QStringLiteral("sub.test.localhost"), QWebEngineCookieStore::AccessRule::Allow);
+    page.triggerAction(QWebEnginePage::ReloadAndBypassCache);
+    QWE_TRY_COMPARE(loadSpy.size(), 1);
+    QVERIFY(loadSpy.takeFirst().takeFirst().toBool());
+    QWE_TRY_COMPARE(cookieAddedSpy.size(), 1);
+    QCOMPARE(accessTested.loadAcquire(), 0);
+
+    // Without matching rules the filter is consulted again
+    client->clearAccessRules();
+    // An invalid domain must not turn into the rule for all domains
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Cannot set a cookie access rule for invalid domain.*"));
+    client->setAccessRule(QStringLiteral("bad host"), QWebEngineCookieStore::AccessRule::Block);
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression("Cannot remove the cookie access rule of invalid domain.*"));
+    client->removeAccessRule(QStringLiteral("bad host"));
+    page.triggerAction(QWebEnginePage::Reload);
+    QWE_TRY_COMPARE(loadSpy.size(), 1);
+    QVERIFY(loadSpy.takeFirst().takeFirst().toBool());
+    QVERIFY(!cookieRequestHeader.isEmpty());
+    QWE_TRY_VERIFY(accessTested.loadAcquire() > 0);
+
+    client->setCookieFilter();
+    (void) httpServer.stop();
+}
+
 QTEST_MAIN(tst_QWebEngineCookieStore)
 #include "tst_qwebenginecookiestore.moc"
@@ -40,6 +40,7 @@ private Q_SLOTS:
     void size();
     void isMainFrame();
     void runJavaScript();
+    void runJavaScriptInFrames();
 #if QT_CONFIG(webengine_printing_and_pdf)
     void printRequestedByFrame();
     void printToPdfFile();
@@ -210,6 +211,54 @@ void tst_QWebEngineFrame::runJavaScript()
     QCOMPARE(result, QString("test-subframe0"));
 }
 
+void tst_QWebEngineFrame::runJavaScriptInFrames()
+{
+    QWebEnginePage page;
+    QSignalSpy loadSpy{ &page, SIGNAL(loadFinished(bool)) };
+    page.load(QUrl("qrc:/resources/iframes.html"));
+    QTRY_COMPARE(loadSpy.size(), 1);
+
+    using Results = QList<std::pair<QWebEngineFrame, QVariant>>;
+    CallbackSpy<Results> spy;
+    page.runJavaScriptInFrames("window.name", 0, {}, spy.ref());
+    auto results = spy.waitForResult();
+    QCOMPARE(results.size(), 3);
+    QCOMPARE(results[0].first, page.mainFrame());
+    QCOMPARE(results[0].second, QString("test-main-frame"));
+    QCOMPARE(results[1].second, QString("test-subframe0"));
+    QCOMPARE(results[2].second, QString("test-subframe1"));
+
+    CallbackSpy<Results> filteredSpy;
+    page.runJavaScriptInFrames(
+            "window.name", 0,
+            [](const QWebEngineFrame &frame) { return !frame.isMainFrame(); },
+            filteredSpy.ref());
+    results = filteredSpy.waitForResult();
+    QCOMPARE(results.size(), 2);
+    QCOMPARE(results[0].first.name(), "test-subframe0");
+    QCOMPARE(results[1].second, QString("test-subframe1"));
+
+    CallbackSpy<Results> noneSpy;
+    page.runJavaScriptInFrames(
+            "window.name", 0, [](const QWebEngineFrame &) { return false; }, noneSpy.ref());
+    QVERIFY(noneSpy.waitForResult().isEmpty());
+    QVERIFY(noneSpy.wasCalled());
+
+    // Results are in document order, the children of a frame come before its next sibling.
+    page.setHtml("<iframe name='a' srcdoc=\"<iframe name='a1'></iframe>\"></iframe>"
+                 "<iframe name='b'></iframe>");
+    QTRY_COMPARE(loadSpy.size(), 2);
+    CallbackSpy<Results> orderSpy;
+    page.runJavaScriptInFrames("window.name", 0,
+                               [](const QWebEngineFrame &frame) { return !frame.isMainFrame(); },
+                               orderSpy.ref());
+    results = orderSpy.waitForResult();
+    QCOMPARE(results.size(), 3);
+    QCOMPARE(results[0].second, QString("a"));
+    QCOMPARE(results[1].second, QString("a1"));
+    QCOMPARE(results[2].second, QString("b"));
+}
+
 #if QT_CONFIG(webengine_printing_and_pdf)
 void tst_QWebEngineFrame::printRequestedByFrame()
 {
@@ -26,12 +26,44 @@ public Q_SLOTS:
     void cleanup() { }
 
 private Q_SLOTS:
-    void initTestCase() { }
+    void initTestCase();
     void cleanupTestCase() { }
     void dnsOverHttps_data();
     void dnsOverHttps();
+    void rasterSettings();
+    void parallelDownloadSettings();
 };
 
+void tst_QWebEngineGlobalSettings::initTestCase()
+{
+    // The settings below are checked before any profile initializes the web engine.
+    QWebEngineGlobalSettings::RasterSettings settings;
+    settings.threadCount = -1;
+    QVERIFY(!QWebEngineGlobalSettings::setRasterSettings(settings));
+    settings.threadCount = 5;
+    QVERIFY(!QWebEngineGlobalSettings::setRasterSettings(settings));
+    settings.threadCount = 4;
+    settings.tileSize = QSize(0, 256);
+    QVERIFY(!QWebEngineGlobalSettings::setRasterSettings(settings));
+    settings.tileSize = QSize(256, 256);
+    settings.mode = QWebEngineGlobalSettings::RasterMode::OneCopy;
+    QVERIFY(QWebEngineGlobalSettings::setRasterSettings(settings));
+    QVERIFY(QWebEngineGlobalSettings::setRasterSettings({}));
+
+    QWebEngineGlobalSettings::ParallelDownloadSettings downloadSettings;
+    downloadSettings.enabled = true;
+    downloadSettings.requestCount = 1;
+    QVERIFY(!QWebEngineGlobalSettings::setParallelDownloadSettings(downloadSettings));
+    downloadSettings.requestCount = 17;
+    QVERIFY(!QWebEngineGlobalSettings::setParallelDownloadSettings(downloadSettings));
+    downloadSettings.requestCount = 4;
+    downloadSettings.minimumSliceSize = -1;
+    QVERIFY(!QWebEngineGlobalSettings::setParallelDownloadSettings(downloadSettings));
+    downloadSettings.minimumSliceSize = 1024 * 1024;
+    QVERIFY(QWebEngineGlobalSettings::setParallelDownloadSettings(downloadSettings));
+    QVERIFY(QWebEngineGlobalSettings::setParallelDownloadSettings({}));
+}
+
 void tst_QWebEngineGlobalSettings::dnsOverHttps_data()
 {
     QTest::addColumn<QWebEngineGlobalSettings::SecureDnsMode>("dnsMode");
@@ -122,6 +154,29 @@ void tst_QWebEngineGlobalSettings::dnsOverHttps()
     QVERIFY(httpsServer.stop());
 }
 
+void tst_QWebEngineGlobalSettings::rasterSettings()
+{
+    // Raster settings only apply to the command line of new renderer processes,
+    // they cannot be changed once the web engine is running.
+    QWebEngineProfile profile;
+    QWebEnginePage page(&profile);
+    QWebEngineGlobalSettings::RasterSettings settings;
+    settings.threadCount = 2;
+    settings.tileSize = QSize(256, 256);
+    QVERIFY(!QWebEngineGlobalSettings::setRasterSettings(settings));
+}
+
+void tst_QWebEngineGlobalSettings::parallelDownloadSettings()
+{
+    // Parallel downloading is configured when the web engine starts.
+    QWebEngineProfile profile;
+    QWebEnginePage page(&profile);
+    QWebEngineGlobalSettings::ParallelDownloadSettings settings;
+    settings.enabled = true;
+    settings.requestCount = 4;
+    QVERIFY(!QWebEngineGlobalSettings::setParallelDownloadSettings(settings));
+}
+
 static QByteArrayList params = QByteArrayList() << "--ignore-certificate-errors";
 
 W_QTEST_MAIN(tst_QWebEngineGlobalSettings, params)
@@ -130,6 +130,72 @@ TestWebEngineView {
             webEngineView.profile = defaultProfile;
         }
 
+        function test_iconCacheInvalidation()
+        {
+            if (Screen.devicePixelRatio !== 1.0)
+                skip("This test is not supported on High DPI screens.");
+
+            webEngineView.profile = nonOTRProfile;
+            var faviconImage = Qt.createQmlObject("
+                    import QtQuick\n
+                    Image { width: 16; height: 16; sourceSize: Qt.size(width, height); cache: false; }", testCase);
+
+            var pageUrl = Qt.resolvedUrl("favicon.html");
+            webEngineView.url = pageUrl; // favicon.png -> 165
+            verify(webEngineView.waitForLoadSucceeded());
+            tryCompare(webEngineView, "icon", "image://favicon/" + Qt.resolvedUrl("icons/favicon.png"));
+
+            faviconImage.source = "image://favicon/" + pageUrl;
+            compare(getFaviconPixel(faviconImage)[0], 165);
+
+            // The page icon is remembered, but dropped when the page switches to another icon.
+            webEngineView.runJavaScript("document.querySelector('link').href = 'icons/qt32.ico'");
+            tryCompare(webEngineView, "icon", "image://favicon/" + Qt.resolvedUrl("icons/qt32.ico"));
+
+            faviconImage.source = "";
+            faviconImage.source = "image://favicon/" + pageUrl;
+            tryVerify(function() { return getFaviconPixel(faviconImage)[0] === 251; });
+
+            faviconImage.destroy();
+            webEngineView.profile = defaultProfile;
+        }
+
+        function test_batchedPageRequests()
+        {
+            if (Screen.devicePixelRatio !== 1.0)
+                skip("This test is not supported on High DPI screens.");
+
+            webEngineView.profile = nonOTRProfile;
+            var pages = [ { url: Qt.resolvedUrl("favicon.html"), pixel: 165 },
+                          { url: Qt.resolvedUrl("favicon-shortcut.html"), pixel: 251 } ];
+            for (var i = 0; i < pages.length; ++i) {
+                webEngineView.url = pages[i].url;
+                verify(webEngineView.waitForLoadSucceeded());
+                tryVerify(function() { return webEngineView.icon != ""; });
+            }
+            webEngineView.url = "about:blank";
+            verify(webEngineView.waitForLoadSucceeded());
+
+            // Requests made in the same event loop pass are resolved together, and a second
+            // round is answered from the cache. Each image gets the icon of its own page.
+            for (var round = 0; round < 2; ++round) {
+                var images = [];
+                for (var j = 0; j < 6; ++j) {
+                    var image = Qt.createQmlObject("
+                            import QtQuick\n
+                            Image { width: 16; height: 16; sourceSize: Qt.size(width, height); cache: false; }", testCase);
+                    image.source = "image://favicon/" + pages[j % pages.length].url;
+                    images.push(image);
+                }
+                for (var k = 0; k < images.length; ++k) {
+                    compare(getFaviconPixel(images[k])[0], pages[k % pages.length].pixel);
+                    images[k].destroy();
+                }
+            }
+
+            webEngineView.profile = defaultProfile;
+        }
+
         function test_iconDatabaseMultiView()
         {
             if (Screen.devicePixelRatio !== 1.0)
@@ -21,8 +21,10 @@
 #include <qtest.h>
 #include <widgetutil.h>
 
+#include <QFile>
 #include <QHBoxLayout>
 #include <QMainWindow>
+#include <QScopeGuard>
 
 #include <qaccessible.h>
 #include <qwebengineview.h>
@@ -30,6 +32,15 @@
 #include <qwebenginesettings.h>
 #include <qwidget.h>
 
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#elif defined(Q_OS_MACOS)
+#include <mach/mach.h>
+#elif defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#endif
+
 class tst_Accessibility : public QObject
 {
     Q_OBJECT
@@ -52,6 +63,9 @@ private Q_SLOTS:
     void objectName();
     void crossTreeParent();
     void tableCellInterface();
+    void largeDocument();
+    void largeDocumentMemory();
+    void releaseOffscreenInterfaces();
 };
 
 // This will be called before the first test function is executed.
@@ -658,6 +672,166 @@ void tst_Accessibility::tableCellInterface()
     }
 }
 
+// Every accessible interface of a web node owns a plain QObject below the view.
+static int materializedInterfaceCount(QWebEngineView *webView)
+{
+    int count = 0;
+    for (QObject *object : webView->findChildren<QObject *>()) {
+        if (object->metaObject() == &QObject::staticMetaObject)
+            ++count;
+    }
+    return count;
+}
+
+// Resident memory of the browser process, or -1 where it cannot be read.
+static qint64 residentMemory()
+{
+#if defined(Q_OS_LINUX)
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly))
+        return -1;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    if (fields.size() < 2)
+        return -1;
+    return fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE);
+#elif defined(Q_OS_MACOS)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info),
+                  &count) != KERN_SUCCESS)
+        return -1;
+    return qint64(info.resident_size);
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return -1;
+    return qint64(counters.WorkingSetSize);
+#else
+    return -1;
+#endif
+}
+
+static QString largeDocumentHtml(int paragraphCount)
+{
+    QString html = QStringLiteral("<html><body>");
+    for (int i = 0; i < paragraphCount; ++i)
+        html += QStringLiteral("<p>Paragraph %1</p>").arg(i);
+    html += QStringLiteral("</body></html>");
+    return html;
+}
+
+void tst_Accessibility::largeDocument()
+{
+    const int paragraphCount = 10000;
+    const QString html = largeDocumentHtml(paragraphCount);
+
+    QWebEngineView webView;
+    webView.resize(400, 300);
+    webView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&webView));
+
+    QSignalSpy spyFinished(&webView, &QWebEngineView::loadFinished);
+    QAccessibleInterface *view = QAccessible::queryAccessibleInterface(&webView);
+    QAccessibleInterface *document = nullptr;
+    // Times loading the document and building its accessibility tree.
+    QBENCHMARK_ONCE {
+        webView.setHtml(html);
+        QTRY_COMPARE_WITH_TIMEOUT(spyFinished.size(), 1, 30000);
+        QTRY_COMPARE_WITH_TIMEOUT(view->child(0)->childCount(), paragraphCount, 30000);
+        document = view->child(0);
+    }
+
+    // Only the document has been asked for, its paragraphs have no interfaces yet.
+    const int initialCount = materializedInterfaceCount(&webView);
+    QVERIFY2(initialCount < 10, QByteArray::number(initialCount));
+
+    QAccessibleInterface *last = document->child(paragraphCount - 1);
+    QVERIFY(last);
+    QCOMPARE(last->parent(), document);
+    QCOMPARE(document->indexOfChild(last), paragraphCount - 1);
+    QCOMPARE(last->child(0)->text(QAccessible::Name),
+             QStringLiteral("Paragraph %1").arg(paragraphCount - 1));
+    QVERIFY(materializedInterfaceCount(&webView) < initialCount + 10);
+}
+
+void tst_Accessibility::largeDocumentMemory()
+{
+    const int paragraphCount = 10000;
+    const QString html = largeDocumentHtml(paragraphCount);
+    if (residentMemory() < 0)
+        QSKIP("Resident memory cannot be read on this platform");
+
+    QWebEngineView webView;
+    webView.resize(400, 300);
+    webView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&webView));
+
+    QSignalSpy spyFinished(&webView, &QWebEngineView::loadFinished);
+    QAccessibleInterface *view = QAccessible::queryAccessibleInterface(&webView);
+    const qint64 memoryBefore = residentMemory();
+    webView.setHtml(html);
+    QTRY_COMPARE_WITH_TIMEOUT(spyFinished.size(), 1, 30000);
+    QTRY_COMPARE_WITH_TIMEOUT(view->child(0)->childCount(), paragraphCount, 30000);
+
+    // How much the browser process grew to hold the document and its accessibility tree.
+    QTest::setBenchmarkResult(qMax<qint64>(residentMemory() - memoryBefore, 0),
+                              QTest::BytesAllocated);
+}
+
+static QList<QAccessible::Id> destroyedInterfaces;
+
+static void recordDestroyedInterfaces(QAccessibleEvent *event)
+{
+    if (event->type() == QAccessible::ObjectDestroyed)
+        destroyedInterfaces.append(event->uniqueId());
+}
+
+void tst_Accessibility::releaseOffscreenInterfaces()
+{
+    const int paragraphCount = 1000;
+
+    QWebEngineView webView;
+    webView.resize(400, 300);
+    webView.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&webView));
+
+    QSignalSpy spyFinished(&webView, &QWebEngineView::loadFinished);
+    QAccessibleInterface *view = QAccessible::queryAccessibleInterface(&webView);
+    webView.setHtml(largeDocumentHtml(paragraphCount));
+    QTRY_COMPARE_WITH_TIMEOUT(spyFinished.size(), 1, 30000);
+    QTRY_COMPARE_WITH_TIMEOUT(view->child(0)->childCount(), paragraphCount, 30000);
+    QAccessibleInterface *document = view->child(0);
+
+    QAccessibleInterface *first = document->child(0);
+    QAccessibleInterface *last = document->child(paragraphCount - 1);
+    QVERIFY(first);
+    QVERIFY(last);
+    const QAccessible::Id firstId = QAccessible::uniqueId(first);
+    const QAccessible::Id lastId = QAccessible::uniqueId(last);
+
+    destroyedInterfaces.clear();
+    const QAccessible::UpdateHandler previousHandler =
+            QAccessible::installUpdateHandler(recordDestroyedInterfaces);
+    const auto restoreHandler =
+            qScopeGuard([previousHandler] { QAccessible::installUpdateHandler(previousHandler); });
+
+    // Scrolling a little keeps the first paragraph visible and the last one off-screen.
+    evaluateJavaScriptSync(webView.page(), "window.scrollTo(0, 10)");
+    QTRY_VERIFY_WITH_TIMEOUT(!QAccessible::accessibleInterface(lastId), 10000);
+    QCOMPARE(QAccessible::accessibleInterface(firstId), first);
+    // Assistive technologies are told before the interface goes away.
+    QVERIFY(destroyedInterfaces.contains(lastId));
+    QVERIFY(!destroyedInterfaces.contains(firstId));
+
+    // Asking for the node again creates a new interface for it.
+    last = document->child(paragraphCount - 1);
+    QVERIFY(last);
+    QVERIFY(last->isValid());
+    QCOMPARE(last->parent(), document);
+    QCOMPARE(last->child(0)->text(QAccessible::Name),
+             QStringLiteral("Paragraph %1").arg(paragraphCount - 1));
+}
+
 static QByteArrayList params = QByteArrayList()
     << "--force-renderer-accessibility"
     << "--enable-features=AccessibilityExposeARIAAnnotations"
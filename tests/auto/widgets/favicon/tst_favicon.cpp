@@ -45,6 +45,7 @@ private Q_SLOTS:
     void requestIconForIconURL();
     void requestIconForPageURL_data();
     void requestIconForPageURL();
+    void requestIconsForPageURLs();
     void desiredSize();
     void changePersistentStorage();
 
@@ -744,6 +745,50 @@ void tst_Favicon::requestIconForPageURL()
     }
 }
 
+void tst_Favicon::requestIconsForPageURLs()
+{
+    QTemporaryDir tmpDir;
+    QWebEngineProfile profile("iconDatabase-pageurls");
+    profile.setPersistentStoragePath(tmpDir.path());
+    profile.settings()->setAttribute(QWebEngineSettings::TouchIconsEnabled, false);
+
+    QWebEngineView view;
+    QWebEnginePage *page = new QWebEnginePage(&profile, &view);
+    view.setPage(page);
+
+    QSignalSpy loadFinishedSpy(page, SIGNAL(loadFinished(bool)));
+    QSignalSpy iconChangedSpy(page, SIGNAL(iconChanged(QIcon)));
+
+    page->load(QUrl("qrc:/resources/favicon-misc.html"));
+    QTRY_COMPARE(loadFinishedSpy.size(), 1);
+    QTRY_COMPARE(iconChangedSpy.size(), 1);
+
+    page->load(QUrl("qrc:/resources/favicon-multi.html"));
+    QTRY_COMPARE(loadFinishedSpy.size(), 2);
+    QTRY_COMPARE(iconChangedSpy.size(), 2);
+
+    const QList<QUrl> pageUrls = { QUrl("qrc:/resources/favicon-misc.html"),
+                                   QUrl("qrc:/resources/favicon-multi.html"),
+                                   QUrl("http://unvisited.invalid/") };
+    QList<QUrl> resultPageUrls;
+    QList<QUrl> resultIconUrls;
+    QList<QIcon> resultIcons;
+    profile.requestIconsForPageURLs(pageUrls, 16,
+                                    [&](const QIcon &icon, const QUrl &iconUrl, const QUrl &pageUrl) {
+        resultIcons.append(icon);
+        resultIconUrls.append(iconUrl);
+        resultPageUrls.append(pageUrl);
+    });
+    QTRY_COMPARE(resultPageUrls, pageUrls);
+
+    QCOMPARE(resultIconUrls.at(0), QUrl("qrc:/resources/icons/qt32.ico"));
+    QCOMPARE(resultIconUrls.at(1), QUrl("qrc:/resources/icons/qtmulti.ico"));
+    QVERIFY(resultIconUrls.at(2).isEmpty());
+    QCOMPARE(resultIcons.at(0).availableSizes(), QList<QSize>{ QSize(16, 16) });
+    QCOMPARE(resultIcons.at(1).pixmap(QSize(16, 16), 1.0).toImage().pixel(8, 8), 0xfffdfefc);
+    QVERIFY(resultIcons.at(2).isNull());
+}
+
 void tst_Favicon::desiredSize()
 {
     QTemporaryDir tmpDir;
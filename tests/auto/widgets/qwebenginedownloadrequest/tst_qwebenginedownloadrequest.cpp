@@ -3,10 +3,14 @@
 
 #include <util.h>
 
+#include <QBuffer>
 #include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
 #include <QSignalSpy>
 #include <QStandardPaths>
 #include <QTemporaryDir>
+#include <QTimer>
 #include <QTest>
 #include <QRegularExpression>
 #include <QWebEngineDownloadRequest>
@@ -16,6 +20,48 @@
 #include <QWebEngineView>
 #include <httpserver.h>
 
+#include <memory>
+
+// Keeps written data buffered until it is drained, like a socket to a slow peer.
+class SlowDevice : public QIODevice
+{
+public:
+    SlowDevice() { open(QIODevice::WriteOnly); }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesToWrite() const override { return m_pending; }
+
+    void setDraining(bool draining)
+    {
+        m_draining = draining;
+        if (draining)
+            drain();
+    }
+
+    QByteArray data;
+
+protected:
+    qint64 readData(char *, qint64) override { return -1; }
+    qint64 writeData(const char *bytes, qint64 size) override
+    {
+        data.append(bytes, size);
+        m_pending += size;
+        if (m_draining)
+            QTimer::singleShot(0, this, &SlowDevice::drain);
+        return size;
+    }
+
+private:
+    void drain()
+    {
+        if (const qint64 written = std::exchange(m_pending, 0))
+            Q_EMIT bytesWritten(written);
+    }
+
+    qint64 m_pending = 0;
+    bool m_draining = false;
+};
+
 class tst_QWebEngineDownloadRequest : public QObject
 {
     Q_OBJECT
@@ -60,6 +106,13 @@ private Q_SLOTS:
     void downloadToDirectoryWithFileName();
     void downloadDataUrls_data();
     void downloadDataUrls();
+    void downloadThrottled();
+    void downloadsRunOneAfterTheOther();
+    void downloadHashAndOutputDevice_data();
+    void downloadHashAndOutputDevice();
+    void downloadSlowOutputDevice();
+    void downloadOutputDeviceDestroyed();
+    void downloadOutputDeviceRestarted();
 
 private:
     void saveLink(QPoint linkPos);
@@ -1345,5 +1398,314 @@ void tst_QWebEngineDownloadRequest::downloadDataUrls()
     QTRY_COMPARE(downloadRequestCount, 1);
 }
 
+void tst_QWebEngineDownloadRequest::downloadThrottled()
+{
+    // Large enough that the limit and not what the network stack buffers sets the duration.
+    const QByteArray fileContents(24 * 1024 * 1024, 'a');
+    const qint64 limit = 4 * 1024 * 1024;
+    ScopedConnection sc1 = connect(m_server, &HttpServer::newRequest, [&](HttpReqRep *rr) {
+        if (rr->requestPath() == "/file") {
+            rr->setResponseHeader(QByteArrayLiteral("content-type"), QByteArrayLiteral("application/octet-stream"));
+            rr->setResponseBody(fileContents);
+            rr->sendResponse();
+        }
+    });
+
+    QCOMPARE(m_profile->maximumDownloadBytesPerSecond(), 0);
+    QCOMPARE(m_profile->maximumActiveDownloads(), 0);
+    m_profile->setMaximumDownloadBytesPerSecond(2 * limit);
+    m_profile->setMaximumActiveDownloads(1);
+    QCOMPARE(m_profile->maximumDownloadBytesPerSecond(), 2 * limit);
+    QCOMPARE(m_profile->maximumActiveDownloads(), 1);
+
+    QTemporaryDir tmpDir;
+    QVERIFY(tmpDir.isValid());
+    m_profile->setDownloadPath(tmpDir.path());
+
+    QPointer<QWebEngineDownloadRequest> downloadItem;
+    int pausedChangedCount = 0;
+    ScopedConnection sc2 = connect(m_profile, &QWebEngineProfile::downloadRequested, [&](QWebEngineDownloadRequest *item) {
+        QCOMPARE(item->maximumBytesPerSecond(), 0);
+        QSignalSpy maximumSpy(item, &QWebEngineDownloadRequest::maximumBytesPerSecondChanged);
+        item->setMaximumBytesPerSecond(limit);
+        item->setMaximumBytesPerSecond(limit);
+        QCOMPARE(maximumSpy.size(), 1);
+        QCOMPARE(item->maximumBytesPerSecond(), limit);
+        connect(item, &QWebEngineDownloadRequest::isPausedChanged, [&]() { ++pausedChangedCount; });
+        downloadItem = item;
+        item->accept();
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    m_page->download(m_server->url(QByteArrayLiteral("/file")));
+    QTRY_VERIFY(downloadItem);
+    QTRY_VERIFY(downloadItem->bytesPerSecond() > 0);
+    QTRY_VERIFY_WITH_TIMEOUT(downloadItem->isFinished(), 30000);
+    QCOMPARE(downloadItem->state(), QWebEngineDownloadRequest::DownloadCompleted);
+    QCOMPARE(downloadItem->receivedBytes(), fileContents.size());
+    // 6 seconds at the limit, less what was buffered before the download was first held back.
+    QVERIFY2(timer.elapsed() >= 3000, qPrintable(QString::number(timer.elapsed())));
+    // Holding the download back is not reported as pausing it.
+    QCOMPARE(pausedChangedCount, 0);
+
+    m_profile->setMaximumDownloadBytesPerSecond(0);
+    m_profile->setMaximumActiveDownloads(0);
+}
+
+void tst_QWebEngineDownloadRequest::downloadsRunOneAfterTheOther()
+{
+    const QByteArray fileContents(24 * 1024 * 1024, 'a');
+    ScopedConnection sc1 = connect(m_server, &HttpServer::newRequest, [&](HttpReqRep *rr) {
+        if (rr->requestPath() == "/file1" || rr->requestPath() == "/file2") {
+            rr->setResponseHeader(QByteArrayLiteral("content-type"), QByteArrayLiteral("application/octet-stream"));
+            rr->setResponseBody(fileContents);
+            rr->sendResponse();
+        }
+    });
+
+    m_profile->setMaximumDownloadBytesPerSecond(8 * 1024 * 1024);
+    m_profile->setMaximumActiveDownloads(1);
+
+    QTemporaryDir tmpDir;
+    QVERIFY(tmpDir.isValid());
+    m_profile->setDownloadPath(tmpDir.path());
+
+    QList<QPointer<QWebEngineDownloadRequest>> downloadItems;
+    qint64 secondReceivedWhenFirstFinished = -1;
+    ScopedConnection sc2 = connect(m_profile, &QWebEngineProfile::downloadRequested, [&](QWebEngineDownloadRequest *item) {
+        downloadItems.append(item);
+        if (downloadItems.size() == 1) {
+            connect(item, &QWebEngineDownloadRequest::isFinishedChanged, [&]() {
+                if (downloadItems.size() > 1 && downloadItems.at(1))
+                    secondReceivedWhenFirstFinished = downloadItems.at(1)->receivedBytes();
+            });
+        }
+        item->accept();
+    });
+
+    m_page->download(m_server->url(QByteArrayLiteral("/file1")));
+    QTRY_COMPARE(downloadItems.size(), 1);
+    m_page->download(m_server->url(QByteArrayLiteral("/file2")));
+    QTRY_COMPARE(downloadItems.size(), 2);
+
+    QTRY_VERIFY_WITH_TIMEOUT(downloadItems.at(0)->isFinished(), 30000);
+    QCOMPARE(downloadItems.at(0)->state(), QWebEngineDownloadRequest::DownloadCompleted);
+    // The second download waited for the first one to finish.
+    QVERIFY(!downloadItems.at(1)->isFinished());
+    QVERIFY(secondReceivedWhenFirstFinished >= 0);
+    QVERIFY(secondReceivedWhenFirstFinished < fileContents.size());
+    QVERIFY(!downloadItems.at(1)->isPaused());
+
+    QTRY_VERIFY_WITH_TIMEOUT(downloadItems.at(1)->isFinished(), 30000);
+    QCOMPARE(downloadItems.at(1)->state(), QWebEngineDownloadRequest::DownloadCompleted);
+    QCOMPARE(downloadItems.at(1)->receivedBytes(), fileContents.size());
+
+    m_profile->setMaximumDownloadBytesPerSecond(0);
+    m_profile->setMaximumActiveDownloads(0);
+}
+
+void tst_QWebEngineDownloadRequest::downloadHashAndOutputDevice_data()
+{
+    QTest::addColumn<QWebEngineDownloadRequest::HashAlgorithm>("hashAlgorithm");
+    QTest::addColumn<bool>("useOutputDevice");
+    QTest::newRow("sha256") << QWebEngineDownloadRequest::Sha256Hash << false;
+    QTest::newRow("sha512") << QWebEngineDownloadRequest::Sha512Hash << false;
+    QTest::newRow("device") << QWebEngineDownloadRequest::NoHash << true;
+    QTest::newRow("sha512 and device") << QWebEngineDownloadRequest::Sha512Hash << true;
+}
+
+void tst_QWebEngineDownloadRequest::downloadHashAndOutputDevice()
+{
+    QFETCH(QWebEngineDownloadRequest::HashAlgorithm, hashAlgorithm);
+    QFETCH(bool, useOutputDevice);
+
+    QByteArray fileContents;
+    for (int i = 0; i < 100000; ++i)
+        fileContents.append(QByteArray::number(i));
+    ScopedConnection sc1 = connect(m_server, &HttpServer::newRequest, [&](HttpReqRep *rr) {
+        if (rr->requestPath() == "/file") {
+            rr->setResponseHeader(QByteArrayLiteral("content-type"), QByteArrayLiteral("application/octet-stream"));
+            rr->setResponseBody(fileContents);
+            rr->sendResponse();
+        }
+    });
+
+    QTemporaryDir tmpDir;
+    QVERIFY(tmpDir.isValid());
+    m_profile->setDownloadPath(tmpDir.path());
+
+    QBuffer outputDevice;
+    QVERIFY(outputDevice.open(QIODevice::WriteOnly));
+    QPointer<QWebEngineDownloadRequest> downloadItem;
+    QString downloadPath;
+    ScopedConnection sc2 = connect(m_profile, &QWebEngineProfile::downloadRequested, [&](QWebEngineDownloadRequest *item) {
+        QCOMPARE(item->hashAlgorithm(), QWebEngineDownloadRequest::NoHash);
+        QCOMPARE(item->outputDevice(), nullptr);
+        item->setHashAlgorithm(hashAlgorithm);
+        if (useOutputDevice)
+            item->setOutputDevice(&outputDevice);
+        downloadPath = QDir(item->downloadDirectory()).filePath(item->downloadFileName());
+        downloadItem = item;
+        item->accept();
+    });
+
+    m_page->download(m_server->url(QByteArrayLiteral("/file")));
+    QTRY_VERIFY(downloadItem);
+    QTRY_VERIFY(downloadItem->isFinished());
+    QCOMPARE(downloadItem->state(), QWebEngineDownloadRequest::DownloadCompleted);
+
+    if (hashAlgorithm == QWebEngineDownloadRequest::NoHash) {
+        QVERIFY(downloadItem->hash().isEmpty());
+    } else {
+        const auto algorithm = hashAlgorithm == QWebEngineDownloadRequest::Sha256Hash
+                ? QCryptographicHash::Sha256
+                : QCryptographicHash::Sha512;
+        QCOMPARE(downloadItem->hash().toHex(), QCryptographicHash::hash(fileContents, algorithm).toHex());
+    }
+
+    if (useOutputDevice) {
+        QCOMPARE(outputDevice.data(), fileContents);
+        QVERIFY(!QFile::exists(downloadPath));
+    } else {
+        QFile file(downloadPath);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        QCOMPARE(file.readAll(), fileContents);
+    }
+}
+
+void tst_QWebEngineDownloadRequest::downloadSlowOutputDevice()
+{
+    const QByteArray fileContents(64 * 1024 * 1024, 'a');
+    ScopedConnection sc1 = connect(m_server, &HttpServer::newRequest, [&](HttpReqRep *rr) {
+        if (rr->requestPath() == "/file") {
+            rr->setResponseHeader(QByteArrayLiteral("content-type"), QByteArrayLiteral("application/octet-stream"));
+            rr->setResponseBody(fileContents);
+            rr->sendResponse();
+        }
+    });
+
+    QTemporaryDir tmpDir;
+    QVERIFY(tmpDir.isValid());
+    m_profile->setDownloadPath(tmpDir.path());
+
+    SlowDevice outputDevice;
+    QPointer<QWebEngineDownloadRequest> downloadItem;
+    int pausedChangedCount = 0;
+    ScopedConnection sc2 = connect(m_profile, &QWebEngineProfile::downloadRequested, [&](QWebEngineDownloadRequest *item) {
+        item->setOutputDevice(&outputDevice);
+        connect(item, &QWebEngineDownloadRequest::isPausedChanged, [&]() { ++pausedChangedCount; });
+        downloadItem = item;
+        item->accept();
+    });
+
+    m_page->download(m_server->url(QByteArrayLiteral("/file")));
+    QTRY_VERIFY(downloadItem);
+
+    // Nothing more is written to the device while it buffers too much...
+    QTRY_VERIFY(outputDevice.bytesToWrite() > 0);
+    // ...and the download is held back once too much is left to consume.
+    QTRY_VERIFY_WITH_TIMEOUT(downloadItem->receivedBytes() >= 32 * 1024 * 1024, 20000);
+    QTest::qWait(1000);
+    const qint64 receivedBytes = downloadItem->receivedBytes();
+    QTest::qWait(1000);
+    QCOMPARE(downloadItem->receivedBytes(), receivedBytes);
+    QVERIFY(receivedBytes < fileContents.size());
+    QVERIFY(outputDevice.data.size() <= 8 * 1024 * 1024);
+    QVERIFY(!downloadItem->isFinished());
+    QVERIFY(!downloadItem->isPaused());
+
+    outputDevice.setDraining(true);
+    QTRY_VERIFY_WITH_TIMEOUT(downloadItem->isFinished(), 20000);
+    QCOMPARE(downloadItem->state(), QWebEngineDownloadRequest::DownloadCompleted);
+    QCOMPARE(outputDevice.data.size(), fileContents.size());
+    QVERIFY(outputDevice.data == fileContents);
+    // Holding the download back is not reported as pausing it.
+    QCOMPARE(pausedChangedCount, 0);
+}
+
+void tst_QWebEngineDownloadRequest::downloadOutputDeviceDestroyed()
+{
+    const QByteArray fileContents(64 * 1024 * 1024, 'a');
+    ScopedConnection sc1 = connect(m_server, &HttpServer::newRequest, [&](HttpReqRep *rr) {
+        if (rr->requestPath() == "/file") {
+            rr->setResponseHeader(QByteArrayLiteral("content-type"), QByteArrayLiteral("application/octet-stream"));
+            rr->setResponseBody(fileContents);
+            rr->sendResponse();
+        }
+    });
+
+    QTemporaryDir tmpDir;
+    QVERIFY(tmpDir.isValid());
+    m_profile->setDownloadPath(tmpDir.path());
+
+    auto outputDevice = std::make_unique<SlowDevice>();
+    QPointer<QWebEngineDownloadRequest> downloadItem;
+    ScopedConnection sc2 = connect(m_profile, &QWebEngineProfile::downloadRequested, [&](QWebEngineDownloadRequest *item) {
+        item->setOutputDevice(outputDevice.get());
+        downloadItem = item;
+        item->accept();
+    });
+
+    m_page->download(m_server->url(QByteArrayLiteral("/file")));
+    QTRY_VERIFY(downloadItem);
+    QTRY_VERIFY(outputDevice->bytesToWrite() > 0);
+    QVERIFY(!downloadItem->isFinished());
+
+    outputDevice.reset();
+    QTRY_VERIFY(downloadItem->isFinished());
+    QCOMPARE(downloadItem->state(), QWebEngineDownloadRequest::DownloadCancelled);
+    QVERIFY(downloadItem->hash().isEmpty());
+}
+
+void tst_QWebEngineDownloadRequest::downloadOutputDeviceRestarted()
+{
+    const QByteArray fileContents(4 * 1024 * 1024, 'a');
+    int requests = 0;
+    ScopedConnection sc1 = connect(m_server, &HttpServer::newRequest, [&](HttpReqRep *rr) {
+        if (rr->requestPath() != "/file")
+            return;
+        if (++requests == 1) {
+            // Only half of the data arrives before the connection breaks.
+            rr->sendResponse("HTTP/1.1 200 OK\r\n"
+                             "Content-Type: application/octet-stream\r\n"
+                             "Content-Length: " + QByteArray::number(fileContents.size()) + "\r\n"
+                             "Connection: close\r\n\r\n"
+                             + fileContents.left(fileContents.size() / 2));
+            return;
+        }
+        // Range requests are not supported, the download has to start over.
+        rr->setResponseHeader(QByteArrayLiteral("content-type"), QByteArrayLiteral("application/octet-stream"));
+        rr->setResponseBody(fileContents);
+        rr->sendResponse();
+    });
+
+    QTemporaryDir tmpDir;
+    QVERIFY(tmpDir.isValid());
+    m_profile->setDownloadPath(tmpDir.path());
+
+    SlowDevice outputDevice;
+    outputDevice.setDraining(true);
+    QPointer<QWebEngineDownloadRequest> downloadItem;
+    ScopedConnection sc2 = connect(m_profile, &QWebEngineProfile::downloadRequested, [&](QWebEngineDownloadRequest *item) {
+        item->setOutputDevice(&outputDevice);
+        downloadItem = item;
+        item->accept();
+    });
+
+    m_page->download(m_server->url(QByteArrayLiteral("/file")));
+    QTRY_VERIFY(downloadItem);
+    QTRY_VERIFY(downloadItem->state() == QWebEngineDownloadRequest::DownloadInterrupted
+                || downloadItem->state() == QWebEngineDownloadRequest::DownloadCancelled);
+    QVERIFY(!outputDevice.data.isEmpty());
+    if (downloadItem->state() == QWebEngineDownloadRequest::DownloadInterrupted)
+        downloadItem->resume();
+
+    // The device cannot follow a download that starts over.
+    QTRY_COMPARE(downloadItem->state(), QWebEngineDownloadRequest::DownloadCancelled);
+    QVERIFY(requests >= 2);
+    QVERIFY(outputDevice.data.size() <= fileContents.size());
+}
+
 QTEST_MAIN(tst_QWebEngineDownloadRequest)
 #include "tst_qwebenginedownloadrequest.moc"
@@ -24,6 +24,7 @@
 #include "qwebenginepage.h"
 #include "qwebengineview.h"
 #include "qwebenginehistory.h"
+#include "qwebengineprofile.h"
 #include "qdebug.h"
 
 class tst_QWebEngineHistory : public QObject
@@ -68,6 +69,8 @@ private Q_SLOTS:
     void saveAndRestore_crash_3();
     void saveAndRestore_crash_4();
     void saveAndRestore_InternalPage();
+    void restoreOnDemand();
+    void restoreInBackground();
 
     void popPushState_data();
     void popPushState();
@@ -452,6 +455,103 @@ void tst_QWebEngineHistory::saveAndRestore_InternalPage()
     stream2 >> *view.history();
 }
 
+void tst_QWebEngineHistory::restoreOnDemand()
+{
+    hist->back();
+    QTRY_COMPARE(loadFinishedSpy->size(), 1);
+    QByteArray buffer;
+    saveHistory(hist, &buffer);
+
+    QWebEngineProfile profile;
+    profile.setHistoryRestorePolicy(QWebEngineProfile::HistoryRestorePolicy::OnDemand);
+    QWebEnginePage page2(&profile);
+    QSignalSpy loadFinishedSpy2(&page2, &QWebEnginePage::loadFinished);
+    QSignalSpy urlChangedSpy2(&page2, &QWebEnginePage::urlChanged);
+    restoreHistory(page2.history(), &buffer);
+
+    // The history is available without loading anything.
+    QWebEngineHistory *hist2 = page2.history();
+    QCOMPARE(hist2->count(), histsize);
+    QCOMPARE(hist2->currentItemIndex(), hist->currentItemIndex());
+    QVERIFY(hist2->canGoBack());
+    QVERIFY(hist2->canGoForward());
+    for (int i = 0; i < histsize; ++i) {
+        QCOMPARE(hist2->itemAt(i).url(), hist->itemAt(i).url());
+        QCOMPARE(hist2->itemAt(i).title(), hist->itemAt(i).title());
+    }
+    QCOMPARE(page2.url(), page->url());
+    QCOMPARE(page2.title(), page->title());
+    QCOMPARE(urlChangedSpy2.size(), 1);
+
+    // Serializing it again does not restore the page either.
+    QByteArray buffer2;
+    saveHistory(hist2, &buffer2);
+    QCOMPARE(buffer2, buffer);
+    QTest::qWait(500);
+    QCOMPARE(loadFinishedSpy2.size(), 0);
+
+    // Navigating restores the page straight to the requested entry.
+    hist2->goToItem(hist2->itemAt(1));
+    QTRY_COMPARE(loadFinishedSpy2.size(), 1);
+    QVERIFY(loadFinishedSpy2.at(0).at(0).toBool());
+    QCOMPARE(hist2->currentItemIndex(), 1);
+    QCOMPARE(page2.url(), hist->itemAt(1).url());
+    QCOMPARE(hist2->count(), histsize);
+
+    // Showing the page restores it at its current entry.
+    QWebEnginePage page3(&profile);
+    QSignalSpy loadFinishedSpy3(&page3, &QWebEnginePage::loadFinished);
+    restoreHistory(page3.history(), &buffer);
+    QTest::qWait(500);
+    QCOMPARE(loadFinishedSpy3.size(), 0);
+
+    QWebEngineView view;
+    view.setPage(&page3);
+    view.show();
+    QTRY_COMPARE(loadFinishedSpy3.size(), 1);
+    QVERIFY(loadFinishedSpy3.at(0).at(0).toBool());
+    QCOMPARE(page3.history()->currentItemIndex(), hist->currentItemIndex());
+    QCOMPARE(page3.url(), page->url());
+    QCOMPARE(page3.history()->count(), histsize);
+}
+
+void tst_QWebEngineHistory::restoreInBackground()
+{
+    QByteArray buffer;
+    saveHistory(hist, &buffer);
+
+    QWebEngineProfile profile;
+    profile.setHistoryRestorePolicy(QWebEngineProfile::HistoryRestorePolicy::Background);
+    std::vector<std::unique_ptr<QWebEnginePage>> pages;
+    int loaded = 0;
+    int loading = 0;
+    int peak = 0;
+    for (int i = 0; i < 10; ++i) {
+        pages.push_back(std::make_unique<QWebEnginePage>(&profile));
+        connect(pages.back().get(), &QWebEnginePage::loadStarted, [&loading, &peak]() {
+            peak = qMax(peak, ++loading);
+        });
+        connect(pages.back().get(), &QWebEnginePage::loadFinished, [&loaded, &loading](bool ok) {
+            --loading;
+            if (ok)
+                ++loaded;
+        });
+        restoreHistory(pages.back()->history(), &buffer);
+        QCOMPARE(pages.back()->history()->count(), histsize);
+    }
+    QCOMPARE(loaded, 0);
+
+    // All pages get restored without being shown.
+    QTRY_COMPARE_WITH_TIMEOUT(loaded, 10, 30000);
+    // At most four of them were loading at the same time.
+    QVERIFY(peak > 0);
+    QVERIFY(peak <= 4);
+    for (const auto &restoredPage : pages) {
+        QCOMPARE(restoredPage->url(), page->url());
+        QCOMPARE(restoredPage->history()->count(), histsize);
+    }
+}
+
 void tst_QWebEngineHistory::popPushState_data()
 {
     QTest::addColumn<QString>("script");
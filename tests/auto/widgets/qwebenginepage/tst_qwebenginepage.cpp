@@ -23,11 +23,18 @@
 #include <QtNetwork/private/qtnetworkglobal_p.h>
 #include <QtWebEngineCore/qtwebenginecore-config.h>
 #include <QtWebEngineCore/private/qtwebenginecoreglobal_p.h>
+#include <QBuffer>
 #include <QByteArray>
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborValue>
 #include <QClipboard>
 #include <QDir>
 #include <QGraphicsWidget>
 #include <QHBoxLayout>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QLineEdit>
 #include <QMainWindow>
 #include <QMenu>
@@ -54,6 +61,7 @@
 #include <qwebenginedesktopmediarequest.h>
 #include <qwebenginefilesystemaccessrequest.h>
 #include <qwebenginefindtextresult.h>
+#include <qwebengineframecapturer.h>
 #include <qwebenginefullscreenrequest.h>
 #include <qwebenginehistory.h>
 #include <qwebenginenavigationrequest.h>
@@ -125,6 +133,9 @@ private Q_SLOTS:
     void geolocationRequestJS();
 #endif
     void loadFinished();
+    void pageLoadMetrics();
+    void capture();
+    void frameCapturer();
     void actionStates();
     void pasteImage();
     void popupFormSubmission();
@@ -170,6 +181,7 @@ private Q_SLOTS:
 
     void runJavaScript();
     void runJavaScriptDisabled();
+    void runJavaScriptResultFormats();
     void runJavaScriptFromSlot();
     void fullScreenRequested();
     void requestQuota_data();
@@ -183,6 +195,7 @@ private Q_SLOTS:
     void asyncAndDelete();
     void earlyToHtml();
     void setHtml();
+    void toHtmlStreaming();
     void setHtmlWithImageResource();
     void setHtmlWithStylesheetResource();
     void setHtmlWithBaseURL();
@@ -536,6 +549,138 @@ void tst_QWebEnginePage::loadFinished()
     QCOMPARE(spyLoadFinished.size(), 1);
 }
 
+void tst_QWebEnginePage::pageLoadMetrics()
+{
+    HttpServer server;
+    server.setResourceDirs({ ":/resources" });
+    QVERIFY(server.start());
+
+    QWebEnginePage page;
+    QSignalSpy spyLoadFinished(&page, &QWebEnginePage::loadFinished);
+    QSignalSpy spyMetrics(&page, &QWebEnginePage::pageLoadMetricsReported);
+
+    const QUrl url = server.url("/content.html");
+    page.load(url);
+    QTRY_COMPARE_WITH_TIMEOUT(spyLoadFinished.size(), 1, 20000);
+    QTRY_COMPARE(spyMetrics.size(), 1);
+
+    auto metrics = spyMetrics.takeFirst().value(0).value<QWebEnginePageLoadMetrics>();
+    QCOMPARE(metrics.url(), url);
+    QVERIFY(!metrics.isFinal());
+    QVERIFY(metrics.timeToFirstByte() >= std::chrono::milliseconds(0));
+    QVERIFY(metrics.loadEventStart() >= metrics.timeToFirstByte());
+
+    // Navigating away finalizes the metrics of the previous page.
+    page.load(QUrl("about:blank"));
+    QTRY_VERIFY(!spyMetrics.isEmpty());
+    metrics = spyMetrics.takeFirst().value(0).value<QWebEnginePageLoadMetrics>();
+    QCOMPARE(metrics.url(), url);
+    QVERIFY(metrics.isFinal());
+    QVERIFY(metrics.cumulativeLayoutShift() >= 0);
+    QVERIFY(server.stop());
+}
+
+void tst_QWebEnginePage::capture()
+{
+    // Captures from a page that is not shown in any view.
+    QWebEnginePage page;
+    QSignalSpy spyLoadFinished(&page, &QWebEnginePage::loadFinished);
+    page.setHtml(QStringLiteral("<html><body style='margin:0; background:#ff0000'>"
+                                "<div style='height:3000px'></div></body></html>"));
+    QTRY_COMPARE(spyLoadFinished.size(), 1);
+
+    std::optional<QImage> image;
+    page.capture(QRect(0, 0, 100, 50), 1.0, [&image](const QImage &result) { image = result; });
+    QTRY_VERIFY_WITH_TIMEOUT(image.has_value(), 10000);
+    QCOMPARE(image->size(), QSize(100, 50));
+    QCOMPARE(image->pixelColor(50, 25), QColor(Qt::red));
+
+    image.reset();
+    page.captureFullPage(200, 0.5, [&image](const QImage &result) { image = result; });
+    QTRY_VERIFY_WITH_TIMEOUT(image.has_value(), 10000);
+    QCOMPARE(image->width(), 100);
+    QCOMPARE(image->height(), 1500);
+    QCOMPARE(image->pixelColor(50, 1400), QColor(Qt::red));
+
+    // Invalid captures fail asynchronously as well.
+    image.reset();
+    page.capture(QRect(0, 0, 100, 50), 0, [&image](const QImage &result) { image = result; });
+    QVERIFY(!image.has_value());
+    QTRY_VERIFY(image.has_value());
+    QVERIFY(image->isNull());
+
+    // Concurrent captures of different sizes run one after the other.
+    std::optional<QImage> beyondViewport;
+    std::optional<QImage> fullPage;
+    QList<int> order;
+    page.capture(QRect(0, 2800, 100, 100), 1.0, [&](const QImage &result) {
+        beyondViewport = result;
+        order.append(1);
+    });
+    page.captureFullPage(300, 0.25, [&](const QImage &result) {
+        fullPage = result;
+        order.append(2);
+    });
+    QTRY_VERIFY_WITH_TIMEOUT(fullPage.has_value(), 20000);
+    QCOMPARE(order, QList<int>({ 1, 2 }));
+    QCOMPARE(beyondViewport->size(), QSize(100, 100));
+    QCOMPARE(beyondViewport->pixelColor(50, 50), QColor(Qt::red));
+    QCOMPARE(fullPage->size(), QSize(75, 750));
+
+    // The full page height is measured after the page was laid out at the capture width.
+    QSignalSpy spyLoadFinished2(&page, &QWebEnginePage::loadFinished);
+    page.setHtml(QStringLiteral("<html><body style='margin:0; background:#ff0000'>"
+                                "<div style='width:100%; aspect-ratio:1'></div></body></html>"));
+    QTRY_COMPARE(spyLoadFinished2.size(), 1);
+    image.reset();
+    page.captureFullPage(400, 1.0, [&image](const QImage &result) { image = result; });
+    QTRY_VERIFY_WITH_TIMEOUT(image.has_value(), 10000);
+    QCOMPARE(image->size(), QSize(400, 400));
+}
+
+void tst_QWebEnginePage::frameCapturer()
+{
+    QWebEnginePage page;
+    QSignalSpy spyLoadFinished(&page, &QWebEnginePage::loadFinished);
+    page.setHtml(QStringLiteral("<html><body style='background:#00ff00'></body></html>"));
+    QTRY_COMPARE(spyLoadFinished.size(), 1);
+
+    QWebEngineFrameCapturer capturer(&page);
+    QSignalSpy spyActive(&capturer, &QWebEngineFrameCapturer::activeChanged);
+    QSignalSpy spyFrames(&capturer, &QWebEngineFrameCapturer::frameCaptured);
+    capturer.setPixelFormat(QWebEngineCapturedFrame::PixelFormat::BGRA);
+    capturer.setFrameSize(QSize(200, 100));
+    capturer.start();
+    QVERIFY(capturer.isActive());
+    QCOMPARE(spyActive.size(), 1);
+
+    QTRY_VERIFY_WITH_TIMEOUT(!spyFrames.isEmpty(), 10000);
+    QVERIFY(QWebEngineCapturedFrame().isNull());
+    auto frame = spyFrames.takeFirst().value(0).value<QWebEngineCapturedFrame>();
+    QVERIFY(!frame.isNull());
+    QCOMPARE(frame.pixelFormat(), QWebEngineCapturedFrame::PixelFormat::BGRA);
+    QCOMPARE(frame.size(), QSize(200, 100));
+    QCOMPARE(frame.planeCount(), 1);
+    QVERIFY(frame.constBits(0));
+    const QImage image = frame.toImage();
+    QCOMPARE(image.size(), frame.contentRect().size());
+    QCOMPARE(image.pixelColor(image.width() / 2, image.height() / 2), QColor(Qt::green));
+
+    capturer.setPixelFormat(QWebEngineCapturedFrame::PixelFormat::I420);
+    capturer.start();
+    spyFrames.clear();
+    evaluateJavaScriptSync(&page, "document.body.style.background = 'blue'");
+    QTRY_VERIFY_WITH_TIMEOUT(!spyFrames.isEmpty(), 10000);
+    frame = spyFrames.takeLast().value(0).value<QWebEngineCapturedFrame>();
+    QCOMPARE(frame.pixelFormat(), QWebEngineCapturedFrame::PixelFormat::I420);
+    QCOMPARE(frame.planeCount(), 3);
+    QVERIFY(frame.toImage().isNull());
+
+    capturer.stop();
+    QVERIFY(!capturer.isActive());
+    QCOMPARE(spyActive.size(), 2);
+}
+
 void tst_QWebEnginePage::actionStates()
 {
     m_page->load(QUrl("qrc:///resources/script.html"));
@@ -2038,6 +2183,45 @@ void tst_QWebEnginePage::runJavaScript()
     QCOMPARE(evaluateJavaScriptSync(&page, "new Promise(function(){})"), QVariant(QVariantMap{}));
 }
 
+void tst_QWebEnginePage::runJavaScriptResultFormats()
+{
+    TestPage page;
+    const QString script = QStringLiteral("[{\"a\": 1, \"b\": \"\u00e9\"}, null, true, 2.5]");
+
+    CallbackSpy<QByteArray> jsonSpy;
+    page.runJavaScriptToJson(script, QWebEngineScript::MainWorld, jsonSpy.ref());
+    const QJsonDocument json = QJsonDocument::fromJson(jsonSpy.waitForResult());
+    QVERIFY(json.isArray());
+    QCOMPARE(json.array().size(), 4);
+    QCOMPARE(json.array().at(0).toObject().value("b").toString(), QStringLiteral("\u00e9"));
+
+    CallbackSpy<QCborValue> cborSpy;
+    page.runJavaScriptToCbor(script, QWebEngineScript::MainWorld, cborSpy.ref());
+    const QCborValue cbor = cborSpy.waitForResult();
+    QVERIFY(cbor.isArray());
+    QCOMPARE(cbor.toArray().at(0).toMap().value(QStringLiteral("a")).toInteger(), 1);
+    QCOMPARE(cbor.toArray().at(0).toMap().value(QStringLiteral("b")).toString(),
+             QStringLiteral("\u00e9"));
+    QVERIFY(cbor.toArray().at(1).isNull());
+    QCOMPARE(cbor.toArray().at(2).toBool(), true);
+    QCOMPARE(cbor.toArray().at(3).toDouble(), 2.5);
+
+    CallbackSpy<QByteArray> binarySpy;
+    page.runJavaScriptToBinary(QStringLiteral("new Uint8Array([1, 2, 3])"),
+                               QWebEngineScript::MainWorld, binarySpy.ref());
+    QCOMPARE(binarySpy.waitForResult(), QByteArray("\x01\x02\x03"));
+
+    CallbackSpy<QByteArray> stringSpy;
+    page.runJavaScriptToBinary(QStringLiteral("'\u00e9'"), QWebEngineScript::MainWorld,
+                               stringSpy.ref());
+    QCOMPARE(stringSpy.waitForResult(), QStringLiteral("\u00e9").toUtf8());
+
+    CallbackSpy<QByteArray> undefinedSpy;
+    page.runJavaScriptToBinary(QStringLiteral("42"), QWebEngineScript::MainWorld,
+                               undefinedSpy.ref());
+    QVERIFY(undefinedSpy.waitForResult().isNull());
+}
+
 void tst_QWebEnginePage::runJavaScriptDisabled()
 {
     QWebEnginePage page;
@@ -2305,6 +2489,46 @@ void tst_QWebEnginePage::setHtml()
     QCOMPARE(toHtmlSync(m_view->page()), html);
 }
 
+void tst_QWebEnginePage::toHtmlStreaming()
+{
+    // Large enough to be split into several chunks.
+    const QString text = QString(QStringLiteral("\u00e9t\u00e9 ")).repeated(100000);
+    QWebEnginePage page;
+    QSignalSpy spy(&page, &QWebEnginePage::loadFinished);
+    page.setHtml(QStringLiteral("<html><body>") + text + QStringLiteral("</body></html>"));
+    QTRY_COMPARE_WITH_TIMEOUT(spy.size(), 1, 20000);
+
+    QBuffer htmlBuffer;
+    QVERIFY(htmlBuffer.open(QIODevice::WriteOnly));
+    CallbackSpy<bool> htmlSpy;
+    page.toHtml(&htmlBuffer, htmlSpy.ref());
+    QVERIFY(htmlSpy.waitForResult());
+    QCOMPARE(QString::fromUtf8(htmlBuffer.data()), toHtmlSync(&page));
+
+    QByteArray plainText;
+    int chunks = 0;
+    bool finished = false;
+    page.toPlainTextUtf8([&](QByteArrayView chunk, bool last) {
+        QVERIFY(!finished);
+        plainText.append(chunk);
+        finished = last;
+        ++chunks;
+    });
+    QTRY_VERIFY(finished);
+    QVERIFY(chunks > 1);
+    QCOMPARE(QString::fromUtf8(plainText), toPlainTextSync(&page));
+
+    // Pending requests are finished with a null chunk when the page goes away.
+    QScopedPointer<QWebEnginePage> page2(new QWebEnginePage);
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    CallbackSpy<bool> deletedSpy;
+    page2->toHtml(&buffer, deletedSpy.ref());
+    page2.reset();
+    QVERIFY(deletedSpy.wasCalled());
+    QCOMPARE(deletedSpy.waitForResult(), false);
+}
+
 void tst_QWebEnginePage::setHtmlWithImageResource()
 {
     // We allow access to qrc resources from any security origin, including local and anonymous
@@ -14,6 +14,8 @@
 #include <QtWebEngineCore/qwebengineprofile.h>
 #include <QtWebEngineCore/qwebenginepage.h>
 #include <QtWebEngineCore/qwebenginedownloadrequest.h>
+#include <QtWebEngineCore/qwebengineprocessusage.h>
+#include <QtWebEngineCore/qwebenginetracing.h>
 #include <QtWebEngineWidgets/qwebengineview.h>
 
 #if QT_CONFIG(webengine_webchannel)
@@ -25,6 +27,7 @@
 
 #include <map>
 #include <mutex>
+#include <optional>
 
 class tst_QWebEngineProfile : public QObject
 {
@@ -61,6 +64,13 @@ private Q_SLOTS:
     void queryPermission_data();
     void queryPermission();
     void listPermissions();
+    void pageLifecycleManagement();
+    void resourceUsage();
+    void memoryPressure();
+    void spareRenderProcess();
+    void preloadingHints();
+    void tracing();
+    void profileReady();
     void qtbug_71895(); // this should be the last test
 };
 
@@ -1155,6 +1165,189 @@ void tst_QWebEngineProfile::queryPermission()
     QVERIFY(permission.state() == (valid ? QWebEnginePermission::State::Ask : QWebEnginePermission::State::Invalid));
 }
 
+void tst_QWebEngineProfile::pageLifecycleManagement()
+{
+    QWebEngineProfile profile;
+    QVERIFY(!profile.isPageLifecycleManagementEnabled());
+    QCOMPARE(profile.maximumActivePages(), 0);
+    QCOMPARE(profile.pageMemoryBudget(), 0);
+    QCOMPARE(profile.pageFreezeTimeout(), std::chrono::milliseconds(0));
+    QCOMPARE(profile.pageDiscardTimeout(), std::chrono::milliseconds(0));
+
+    QWebEnginePage olderPage(&profile);
+    QWebEnginePage newerPage(&profile);
+    QSignalSpy olderLoadSpy(&olderPage, &QWebEnginePage::loadFinished);
+    QSignalSpy newerLoadSpy(&newerPage, &QWebEnginePage::loadFinished);
+    olderPage.setHtml(QStringLiteral("<html><body>older</body></html>"));
+    QTRY_COMPARE(olderLoadSpy.size(), 1);
+    newerPage.setHtml(QStringLiteral("<html><body>newer</body></html>"));
+    QTRY_COMPARE(newerLoadSpy.size(), 1);
+
+    QSignalSpy statisticsSpy(&profile, &QWebEngineProfile::pageLifecycleStatisticsChanged);
+
+    // Nothing happens until management is enabled
+    profile.setMaximumActivePages(1);
+    QTest::qWait(100);
+    QCOMPARE(olderPage.lifecycleState(), QWebEnginePage::LifecycleState::Active);
+    QCOMPARE(statisticsSpy.size(), 0);
+
+    // The least recently used page is frozen first
+    profile.setPageLifecycleManagementEnabled(true);
+    QTRY_COMPARE(olderPage.lifecycleState(), QWebEnginePage::LifecycleState::Frozen);
+    QCOMPARE(newerPage.lifecycleState(), QWebEnginePage::LifecycleState::Active);
+    QTRY_COMPARE(statisticsSpy.size(), 1);
+    QCOMPARE(statisticsSpy.last().at(0).toInt(), 1);
+    QCOMPARE(statisticsSpy.last().at(1).toInt(), 0);
+
+    // Idle pages are discarded
+    profile.setPageDiscardTimeout(std::chrono::milliseconds(1));
+    QTRY_COMPARE(olderPage.lifecycleState(), QWebEnginePage::LifecycleState::Discarded);
+    QTRY_COMPARE(newerPage.lifecycleState(), QWebEnginePage::LifecycleState::Discarded);
+    QTRY_COMPARE(statisticsSpy.last().at(1).toInt(), 2);
+
+    profile.setPageLifecycleManagementEnabled(false);
+    QVERIFY(!profile.isPageLifecycleManagementEnabled());
+    QCOMPARE(profile.maximumActivePages(), 1);
+}
+
+void tst_QWebEngineProfile::resourceUsage()
+{
+    QWebEngineProfile profile;
+    QWebEnginePage page(&profile);
+    QSignalSpy loadSpy(&page, &QWebEnginePage::loadFinished);
+    page.setHtml(QStringLiteral("<html><body><iframe srcdoc='child'></iframe></body></html>"));
+    QTRY_COMPARE(loadSpy.size(), 1);
+    QVERIFY(loadSpy.takeFirst().value(0).toBool());
+
+    QList<QWebEngineProcessUsage> usages;
+    bool called = false;
+    profile.requestResourceUsage([&](const QList<QWebEngineProcessUsage> &result) {
+        usages = result;
+        called = true;
+    });
+    QTRY_VERIFY(called);
+    QCOMPARE(usages.size(), 1);
+
+    const QWebEngineProcessUsage &usage = usages.first();
+    QCOMPARE(usage.processId(), page.renderProcessPid());
+    QCOMPARE(usage.frames().size(), 2);
+    QVERIFY(usage.frames().contains(page.mainFrame()));
+    QVERIFY(usage.cpuTime() >= std::chrono::microseconds(0));
+    QVERIFY(usage.networkBytesReceived() >= 0);
+}
+
+void tst_QWebEngineProfile::memoryPressure()
+{
+    QWebEngineProfile profile;
+    QWebEnginePage page(&profile);
+    QSignalSpy loadSpy(&page, &QWebEnginePage::loadFinished);
+    page.setHtml(QStringLiteral("<html><body>pressure</body></html>"));
+    QTRY_COMPARE(loadSpy.size(), 1);
+
+    // Critical pressure makes the renderer collect garbage, which clears weak references
+    // to objects that are no longer reachable.
+    const QString dropObject =
+            QStringLiteral("window.ref = new WeakRef({ data: new Array(1000).fill(1) }); true");
+    const QString collected = QStringLiteral("window.ref.deref() === undefined");
+
+    QVERIFY(evaluateJavaScriptSync(&page, dropObject).toBool());
+    profile.notifyMemoryPressure(QWebEngineGlobalSettings::MemoryPressureLevel::Critical);
+    QTRY_VERIFY(evaluateJavaScriptSync(&page, collected).toBool());
+
+    QVERIFY(evaluateJavaScriptSync(&page, dropObject).toBool());
+    QWebEngineGlobalSettings::notifyMemoryPressure(QWebEngineGlobalSettings::MemoryPressureLevel::Critical);
+    QTRY_VERIFY(evaluateJavaScriptSync(&page, collected).toBool());
+
+    QWebEngineGlobalSettings::notifyMemoryPressure(QWebEngineGlobalSettings::MemoryPressureLevel::Moderate);
+    QCOMPARE(evaluateJavaScriptSync(&page, "document.body.innerText").toString(), QStringLiteral("pressure"));
+
+    page.setHtml(QStringLiteral("<html><body>reloaded</body></html>"));
+    QTRY_COMPARE(loadSpy.size(), 2);
+    QVERIFY(loadSpy.last().value(0).toBool());
+
+    QVERIFY(QWebEngineGlobalSettings::setMemoryPressureMonitoringEnabled(false));
+}
+
+void tst_QWebEngineProfile::spareRenderProcess()
+{
+    QWebEngineProfile profile;
+    QVERIFY(!profile.isSpareRenderProcessEnabled());
+    profile.setSpareRenderProcessEnabled(true);
+    QVERIFY(profile.isSpareRenderProcessEnabled());
+
+    QWebEnginePage page(&profile);
+    QList<QWebEngineLoadingInfo> infos;
+    connect(&page, &QWebEnginePage::loadingChanged, [&](const QWebEngineLoadingInfo &info) {
+        if (info.status() == QWebEngineLoadingInfo::LoadSucceededStatus)
+            infos.append(info);
+    });
+    page.setHtml(QStringLiteral("<html><body>first</body></html>"));
+    QTRY_COMPARE(infos.size(), 1);
+    QVERIFY(infos.last().usedSpareRenderProcess());
+
+    profile.setSpareRenderProcessEnabled(false);
+    QWebEnginePage otherPage(&profile);
+    QSignalSpy loadSpy(&otherPage, &QWebEnginePage::loadingChanged);
+    otherPage.setHtml(QStringLiteral("<html><body>other</body></html>"));
+    QTRY_VERIFY(!loadSpy.isEmpty()
+                && loadSpy.last().value(0).value<QWebEngineLoadingInfo>().status()
+                        == QWebEngineLoadingInfo::LoadSucceededStatus);
+    QVERIFY(!loadSpy.last().value(0).value<QWebEngineLoadingInfo>().usedSpareRenderProcess());
+}
+
+void tst_QWebEngineProfile::preloadingHints()
+{
+    TestServer server;
+    QVERIFY(server.start());
+
+    int imageRequests = 0;
+    int prerenderRequests = 0;
+    connect(&server, &HttpServer::newRequest, [&](HttpReqRep *rr) {
+        if (rr->requestPath() == "/hedgehog.png")
+            ++imageRequests;
+        else if (rr->requestPath() == "/notification.html")
+            ++prerenderRequests;
+    });
+
+    QWebEngineProfile profile;
+    std::optional<bool> preresolved, prefetched, invalid;
+    profile.preresolve(server.url("/"), [&](bool used) { preresolved = used; });
+    profile.prefetch(server.url("/hedgehog.png"), [&](bool used) { prefetched = used; });
+    profile.preconnect(QUrl("file:///"), [&](bool used) { invalid = used; });
+    QTRY_COMPARE(imageRequests, 1);
+    QVERIFY(invalid.has_value());
+    QVERIFY(!*invalid);
+    QVERIFY(!prefetched.has_value());
+
+    QWebEnginePage page(&profile);
+    QVERIFY(loadSync(&page, server.url("/hedgehog.html")));
+    QTRY_VERIFY(prefetched.has_value());
+    QVERIFY(*prefetched);
+    QTRY_VERIFY(preresolved.has_value());
+    QVERIFY(*preresolved);
+    // The image was served from the cache.
+    QCOMPARE(imageRequests, 1);
+
+    std::optional<bool> prerendered;
+    page.prerender(QUrl("about:blank"), [&](bool used) { prerendered = used; });
+    QTRY_VERIFY(prerendered.has_value());
+    QVERIFY(!*prerendered);
+
+    // A prerendered page is activated by the load without fetching it again.
+    prerendered.reset();
+    const QUrl prerenderUrl = server.url("/notification.html");
+    page.prerender(prerenderUrl, [&](bool used) { prerendered = used; });
+    QTRY_COMPARE(prerenderRequests, 1);
+    QVERIFY(!prerendered.has_value());
+    QVERIFY(loadSync(&page, prerenderUrl));
+    QTRY_VERIFY(prerendered.has_value());
+    QVERIFY(*prerendered);
+    QCOMPARE(page.url(), prerenderUrl);
+    QCOMPARE(prerenderRequests, 1);
+
+    QVERIFY(server.stop());
+}
+
 void tst_QWebEngineProfile::listPermissions()
 {
     QWebEngineProfile profile;
@@ -1206,6 +1399,88 @@ void tst_QWebEngineProfile::listPermissions()
     QVERIFY(findInList(permissionsListAll, QUrl(QStringLiteral("http://www.google.com")), commonType, QWebEnginePermission::State::Granted));
 }
 
+void tst_QWebEngineProfile::tracing()
+{
+    QWebEnginePage page;
+    QSignalSpy loadSpy(&page, &QWebEnginePage::loadFinished);
+    page.setHtml(QStringLiteral("<html><body>before</body></html>"));
+    QTRY_COMPARE(loadSpy.size(), 1);
+
+    QBuffer buffer;
+    QVERIFY(!QWebEngineTracing::isActive());
+    QVERIFY(!QWebEngineTracing::stop(&buffer));
+
+    QVERIFY(QWebEngineTracing::start({ { QStringLiteral("blink"), QStringLiteral("toplevel") },
+                                       1024 * 1024 }));
+    QVERIFY(QWebEngineTracing::isActive());
+    QVERIFY(!QWebEngineTracing::start());
+
+    page.setHtml(QStringLiteral("<html><body>traced</body></html>"));
+    QTRY_COMPARE(loadSpy.size(), 2);
+
+    // The device has to be open for writing.
+    QVERIFY(!QWebEngineTracing::stop(&buffer));
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    std::optional<bool> result;
+    QVERIFY(QWebEngineTracing::stop(&buffer, [&result](bool success) { result = success; }));
+    QTRY_VERIFY_WITH_TIMEOUT(result.has_value(), 20000);
+    QVERIFY(*result);
+    QVERIFY(!QWebEngineTracing::isActive());
+
+    const QJsonDocument trace = QJsonDocument::fromJson(buffer.data());
+    QVERIFY(trace.isObject());
+    QVERIFY(!trace.object().value(QStringLiteral("traceEvents")).toArray().isEmpty());
+}
+
+void tst_QWebEngineProfile::profileReady()
+{
+    TestServer server;
+    QVERIFY(server.start());
+
+    QWebEngineProfile offTheRecordProfile;
+    QVERIFY(offTheRecordProfile.isReady());
+
+    AutoDir dataDir1(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+                     + QStringLiteral("/QtWebEngine/profileReady1"));
+    AutoDir dataDir2(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+                     + QStringLiteral("/QtWebEngine/profileReady2"));
+
+    QWebEngineProfile profile(QStringLiteral("profileReady1"));
+    QSignalSpy readySpy(&profile, &QWebEngineProfile::ready);
+    // The stores are read on a background sequence, which needs the event loop
+    QVERIFY(!profile.isReady());
+
+    // Permissions changed in the meantime survive reading the store
+    const QUrl origin(QStringLiteral("https://www.example.com"));
+    profile.queryPermission(origin, QWebEnginePermission::PermissionType::Notifications).grant();
+
+    // Navigations issued in the meantime are queued
+    QWebEnginePage page(&profile);
+    QSignalSpy loadSpy(&page, &QWebEnginePage::loadFinished);
+    page.load(server.url("/hedgehog.html"));
+
+    qsizetype loadsWhenReady = -1;
+    QWebEnginePermission::State permissionWhenReady = QWebEnginePermission::State::Invalid;
+    connect(&profile, &QWebEngineProfile::ready, this, [&] {
+        loadsWhenReady = loadSpy.size();
+        permissionWhenReady =
+                profile.queryPermission(origin, QWebEnginePermission::PermissionType::Notifications).state();
+    });
+    QTRY_COMPARE(readySpy.size(), 1);
+    QVERIFY(profile.isReady());
+    QCOMPARE(loadsWhenReady, 0);
+    QCOMPARE(permissionWhenReady, QWebEnginePermission::State::Granted);
+    QTRY_COMPARE(loadSpy.size(), 1);
+    QVERIFY(loadSpy.takeFirst().value(0).toBool());
+
+    profile.setPersistentStoragePath(dataDir2.path());
+    QVERIFY(!profile.isReady());
+    QTRY_COMPARE(readySpy.size(), 2);
+    QVERIFY(loadSync(&page, server.url("/hedgehog.html")));
+
+    (void)server.stop();
+}
+
 void tst_QWebEngineProfile::qtbug_71895()
 {
     QWebEngineView view;
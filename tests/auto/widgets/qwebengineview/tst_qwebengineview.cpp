@@ -157,6 +157,7 @@ private Q_SLOTS:
     void imeJSInputEvents();
 
     void mouseLeave();
+    void coalescedMouseMoves();
 
 #if QT_CONFIG(clipboard)
     void globalMouseSelection();
@@ -3329,6 +3330,47 @@ void tst_QWebEngineView::mouseLeave()
     QTRY_COMPARE(innerText(), QStringLiteral("Mouse OUT"));
 }
 
+void tst_QWebEngineView::coalescedMouseMoves()
+{
+    QWebEngineView view;
+    view.resize(300, 300);
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QSignalSpy loadFinishedSpy(&view, SIGNAL(loadFinished(bool)));
+    view.setHtml("<html><head><script>"
+                 "var moves = 0, movementX = 0, events = [];"
+                 "document.onmousemove = function(e) {"
+                 " moves++;"
+                 " for (const c of e.getCoalescedEvents()) movementX += c.movementX;"
+                 " events.push('move');"
+                 "};"
+                 "document.onmousedown = function(e) { events.push('down') };"
+                 "</script></head>"
+                 "<body style='margin: 0px; width: 100%; height: 100%'></body></html>");
+    QVERIFY(loadFinishedSpy.wait());
+
+    QTest::mouseMove(view.windowHandle(), QPoint(10, 50));
+    QTRY_VERIFY(evaluateJavaScriptSync(view.page(), "moves").toInt() > 0);
+    evaluateJavaScriptSync(view.page(), "moves = 0; movementX = 0; events = []");
+
+    // The renderer dispatches a burst of moves as fewer mousemove events, each sample must
+    // still reach the page through getCoalescedEvents().
+    const int steps = 20;
+    for (int i = 1; i <= steps; ++i)
+        QTest::mouseMove(view.windowHandle(), QPoint(10 + i, 50));
+    QTest::mousePress(view.windowHandle(), Qt::LeftButton, {}, QPoint(10 + steps, 50));
+    QTRY_VERIFY(evaluateJavaScriptSync(view.page(), "events.includes('down')").toBool());
+    QTest::mouseRelease(view.windowHandle(), Qt::LeftButton, {}, QPoint(10 + steps, 50));
+
+    const int moves = evaluateJavaScriptSync(view.page(), "moves").toInt();
+    QVERIFY(moves >= 1);
+    QVERIFY2(moves < steps, QByteArray::number(moves));
+    QCOMPARE(evaluateJavaScriptSync(view.page(), "movementX").toInt(), steps);
+    // No move may overtake or trail the press.
+    QCOMPARE(evaluateJavaScriptSync(view.page(), "events.indexOf('down')").toInt(), moves);
+}
+
 void tst_QWebEngineView::webUIURLs_data()
 {
     QTest::addColumn<QUrl>("url");
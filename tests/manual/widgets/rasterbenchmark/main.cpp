@@ -0,0 +1,189 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QApplication>
+#include <QBuffer>
+#include <QCommandLineParser>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <QTimer>
+#include <QWebEngineGlobalSettings>
+#include <QWebEnginePage>
+#include <QWebEngineTracing>
+#include <QWebEngineView>
+
+#include <cstdio>
+
+// Runs the bundled pages in a view that is never shown on screen, and reports the
+// frames per second reached together with the time spent rasterizing tiles, as
+// recorded by a trace of the "cc" category.
+//
+// Run it with -platform offscreen and --disable-gpu on machines without a GPU.
+
+struct Result
+{
+    double fps = 0;
+    double rasterMs = 0;
+    int rasterThreads = 0;
+};
+
+// Returns false if the loop was left because of the timeout.
+static bool waitFor(QEventLoop &loop, int timeoutMs)
+{
+    QTimer timer;
+    timer.setSingleShot(true);
+    QObject::connect(&timer, &QTimer::timeout, &loop, &QEventLoop::quit);
+    timer.start(timeoutMs);
+    loop.exec();
+    return timer.isActive();
+}
+
+static void collectRasterTime(const QByteArray &trace, const QString &eventName, Result *result)
+{
+    const QJsonObject root = QJsonDocument::fromJson(trace).object();
+    QSet<qint64> threads;
+    qint64 totalUs = 0;
+    for (const QJsonValue &value : root.value(QLatin1String("traceEvents")).toArray()) {
+        const QJsonObject event = value.toObject();
+        if (event.value(QLatin1String("ph")).toString() != QLatin1String("X")
+            || event.value(QLatin1String("name")).toString() != eventName)
+            continue;
+        totalUs += event.value(QLatin1String("dur")).toInteger();
+        threads.insert(event.value(QLatin1String("tid")).toInteger());
+    }
+    result->rasterMs = totalUs / 1000.0;
+    result->rasterThreads = threads.size();
+}
+
+static bool runPage(QWebEngineView &view, const QUrl &url, int durationMs,
+                    const QString &rasterEvent, Result *result)
+{
+    QEventLoop loop;
+    bool ok = false;
+    auto loadConnection = QObject::connect(&view, &QWebEngineView::loadFinished, [&](bool success) {
+        ok = success;
+        loop.quit();
+    });
+    view.load(url);
+    const bool loaded = waitFor(loop, 30000) && ok;
+    QObject::disconnect(loadConnection);
+    if (!loaded)
+        return false;
+
+    QWebEngineTracing::Config config;
+    config.categories = { QStringLiteral("cc") };
+    if (!QWebEngineTracing::start(config))
+        return false;
+
+    auto titleConnection = QObject::connect(&view, &QWebEngineView::titleChanged, [&](const QString &title) {
+        if (title == QLatin1String("benchmark-done"))
+            loop.quit();
+    });
+    view.page()->runJavaScript(QStringLiteral("startBenchmark(%1)").arg(durationMs));
+    const bool finished = waitFor(loop, durationMs + 30000);
+    QObject::disconnect(titleConnection);
+
+    QJsonObject benchmark;
+    if (finished) {
+        view.page()->runJavaScript(QStringLiteral("JSON.stringify(window.benchmarkResult)"),
+                                   [&](const QVariant &value) {
+                                       benchmark = QJsonDocument::fromJson(value.toByteArray()).object();
+                                       loop.quit();
+                                   });
+        waitFor(loop, 10000);
+    }
+
+    QBuffer trace;
+    trace.open(QIODevice::WriteOnly);
+    bool traced = false;
+    QWebEngineTracing::stop(&trace, [&](bool success) {
+        traced = success;
+        loop.quit();
+    });
+    waitFor(loop, 60000);
+
+    if (!finished || benchmark.isEmpty())
+        return false;
+    const double elapsedMs = benchmark.value(QLatin1String("elapsed")).toDouble();
+    result->fps = elapsedMs > 0 ? benchmark.value(QLatin1String("frames")).toDouble() * 1000 / elapsedMs : 0;
+    if (traced)
+        collectRasterTime(trace.data(), rasterEvent, result);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    QCoreApplication::setOrganizationName("QtExamples");
+    QCoreApplication::setApplicationName("rasterbenchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QCoreApplication::translate(
+            "main", "Measures frame rate and raster time of a set of pages rendered offscreen."));
+    parser.addHelpOption();
+    QCommandLineOption threadsOption("threads", "Number of raster threads, 0 for the default.",
+                                     "count", "0");
+    QCommandLineOption tileOption("tile", "Tile size, for example 512x512.", "size");
+    QCommandLineOption modeOption("mode", "Raster mode: default, zero-copy or one-copy.", "mode",
+                                  "default");
+    QCommandLineOption sizeOption("size", "Size of the view.", "size", "3840x2160");
+    QCommandLineOption durationOption("duration", "Duration of each page in seconds.", "seconds",
+                                      "10");
+    QCommandLineOption rasterEventOption("raster-event",
+                                         "Name of the trace event that measures a raster task.",
+                                         "name", "RasterTask");
+    parser.addOptions({ threadsOption, tileOption, modeOption, sizeOption, durationOption,
+                        rasterEventOption });
+    parser.addPositionalArgument("URL", "Pages to run instead of the bundled ones.", "[URL...]");
+    parser.process(app);
+
+    auto parseSize = [](const QString &text) {
+        const QStringList parts = text.split(QLatin1Char('x'));
+        return parts.size() == 2 ? QSize(parts.at(0).toInt(), parts.at(1).toInt()) : QSize();
+    };
+
+    QWebEngineGlobalSettings::RasterSettings rasterSettings;
+    rasterSettings.threadCount = parser.value(threadsOption).toInt();
+    if (parser.isSet(tileOption))
+        rasterSettings.tileSize = parseSize(parser.value(tileOption));
+    const QString mode = parser.value(modeOption);
+    if (mode == QLatin1String("zero-copy"))
+        rasterSettings.mode = QWebEngineGlobalSettings::RasterMode::ZeroCopy;
+    else if (mode == QLatin1String("one-copy"))
+        rasterSettings.mode = QWebEngineGlobalSettings::RasterMode::OneCopy;
+    if (!QWebEngineGlobalSettings::setRasterSettings(rasterSettings)) {
+        qWarning("Invalid raster settings.");
+        return 1;
+    }
+
+    QList<QUrl> urls;
+    for (const QString &argument : parser.positionalArguments())
+        urls.append(QUrl::fromUserInput(argument));
+    if (urls.isEmpty()) {
+        urls = { QUrl("qrc:/pages/dashboard.html"), QUrl("qrc:/pages/scrolling.html"),
+                 QUrl("qrc:/pages/effects.html") };
+    }
+
+    QWebEngineView view;
+    view.setAttribute(Qt::WA_DontShowOnScreen);
+    view.resize(parseSize(parser.value(sizeOption)));
+    view.show();
+
+    const int durationMs = parser.value(durationOption).toInt() * 1000;
+    std::printf("%-40s %8s %12s %8s\n", "page", "fps", "raster ms", "threads");
+    bool allPassed = true;
+    for (const QUrl &url : std::as_const(urls)) {
+        Result result;
+        if (!runPage(view, url, durationMs, parser.value(rasterEventOption), &result)) {
+            std::printf("%-40s failed\n", qPrintable(url.toString()));
+            allPassed = false;
+            continue;
+        }
+        std::printf("%-40s %8.1f %12.1f %8d\n", qPrintable(url.toString()), result.fps,
+                    result.rasterMs, result.rasterThreads);
+    }
+    return allPassed ? 0 : 1;
+}
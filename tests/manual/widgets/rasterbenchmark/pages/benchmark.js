@@ -0,0 +1,23 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+// Counts animation frames while the page's update function runs, then reports
+// through the title so the driver knows the run has finished.
+function runBenchmark(durationMs, update) {
+    let frames = 0;
+    let start = 0;
+    function tick(now) {
+        if (!start)
+            start = now;
+        const elapsed = now - start;
+        if (elapsed >= durationMs) {
+            window.benchmarkResult = { frames: frames, elapsed: elapsed };
+            document.title = "benchmark-done";
+            return;
+        }
+        update(frames, elapsed);
+        ++frames;
+        requestAnimationFrame(tick);
+    }
+    requestAnimationFrame(tick);
+}